@@ -23,18 +23,27 @@
  * on the Minimax algorithm, using alpha-beta pruning, or a blackboard
  * approach.
  *
+ * For games that key their positions, bounds on the scores of positions
+ * searched are kept in a transposition table for the life of the player.
+ * The key is shared by symmetric positions, so a position is scored once
+ * for all of its symmetries.
+ *
  */
 
 #ifndef AIPLAYER_H
 #define AIPLAYER_H
 
 #include <climits>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 #include "Blackboard.h"
 #include "Game.h"
+#include "GameArena.h"
 #include "Player.h"
+#include "Zobrist.h"
 
 class AIPlayer : public Player
 {
@@ -58,12 +67,50 @@ class AIPlayer : public Player
         std::string TypeName() const override { return "AIPlayer"; }
 
     private:
-        // Generate the best move using the minimax algorithm
-        GameMove MinimaxMove(int nPlayer, Game &cGame, int nDepth);
+        // Generate the best move using the minimax algorithm, searching with a vector of GameMoves or a MoveList
+        template <typename List> GameMove MinimaxMove(int nPlayer, Game &cGame, int nDepth);
         // Generate a move by the opponent player
-        int MinMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta);
+        template <typename List> int MinMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta, std::vector<List> &vMoveStack, GameArena &cArena);
         // Generate a move for the player
-        int MaxMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta);
+        template <typename List> int MaxMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta, std::vector<List> &vMoveStack, GameArena &cArena);
+
+        // Generate and apply moves of either type
+        static void GenerateMoves(Game &cGame, int nPlayer, std::vector<GameMove> &vGameMoves)    { vGameMoves = cGame.GenerateMoves(nPlayer); }
+        static void GenerateMoves(Game &cGame, int nPlayer, MoveList &cMoveList)                  { cGame.GenerateBoardMoves(nPlayer, cMoveList); }
+
+        // Check for the end of the game and, if not ended, generate moves of either type
+        static bool GameEndedWithMoves(Game &cGame, int nPlayer, std::vector<GameMove> &vGameMoves)
+            { if (cGame.GameEnded(nPlayer)) return true; vGameMoves = cGame.GenerateMoves(nPlayer); return false; }
+        static bool GameEndedWithMoves(Game &cGame, int nPlayer, MoveList &cMoveList)
+            { return cGame.GameEndedWithMoves(nPlayer, cMoveList); }
+        static bool ApplyMove(Game &cGame, int nPlayer, GameMove &cGameMove)                      { return cGame.ApplyMove(nPlayer, cGameMove); }
+        static bool ApplyMove(Game &cGame, int nPlayer, BoardMove &cBoardMove)                    { return cGame.ApplyTrustedBoardMove(nPlayer, cBoardMove); }
+
+        // Convert a move of either type to a GameMove
+        static GameMove ToGameMove(const GameMove &cGameMove)                                     { return cGameMove; }
+        static GameMove ToGameMove(const BoardMove &cBoardMove)                                   { return cBoardMove.ToGameMove(); }
+
+        // Bounds on the score of a position, with a player to move, searched to a depth
+        struct Transposition
+        {
+            uint64_t uiKey  {0};
+            int      nDepth {-1};
+            int      nLower {INT_MIN};
+            int      nUpper {INT_MAX};
+        };
+
+        // Return the key of a position with a player to move, if the game keeps one and the table is in use
+        bool TranspositionKey(const Game &cGame, int nPlayer, uint64_t &uiKey) const
+            { if (m_vstTranspositions.empty() || !cGame.CanonicalKey(uiKey)) return false; if (nPlayer == 2) uiKey ^= Zobrist::SideToMove(); return true; }
+        // Score a position from its bounds, if they decide its score within a window
+        bool ProbeTransposition(uint64_t uiKey, int nDepth, int nAlpha, int nBeta, int &nScore) const;
+        // Keep the bound on a position that a search within a window found
+        void StoreTransposition(uint64_t uiKey, int nDepth, int nAlpha, int nBeta, int nScore);
+
+        // Number of entries in the transposition table, a power of two
+        static const int m_knTranspositions {1 << 16};
+        // Transposition table, made when first searching a game that keys its positions
+        std::vector<Transposition> m_vstTranspositions {};
 
         // Blackboard
         Blackboard m_cBlackBoard;
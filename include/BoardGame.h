@@ -19,9 +19,15 @@
 
 /** \file
  *
- * \brief The BoardGame class represents a virtual game played on a
+ * \brief The BoardGame class template represents a virtual game played on a
  * two-dimensonal space, navigated with X and Y coordinates.
  *
+ * The template parameter is the type of the board: a GameBoard of pieces,
+ * or a StoneBoard of stones for a board larger than a GameBoard, so that
+ * each game copies and searches only the board it plays on.  The member
+ * functions are defined in BoardGame.cpp, which instantiates BoardGame for
+ * each board.
+ *
  */
 
 #ifndef BOARDGAME_H
@@ -32,6 +38,7 @@
 #include "Game.h"
 #include "GameBoard.h"
 
+template <class Board>
 class BoardGame : public Game
 {
     public:
@@ -63,6 +70,21 @@ class BoardGame : public Game
         // Generate a GameMove from text input
         virtual GameMove GenerateMove(std::string sMove) const override;
 
+        // Apply the move to the game, by way of ApplyBoardMove()
+        virtual bool ApplyMove(int nPlayer, GameMove &cGameMove) override;
+
+        // Generate a vector of valid moves, by way of GenerateBoardMoves()
+        virtual std::vector<GameMove> GenerateMoves(int nPlayer) override;
+
+        // Board games are searched with BoardMoves
+        virtual bool UsesBoardMoves() const override { return true; }
+
+        // Fill a list with the valid moves in compact form
+        virtual void GenerateBoardMoves(int nPlayer, MoveList &cMoveList) override = 0;
+
+        // Apply a move in compact form to the game
+        virtual bool ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove) override = 0;
+
         // Provide a preferred move
         virtual int  PreferredMove(const GameMove &cGameMove) const override;
 
@@ -83,6 +105,9 @@ class BoardGame : public Game
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const = 0;
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const = 0;
+        virtual size_t CloneSize() const = 0;
 
         // Set up the board
         void SetBoard() { cBoard.Clear(); };
@@ -97,7 +122,7 @@ class BoardGame : public Game
         const int  m_knY;
 
         // The game board, initialized in the constructor
-        GameBoard cBoard;
+        Board cBoard;
 };
 
 #endif // BOARDGAME_H
@@ -0,0 +1,152 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The BoardMove class represents a board game move packed into 32
+ * bits.
+ *
+ * Board games generate and apply BoardMoves when searching, where moves are
+ * created and copied by the thousand.  A BoardMove holds only what a board
+ * game needs: the From and To coordinates, a promotion, and the flags that
+ * say which coordinates are used.  It is converted to and from the richer
+ * GameMove where moves enter or leave a game: players, the network, and
+ * files.
+ *
+ * Each coordinate is held plus one in six bits, so coordinates from -1 (no
+ * coordinate) to 62 are kept.  Anything else becomes -1, which no board
+ * considers a valid location.
+ *
+ */
+
+#ifndef BOARDMOVE_H
+#define BOARDMOVE_H
+
+#include <cstdint>
+
+#include "GameMove.h"
+
+class BoardMove
+{
+    public:
+        // Construct a BoardMove with no coordinates
+        BoardMove() {}
+
+        // Construct using integer values and flags
+        BoardMove(int nFromX, int nFromY, int nToX, int nToY, bool bUseY, bool bUseFrom)
+        {
+            Set(nFromX, nFromY, nToX, nToY, bUseY, bUseFrom);
+        }
+
+        // Construct from a GameMove
+        explicit BoardMove(const GameMove &cGameMove)
+        {
+            Set(cGameMove.FromX(), cGameMove.FromY(), cGameMove.ToX(), cGameMove.ToY(), cGameMove.UseY(), cGameMove.UseFrom());
+            SetPromotion(cGameMove.Promotion());
+            SetTestMove(cGameMove.TestMove());
+        }
+
+        // Convert to a GameMove
+        GameMove ToGameMove() const
+        {
+            GameMove cGameMove(FromX(), FromY(), ToX(), ToY(), UseY(), UseFrom());
+            cGameMove.SetPromotion(Promotion());
+            cGameMove.SetTestMove(TestMove());
+            return cGameMove;
+        }
+
+        // Modify the coordinates of a move
+        void SetFromX(int nX)    { SetField(m_knFromXShift, nX); }
+        void SetFromY(int nY)    { SetField(m_knFromYShift, nY); }
+        void SetToX(int nX)      { SetField(m_knToXShift, nX); }
+        void SetToY(int nY)      { SetField(m_knToYShift, nY); }
+
+        // Modify several coordinates in one call
+        void Set(int nFromX, int nFromY, int nToX, int nToY, bool bUseY, bool bUseFrom)
+        {
+            SetFromX(nFromX);
+            SetFromY(nFromY);
+            SetToX(nToX);
+            SetToY(nToY);
+            SetUseY(bUseY);
+            SetUseFrom(bUseFrom);
+        }
+
+        // Return the coordinates of a move
+        int  FromX() const       { return Field(m_knFromXShift); }
+        int  FromY() const       { return Field(m_knFromYShift); }
+        int  ToX() const         { return Field(m_knToXShift); }
+        int  ToY() const         { return Field(m_knToYShift); }
+
+        // Set and return the promotion, a game-defined piece index where 0 means none
+        void SetPromotion(int n) { m_uiMove = (m_uiMove & ~(m_kuiPromotionMask << m_knPromotionShift)) | ((n & m_kuiPromotionMask) << m_knPromotionShift); }
+        int  Promotion() const   { return (m_uiMove >> m_knPromotionShift) & m_kuiPromotionMask; }
+
+        // Set and return whether the Y-coordinate is used
+        void SetUseY(bool b)     { SetFlag(m_kuiUseYFlag, b); }
+        bool UseY() const        { return (m_uiMove & m_kuiUseYFlag) != 0; }
+
+        // Set and return whether the From coordinates are used
+        void SetUseFrom(bool b)  { SetFlag(m_kuiUseFromFlag, b); }
+        bool UseFrom() const     { return (m_uiMove & m_kuiUseFromFlag) != 0; }
+
+        // Set and return whether this is a test move
+        void SetTestMove(bool b) { SetFlag(m_kuiTestMoveFlag, b); }
+        bool TestMove() const    { return (m_uiMove & m_kuiTestMoveFlag) != 0; }
+
+        // Compare two moves and whether their to-moves are the same
+        bool SameTo(const BoardMove &cBoardMove) const { return ((cBoardMove.m_uiMove ^ m_uiMove) & m_kuiToMask) == 0; }
+
+        // Compare two moves for the same coordinates and promotion
+        bool operator==(const BoardMove &cBoardMove) const { return ((cBoardMove.m_uiMove ^ m_uiMove) & m_kuiMoveMask) == 0; }
+        bool operator!=(const BoardMove &cBoardMove) const { return !(*this == cBoardMove); }
+
+    private:
+        // Layout of the move: four six-bit coordinates, a four-bit promotion, and the flags
+        static const int      m_knCoordinateBits  {6};
+        static const uint32_t m_kuiCoordinateMask {(1u << m_knCoordinateBits) - 1};
+        static const int      m_knFromXShift      {0};
+        static const int      m_knFromYShift      {6};
+        static const int      m_knToXShift        {12};
+        static const int      m_knToYShift        {18};
+        static const int      m_knPromotionShift  {24};
+        static const uint32_t m_kuiPromotionMask  {0x0F};
+        static const uint32_t m_kuiUseYFlag       {1u << 28};
+        static const uint32_t m_kuiUseFromFlag    {1u << 29};
+        static const uint32_t m_kuiTestMoveFlag   {1u << 30};
+
+        // The bits compared by SameTo() and operator==()
+        static const uint32_t m_kuiToMask   {(m_kuiCoordinateMask << m_knToXShift) | (m_kuiCoordinateMask << m_knToYShift)};
+        static const uint32_t m_kuiMoveMask {(1u << 28) - 1};
+
+        // Read and write a coordinate, held plus one so that -1 is zero
+        int  Field(int nShift) const { return static_cast<int>((m_uiMove >> nShift) & m_kuiCoordinateMask) - 1; }
+        void SetField(int nShift, int n)
+        {
+            uint32_t uiField = ((n >= -1) && (n < static_cast<int>(m_kuiCoordinateMask))) ? static_cast<uint32_t>(n + 1) : 0;
+            m_uiMove = (m_uiMove & ~(m_kuiCoordinateMask << nShift)) | (uiField << nShift);
+        }
+
+        void SetFlag(uint32_t uiFlag, bool b) { if (b) m_uiMove |= uiFlag; else m_uiMove &= ~uiFlag; }
+
+        // The packed move; no coordinates, and the Y-coordinate used, as for a GameMove
+        uint32_t m_uiMove {m_kuiUseYFlag};
+};
+
+#endif // BOARDMOVE_H
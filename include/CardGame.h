@@ -101,6 +101,9 @@ class CardGame : public Game
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const = 0;
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const = 0;
+        virtual size_t CloneSize() const = 0;
 
         // Get move flags
         bool FoldingAllowed() const                { return m_bFoldingAllowed; }
@@ -112,6 +112,9 @@ class CardGameBasicRummy : public CardGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new CardGameBasicRummy(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) CardGameBasicRummy(*this); }
+        virtual size_t CloneSize() const override { return sizeof(CardGameBasicRummy); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "Basic Rummy"; }
@@ -101,6 +101,9 @@ class CardGameGoFish : public CardGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new CardGameGoFish(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) CardGameGoFish(*this); }
+        virtual size_t CloneSize() const override { return sizeof(CardGameGoFish); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "Go Fish"; }
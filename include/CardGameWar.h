@@ -72,6 +72,9 @@ class CardGameWar : public CardGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new CardGameWar(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) CardGameWar(*this); }
+        virtual size_t CloneSize() const override { return sizeof(CardGameWar); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "War"; }
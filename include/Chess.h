@@ -28,11 +28,11 @@
 
 #include "ChessGame.h"
 
-class Chess : public ChessGame
+class Chess : public ChessGame<ChessRules<8, 8, true,  true,  true>>
 {
     public:
         // Constructor
-        explicit Chess(GameType ecGameType) : ChessGame(ecGameType, 8, 8, 12, true, true, true)
+        explicit Chess(GameType ecGameType) : ChessGame(ecGameType, 12, true, true, true)
         {
             SetBoard();
         }
@@ -41,6 +41,9 @@ class Chess : public ChessGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new Chess(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) Chess(*this); }
+        virtual size_t CloneSize() const override { return sizeof(Chess); }
         // Return the title of the game
         virtual std::string Title() const override { return "Chess"; }
         // Set up the board
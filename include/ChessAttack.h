@@ -30,11 +30,11 @@
 
 #include "ChessGame.h"
 
-class ChessAttack : public ChessGame
+class ChessAttack : public ChessGame<ChessRules<5, 6, true,  true,  true>>
 {
     public:
         // Constructor
-        explicit ChessAttack(GameType ecGameType) : ChessGame(ecGameType, 5, 6, 12, true, true, true)
+        explicit ChessAttack(GameType ecGameType) : ChessGame(ecGameType, 12, true, true, true)
         {
             SetBoard();
         }
@@ -43,6 +43,9 @@ class ChessAttack : public ChessGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new ChessAttack(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) ChessAttack(*this); }
+        virtual size_t CloneSize() const override { return sizeof(ChessAttack); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "Chess Attack Minichess"; }
@@ -30,11 +30,11 @@
 
 #include "ChessGame.h"
 
-class ChessBaby : public ChessGame
+class ChessBaby : public ChessGame<ChessRules<5, 5, true,  true,  true>>
 {
     public:
         // Constructor
-        explicit ChessBaby(GameType ecGameType) : ChessGame(ecGameType, 5, 5, 12, true, true, true)
+        explicit ChessBaby(GameType ecGameType) : ChessGame(ecGameType, 12, true, true, true)
         {
             SetBoard();
         }
@@ -43,6 +43,9 @@ class ChessBaby : public ChessGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new ChessBaby(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) ChessBaby(*this); }
+        virtual size_t CloneSize() const override { return sizeof(ChessBaby); }
         // Return the title of the game
         virtual std::string Title() const override { return "Baby Minichess"; }
 
@@ -30,18 +30,12 @@
 
 #include "ChessGame.h"
 
-class ChessElena : public ChessGame
+class ChessElena : public ChessGame<ChessRules<5, 6, false, false, false>>
 {
     public:
         // Constructor
-        explicit ChessElena(GameType ecGameType) : ChessGame(ecGameType, 5, 6, 12, true, true, true)
+        explicit ChessElena(GameType ecGameType) : ChessGame(ecGameType, 12, true, true, true)
         {
-            // Turn off castling, pawn double move, and en passant
-            m_abCastlingAllowed[0] = false;
-            m_abCastlingAllowed[1] = false;
-            m_bDoublePawnMoveAllowed = false;
-            m_bEnPassantAllowed = false;
-
             SetBoard();
         }
         // Destructor
@@ -49,6 +43,9 @@ class ChessElena : public ChessGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new ChessElena(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) ChessElena(*this); }
+        virtual size_t CloneSize() const override { return sizeof(ChessElena); }
         // Return the title of the game
         virtual std::string Title() const override { return "Elena Minichess"; }
 
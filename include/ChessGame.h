@@ -19,7 +19,11 @@
 
 /** \file
  *
- * \brief The ChessGame class represents a virtual chess game.
+ * \brief The ChessGame class template represents a virtual chess game.
+ *
+ * The template parameter is a ChessRules giving the board size and which
+ * moves are allowed.  The member functions are defined in ChessGame.cpp,
+ * which instantiates ChessGame for the rules of each variant.
  *
  */
 
@@ -27,19 +31,24 @@
 #define CHESSGAME_H
 
 #include <iostream>
+#include <memory>
 #include <string>
-#include <unordered_set>
 
 #include "BoardGame.h"
+#include "ChessRules.h"
 #include "GameAIException.h"
+#include "GameArena.h"
+#include "PawnHashTable.h"
+#include "SharedStack.h"
 
-class ChessGame : public BoardGame
+template <class Rules>
+class ChessGame : public BoardGame<GameBoard>
 {
     public:
         // Construct a ChessGame
-        ChessGame(GameType ecGameType, int nX, int nY, int nNumberOfPieces,
+        ChessGame(GameType ecGameType, int nNumberOfPieces,
                   bool bDisplayGrid, bool bDisplayXCoordinates, bool bDisplayYCoordinates) :
-            BoardGame(ecGameType, nX, nY, nNumberOfPieces, bDisplayGrid, bDisplayXCoordinates, bDisplayYCoordinates)
+            BoardGame(ecGameType, Rules::m_knX, Rules::m_knY, nNumberOfPieces, bDisplayGrid, bDisplayXCoordinates, bDisplayYCoordinates)
             {
                 int nBufLen    {50};
                 std::time_t t = std::time(nullptr);
@@ -65,7 +74,9 @@ class ChessGame : public BoardGame
         virtual GameMove GenerateMove(std::string sMove) const override;
 
         // Apply the move to the game
-        virtual bool ApplyMove(int nPlayer, GameMove &cGameMove) override;
+        virtual bool ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
+        // Apply a move generated by the game without validating it
+        virtual bool ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
 
         // Announce the move made
         virtual std::string AnnounceMove(int nPlayer, const GameMove &cGameMove) const override;
@@ -75,15 +86,20 @@ class ChessGame : public BoardGame
 
         // Check to see if the game has ended
         virtual bool GameEnded(int nPlayer) override;
+        // Check to see if the game has ended and, if not, fill a list with the valid moves
+        virtual bool GameEndedWithMoves(int nPlayer, MoveList &cMoveList) override;
 
-        // Generate a vector of valid moves
-        virtual std::vector<GameMove> GenerateMoves(int nPlayer) override;
+        // Fill a list with the valid moves
+        virtual void GenerateBoardMoves(int nPlayer, MoveList &cMoveList) override;
 
         // Return the score of the game
         virtual std::string GameScore() const override;
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const = 0;
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const = 0;
+        virtual size_t CloneSize() const = 0;
 
         // Return the description of the game
         virtual std::string Description() const override;
@@ -98,31 +114,53 @@ class ChessGame : public BoardGame
         virtual bool WriteMovesToFile(const std::string &sFileName) override;
 
     protected:
+        // Whether a location is on the board, with the bounds known at compile time
+        static bool OnBoard(int nX, int nY) { return (nX >= 0) && (nX < Rules::m_knX) && (nY >= 0) && (nY < Rules::m_knY); }
+
         // Generate piece moves
-        void GeneratePawnMoves(GameMove cGameMove,   int nPlayer, std::vector<GameMove> &vGameMoves) const;
-        void GenerateRookMoves(GameMove cGameMove,   int nPlayer, std::vector<GameMove> &vGameMoves, bool bUnlimitedMoves=true) const;
-        void GenerateBishopMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves, bool bUnlimitedMoves=true) const;
-        void GenerateQueenMoves(GameMove cGameMove,  int nPlayer, std::vector<GameMove> &vGameMoves) const;
-        void GenerateKingMoves(GameMove cGameMove,   int nPlayer, std::vector<GameMove> &vGameMoves) const;
-        void GenerateCastleMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const;
-        bool GenerateLinearMove(GameMove cGameMove,  int nPlayer, std::vector<GameMove> &vGameMoves) const;
-        void GenerateKnightMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const;
-        void GenerateKnightMove(GameMove cGameMove,  int nPlayer, std::vector<GameMove> &vGameMoves) const;
-        std::vector<GameMove> GenerateMovesForPiece(int nPlayer, const GameMove &cGameMove) const;
+        void GeneratePawnMoves(BoardMove cBoardMove,   int nPlayer, MoveList &cMoveList) const;
+        void AddPawnMove(BoardMove cBoardMove,         int nPlayer, MoveList &cMoveList) const;
+        void GenerateRookMoves(BoardMove cBoardMove,   int nPlayer, MoveList &cMoveList, bool bUnlimitedMoves=true) const;
+        void GenerateBishopMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList, bool bUnlimitedMoves=true) const;
+        void GenerateQueenMoves(BoardMove cBoardMove,  int nPlayer, MoveList &cMoveList) const;
+        void GenerateKingMoves(BoardMove cBoardMove,   int nPlayer, MoveList &cMoveList) const;
+        void GenerateCastleMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const;
+        bool GenerateLinearMove(BoardMove cBoardMove,  int nPlayer, MoveList &cMoveList) const;
+        void GenerateKnightMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const;
+        void GenerateKnightMove(BoardMove cBoardMove,  int nPlayer, MoveList &cMoveList) const;
+        void GenerateMovesForPiece(int nPlayer, const BoardMove &cBoardMove, MoveList &cMoveList) const;
         bool FindPiece(int &nX, int &nY, int nPlayer, char cToken) const;
 
+        // Convert between a promotion piece index and its token
+        static char PromotionToken(int nPromotion);
+        static int  PromotionIndex(char cToken);
+
+        // Make a move on the board, without checking it
+        bool MakeBoardMove(int nPlayer, const BoardMove &cBoardMove);
+
+        // Initialize the Zobrist keys and King locations for the starting position
+        void InitializePosition();
+        // Update the board and pawn Zobrist keys
+        void UpdateZobristKeys(int nPX, int nPY, int nSX, int nSY);
+        // Return the sides a player may still castle to, and toggle the keys of changed sides
+        int  CastlingRights(int nPlayer) const;
+        void UpdateCastlingKeys(int nPlayer, int nChangedRights);
+
         // Tests for various chess positions
-        bool TestForAdjacentKings(const GameMove &cGameMove, int nPlayer) const;
-        void TestForCheck(int nPlayer, GameMove cGameMove, std::vector<GameMove> &vGameMoves) const;
+        bool TestForAdjacentKings(const BoardMove &cBoardMove, int nPlayer) const;
+        void TestForCheck(int nPlayer, BoardMove cBoardMove, MoveList &cMoveList) const;
         bool KingInCheck(int nPlayer) const;
         bool AttackingTheKing(int nKX, int nKY, int nPlayer, int nX, int nY) const;
         bool KingCastled(int nPlayer) const { if (m_abKingCastled[nPlayer - 1]) return true; else return false; }
         bool RooksConnected(int nPlayer) const;
+        int  Repetitions() const;
 
         // Count the value of pieces for nPlayer
         int  CountEvaluation(int nPlayer) const;
-        int  MobilityEvaluation(int nPlayer);
+        int  MobilityEvaluation(int nPlayer) const;
+        int  RayMobility(int nX, int nY, int nPlayer, int nDX, int nDY, bool bUnlimitedMoves) const;
         void CountPawns(int nPlayer, int &nDoubled, int &nIsolated, int &nPassed) const;
+        void ScanPawns(int nPlayer, int &nDoubled, int &nIsolated, int &nPassed) const;
         int  MinorPiecesDevelopedEvaluation(int nPlayer) const;
 
         // Start date and time of the game
@@ -134,15 +172,19 @@ class ChessGame : public BoardGame
         //const std::string sRanks        {"12345678"};
         //const std::string sCaptures     {"x"};
 
+        // Castling rights, lost once a player's King moves
+        bool m_abCastlingAllowed[2]     { Rules::m_kbCastling, Rules::m_kbCastling };
+
         // Game options
-        bool m_abCastlingAllowed[2]     { true };
-        bool m_bDoublePawnMoveAllowed   { true };
-        bool m_bEnPassantAllowed        { true };
         bool m_bAutomaticPromoteToQueen { true };
 
         // King castled?
         bool m_abKingCastled[2] {false};
 
+        // King locations
+        int m_anKingX[2] {0, 0};
+        int m_anKingY[2] {0, 0};
+
         // Piece tokens
         static const char m_kcPawnToken   {'P'};
         static const char m_kcRookToken   {'R'};
@@ -162,6 +204,10 @@ class ChessGame : public BoardGame
 
         // Piece indices, used in Zobrist hashing
         static const int m_knPieceIndexOffset {6};
+        // Sides to castle to, as bits of the castling rights
+        static const int m_knCastleWest {0x01};
+        static const int m_knCastleEast {0x02};
+
         static const int m_knWhitePawnIndex   {0};
         static const int m_knWhiteRookIndex   {1};
         static const int m_knWhiteKnightIndex {2};
@@ -175,8 +221,26 @@ class ChessGame : public BoardGame
         static const int m_knBlackQueenIndex  {m_knWhiteQueenIndex  + m_knPieceIndexOffset};
         static const int m_knBlackKingIndex   {m_knWhiteKingIndex   + m_knPieceIndexOffset};
 
-        // Capture Zobrist keys in an unordered set
-        std::unordered_multiset<uint64_t> m_uomsZobrist {};
+        // Steps used to count mobility; the first four are orthogonal, the last four diagonal
+        static constexpr int m_kaiKingOffsets[8][2]   { {0, 1}, {0, -1}, {1, 0}, {-1, 0}, {1, 1}, {1, -1}, {-1, -1}, {-1, 1} };
+        static constexpr int m_kaiKnightOffsets[8][2] { {2, 1}, {1, 2}, {-1, 2}, {-2, 1}, {-2, -1}, {-1, -2}, {1, -2}, {2, -1} };
+
+        // Pawn structure cache, shared by a game and its clones
+        std::shared_ptr<PawnHashTable> m_pcPawnHashTable {std::make_shared<PawnHashTable>()};
+
+        // Slots for the clones that test a move for check, shared with clones
+        std::shared_ptr<GameArena> m_pcCheckArena {std::make_shared<GameArena>(1)};
+        // Slot for this game's check clones, one past the slot of a game that is itself a check clone
+        int m_nCheckSlot {0};
+
+        // Zobrist keys of every position reached, shared with clones
+        SharedStack<uint64_t> m_cZobristHistory {};
+
+        // File of a pawn that just moved two squares, or -1
+        int m_nEnPassantFile {-1};
+
+        // Number of plies since the last capture, pawn move, or castle
+        int m_nPliesSinceIrreversible {0};
 
         // Max repetitions of board position before a draw is called
         static const int m_knMaxRepetition {3};
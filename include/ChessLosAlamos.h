@@ -30,11 +30,11 @@
 
 #include "ChessGame.h"
 
-class ChessLosAlamos : public ChessGame
+class ChessLosAlamos : public ChessGame<ChessRules<6, 6, false, false, false>>
 {
     public:
         // Constructor
-        explicit ChessLosAlamos(GameType ecGameType) : ChessGame(ecGameType, 6, 6, 10, true, true, true)
+        explicit ChessLosAlamos(GameType ecGameType) : ChessGame(ecGameType, 12, true, true, true)
         {
             SetBoard();
         }
@@ -43,6 +43,9 @@ class ChessLosAlamos : public ChessGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new ChessLosAlamos(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) ChessLosAlamos(*this); }
+        virtual size_t CloneSize() const override { return sizeof(ChessLosAlamos); }
         // Return the title of the game
         virtual std::string Title() const override { return "Los Alamos Minichess"; }
 
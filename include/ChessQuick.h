@@ -30,18 +30,12 @@
 
 #include "ChessGame.h"
 
-class ChessQuick : public ChessGame
+class ChessQuick : public ChessGame<ChessRules<5, 6, false, false, false>>
 {
     public:
         // Constructor
-        explicit ChessQuick(GameType ecGameType) : ChessGame(ecGameType, 5, 6, 12, true, true, true)
+        explicit ChessQuick(GameType ecGameType) : ChessGame(ecGameType, 12, true, true, true)
         {
-            // Turn off castling, pawn double move, and en passant
-            m_abCastlingAllowed[0] = false;
-            m_abCastlingAllowed[1] = false;
-            m_bDoublePawnMoveAllowed = false;
-            m_bEnPassantAllowed = false;
-
             SetBoard();
         }
         // Destructor
@@ -49,6 +43,9 @@ class ChessQuick : public ChessGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new ChessQuick(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) ChessQuick(*this); }
+        virtual size_t CloneSize() const override { return sizeof(ChessQuick); }
         // Return the title of the game
         virtual std::string Title() const override { return "Quick Minichess"; }
 
@@ -0,0 +1,60 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The ChessRules class template holds the rules of a chess variant
+ * as compile-time constants.
+ *
+ * ChessGame takes a ChessRules as its template parameter, so each variant
+ * gets move generation and evaluation compiled for its own board size and
+ * rules, with the bounds folded into constants and the code for rules it
+ * does not use removed.
+ *
+ */
+
+#ifndef CHESSRULES_H
+#define CHESSRULES_H
+
+template <int nX, int nY, bool bCastling, bool bDoublePawnMove, bool bEnPassant>
+struct ChessRules
+{
+    // Board dimensions
+    static constexpr int  m_knX {nX};
+    static constexpr int  m_knY {nY};
+
+    // Which moves are allowed
+    static constexpr bool m_kbCastling       {bCastling};
+    static constexpr bool m_kbDoublePawnMove {bDoublePawnMove};
+    static constexpr bool m_kbEnPassant      {bEnPassant};
+};
+
+// Definitions, for when a rule is passed by reference
+template <int nX, int nY, bool bCastling, bool bDoublePawnMove, bool bEnPassant>
+constexpr int  ChessRules<nX, nY, bCastling, bDoublePawnMove, bEnPassant>::m_knX;
+template <int nX, int nY, bool bCastling, bool bDoublePawnMove, bool bEnPassant>
+constexpr int  ChessRules<nX, nY, bCastling, bDoublePawnMove, bEnPassant>::m_knY;
+template <int nX, int nY, bool bCastling, bool bDoublePawnMove, bool bEnPassant>
+constexpr bool ChessRules<nX, nY, bCastling, bDoublePawnMove, bEnPassant>::m_kbCastling;
+template <int nX, int nY, bool bCastling, bool bDoublePawnMove, bool bEnPassant>
+constexpr bool ChessRules<nX, nY, bCastling, bDoublePawnMove, bEnPassant>::m_kbDoublePawnMove;
+template <int nX, int nY, bool bCastling, bool bDoublePawnMove, bool bEnPassant>
+constexpr bool ChessRules<nX, nY, bCastling, bDoublePawnMove, bEnPassant>::m_kbEnPassant;
+
+#endif // CHESSRULES_H
@@ -30,16 +30,12 @@
 
 #include "ChessGame.h"
 
-class ChessSpeed : public ChessGame
+class ChessSpeed : public ChessGame<ChessRules<5, 6, true,  false, false>>
 {
     public:
         // Constructor
-        explicit ChessSpeed(GameType ecGameType) : ChessGame(ecGameType, 5, 6, 12, true, true, true)
+        explicit ChessSpeed(GameType ecGameType) : ChessGame(ecGameType, 12, true, true, true)
         {
-            // Turn off pawn double move and en passant
-            m_bDoublePawnMoveAllowed = false;
-            m_bEnPassantAllowed = false;
-
             SetBoard();
         }
         // Destructor
@@ -47,6 +43,9 @@ class ChessSpeed : public ChessGame
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new ChessSpeed(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) ChessSpeed(*this); }
+        virtual size_t CloneSize() const override { return sizeof(ChessSpeed); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "Speed Minichess"; }
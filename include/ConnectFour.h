@@ -21,18 +21,29 @@
  *
  * \brief The ConnectFour class represents a Connect Four game.
  *
+ * Alongside the GameBoard, the tokens are kept in a ConnectFourBitboard,
+ * which generates the moves and finds lines of four, and which a
+ * ConnectFourSolver searches for perfect moves, with the help of a
+ * ConnectFourOpeningBook in the opening.
+ *
  */
 
 #ifndef CONNECTFOUR_H
 #define CONNECTFOUR_H
 
+#include <memory>
+
+#include "ConnectFourBitboard.h"
+#include "ConnectFourOpeningBook.h"
+#include "ConnectFourSolver.h"
 #include "LinearGame.h"
+#include "Zobrist.h"
 
-class ConnectFour : public LinearGame
+class ConnectFour : public LinearGame<LinearLines<ConnectFourBitboard::m_knWidth, ConnectFourBitboard::m_knHeight, 4>>
 {
     public:
         // Constructor
-        explicit ConnectFour(GameType ecGameType) : LinearGame(ecGameType, 7, 6, '1', '2', 4, true, true, true, false) {}
+        explicit ConnectFour(GameType ecGameType) : LinearGame(ecGameType, '1', '2', 0, true, true, true, false) {}
 
         // Destructor
         ~ConnectFour() {}
@@ -41,13 +52,32 @@ class ConnectFour : public LinearGame
         virtual int  PreferredMove(const GameMove &cGameMove) const override;
 
         // Apply the move to the game
-        virtual bool ApplyMove(int nPlayer, GameMove &cGameMove) override;
-
-        // Generate a vector of valis moves
-        virtual std::vector<GameMove> GenerateMoves(int nPlayer) override;
+        virtual bool ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
+        // Apply a move generated by the game without validating it
+        virtual bool ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
+
+        // Fill a list with the valid moves
+        virtual void GenerateBoardMoves(int nPlayer, MoveList &cMoveList) override;
+
+        // Check to see if the game has ended and, if not, fill a list with the valid moves
+        virtual bool GameEndedWithMoves(int nPlayer, MoveList &cMoveList) override;
+
+        // Connect Four can be solved for a perfect move
+        virtual bool Solvable() const override { return true; }
+        // Generate a perfect move by solving the game
+        virtual GameMove SolvedMove(int nPlayer) override;
+        // Solve the openings to a number of plies and write them to a file
+        virtual bool WriteOpeningBook(const std::string &sFileName, int nPlies) override;
+        // Use openings solved into a file when solving the game
+        virtual bool ReadOpeningBook(const std::string &sFileName) override;
+        // Return a key shared by the position and its mirror image, hashed from the bitboard's
+        virtual bool CanonicalKey(uint64_t &uiKey) const override { uiKey = Zobrist::SplitMix64(m_cBitboard.CanonicalKey(), 0); return true; }
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new ConnectFour(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) ConnectFour(*this); }
+        virtual size_t CloneSize() const override { return sizeof(ConnectFour); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "Connect Four"; }
@@ -58,6 +88,12 @@ class ConnectFour : public LinearGame
     private:
         // Return the bottom row in the Connect Four grid
         int  FindBottom(int x) const;
+
+        // The tokens, as bitboards
+        ConnectFourBitboard m_cBitboard {};
+
+        // Solver, made when first used and shared with clones
+        std::shared_ptr<ConnectFourSolver> m_pcSolver {};
 };
 
 #endif // CONNECTFOUR_H
@@ -0,0 +1,197 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The ConnectFourBitboard class holds a 7x6 Connect Four position in
+ * two 64-bit masks.
+ *
+ * Each column takes seven bits, the bottom row in the lowest bit, and the
+ * seventh bit left empty so that lines cannot wrap from one column into the
+ * next.  One mask holds the tokens of the player to move and the other holds
+ * every token, so adding a column's bottom bit to the mask finds the square
+ * a token dropped into the column lands on.  A line of four is found by
+ * shifting a player's tokens along each direction and and-ing the results.
+ *
+ * A position and its mirror image have the same score, so either can stand
+ * for both.  The two masks are also kept for the mirror image, so that the
+ * lower of the two keys is found without reversing the columns.
+ *
+ */
+
+#ifndef CONNECTFOURBITBOARD_H
+#define CONNECTFOURBITBOARD_H
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+
+class ConnectFourBitboard
+{
+    public:
+        // Board dimensions
+        static const int m_knWidth  {7};
+        static const int m_knHeight {6};
+
+        // Whether a column has room for a token
+        bool CanPlay(int nColumn) const           { return (m_uiMask & TopMask(nColumn)) == 0; }
+        // Return the number of tokens in a column
+        int  Height(int nColumn) const            { return __builtin_popcountll(m_uiMask & ColumnMask(nColumn)); }
+
+        // Drop a token for the player to move into a column
+        void Play(int nColumn)                    { PlaySquare((m_uiMask + BottomMask(nColumn)) & ColumnMask(nColumn)); }
+        // Place a token for the player to move on the square of a single bit, then pass the turn
+        void PlaySquare(uint64_t uiMove)
+        {
+            m_uiCurrent ^= m_uiMask;
+            m_uiMask |= uiMove;
+            m_uiMirrorCurrent ^= m_uiMirrorMask;
+            m_uiMirrorMask |= Mirror(uiMove);
+            ++m_nMoves;
+        }
+
+        // Whether the player to move wins by dropping a token into a column
+        bool IsWinningMove(int nColumn) const     { return (WinningSquares() & Possible() & ColumnMask(nColumn)) != 0; }
+        // Whether the player to move can win with their next token
+        bool CanWinNext() const                   { return (WinningSquares() & Possible()) != 0; }
+
+        // Return the squares a token can be dropped on, one per column with room
+        uint64_t Possible() const                 { return (m_uiMask + m_kuiBottomMask) & m_kuiBoardMask; }
+        // Return the moves that do not lose at once, or zero if every move does
+        uint64_t PossibleNonLosingMoves() const;
+        // Return the number of lines of four the player to move would threaten after a move
+        int  MoveScore(uint64_t uiMove) const     { return __builtin_popcountll(WinningSquares(m_uiCurrent | uiMove, m_uiMask)); }
+
+        // Return the tokens of the player to move and of the player who just moved
+        uint64_t Current() const                  { return m_uiCurrent; }
+        uint64_t Opponent() const                 { return m_uiCurrent ^ m_uiMask; }
+        // Return every token on the board
+        uint64_t Mask() const                     { return m_uiMask; }
+        // Return the number of tokens played
+        int  Moves() const                        { return m_nMoves; }
+        // Return a key unique to the position
+        uint64_t Key() const                      { return m_uiCurrent + m_uiMask; }
+        // Return the key of the position or of its mirror image, whichever is lower
+        uint64_t CanonicalKey() const             { return std::min(Key(), m_uiMirrorCurrent + m_uiMirrorMask); }
+
+        // Return the bits of a column, of its bottom square, and of its top square
+        static uint64_t ColumnMask(int nColumn)   { return ((UINT64_C(1) << m_knHeight) - 1) << (nColumn * (m_knHeight + 1)); }
+        static uint64_t BottomMask(int nColumn)   { return UINT64_C(1) << (nColumn * (m_knHeight + 1)); }
+        static uint64_t TopMask(int nColumn)      { return UINT64_C(1) << (m_knHeight - 1 + nColumn * (m_knHeight + 1)); }
+
+        // Whether tokens hold a line of four, horizontally, vertically, or along either diagonal
+        static bool HorizontalLine(uint64_t uiTokens)     { return Line(uiTokens, m_knHeight + 1); }
+        static bool VerticalLine(uint64_t uiTokens)       { return Line(uiTokens, 1); }
+        static bool DiagonalULLRLine(uint64_t uiTokens)   { return Line(uiTokens, m_knHeight); }
+        static bool DiagonalURLLLine(uint64_t uiTokens)   { return Line(uiTokens, m_knHeight + 2); }
+
+    private:
+        // Whether tokens hold a line of four along the direction of a shift
+        static bool Line(uint64_t uiTokens, int nShift)
+        {
+            uint64_t uiPairs = uiTokens & (uiTokens >> nShift);
+            return (uiPairs & (uiPairs >> (2 * nShift))) != 0;
+        }
+
+        // Return the square of a single bit in the mirror image of the board
+        static uint64_t Mirror(uint64_t uiSquare)
+        {
+            int nShift = (m_knWidth - 1 - (2 * (__builtin_ctzll(uiSquare) / (m_knHeight + 1)))) * (m_knHeight + 1);
+            return (nShift >= 0) ? (uiSquare << nShift) : (uiSquare >> -nShift);
+        }
+
+        // Return the empty squares that would complete a line of four for the player to move
+        uint64_t WinningSquares() const           { return WinningSquares(m_uiCurrent, m_uiMask); }
+        static uint64_t WinningSquares(uint64_t uiTokens, uint64_t uiMask);
+
+        // Bits of the bottom row, and of every square on the board
+        static const uint64_t m_kuiBottomMask {UINT64_C(0x0000040810204081)};
+        static const uint64_t m_kuiBoardMask  {m_kuiBottomMask * ((UINT64_C(1) << m_knHeight) - 1)};
+
+        // Tokens of the player to move
+        uint64_t m_uiCurrent {0};
+        // Every token on the board
+        uint64_t m_uiMask    {0};
+        // The same two masks for the mirror image of the board
+        uint64_t m_uiMirrorCurrent {0};
+        uint64_t m_uiMirrorMask    {0};
+        // Number of tokens played
+        int      m_nMoves    {0};
+};
+
+/**
+  * Return the moves that do not lose at once.
+  *
+  * A move loses at once if it leaves the opponent a square to complete a
+  * line on, either because the move ignores a line the opponent already
+  * threatens or because it fills the square under a threatened one.
+  *
+  * \return A bit per non-losing move, or zero if every move loses.
+  */
+
+inline uint64_t ConnectFourBitboard::PossibleNonLosingMoves() const
+{
+    uint64_t uiPossible     = Possible();
+    uint64_t uiOpponentWins = WinningSquares(Opponent(), m_uiMask);
+    uint64_t uiForced       = uiPossible & uiOpponentWins;
+
+    if (uiForced)
+    {
+        // Two threats cannot both be blocked
+        if (uiForced & (uiForced - 1))
+            return 0;
+        uiPossible = uiForced;
+    }
+
+    return uiPossible & ~(uiOpponentWins >> 1);
+}
+
+/**
+  * Return the empty squares that would complete a line of four.
+  *
+  * For each direction, shift the tokens to find three in a line ending next
+  * to a square, or two and one with the square between them.
+  *
+  * \param uiTokens The tokens of one player
+  * \param uiMask   Every token on the board
+  *
+  * \return A bit per empty square that completes a line.
+  */
+
+inline uint64_t ConnectFourBitboard::WinningSquares(uint64_t uiTokens, uint64_t uiMask)
+{
+    // Vertical lines only complete upwards
+    uint64_t uiWins = (uiTokens << 1) & (uiTokens << 2) & (uiTokens << 3);
+
+    // Horizontal and both diagonal lines
+    for (int nShift : {m_knHeight + 1, m_knHeight, m_knHeight + 2})
+    {
+        uint64_t uiPairs = (uiTokens << nShift) & (uiTokens << (2 * nShift));
+        uiWins |= uiPairs & (uiTokens << (3 * nShift));
+        uiWins |= uiPairs & (uiTokens >> nShift);
+
+        uiPairs = (uiTokens >> nShift) & (uiTokens >> (2 * nShift));
+        uiWins |= uiPairs & (uiTokens << nShift);
+        uiWins |= uiPairs & (uiTokens >> (3 * nShift));
+    }
+
+    return uiWins & (m_kuiBoardMask ^ uiMask);
+}
+
+#endif // CONNECTFOURBITBOARD_H
@@ -0,0 +1,108 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The ConnectFourOpeningBook class holds the scores of every Connect
+ * Four position up to a number of plies.
+ *
+ * A book is generated once, by solving every position from the last ply to
+ * the first, so that each position is solved with the positions after it
+ * already in the book.  A position and its mirror image share an entry.
+ *
+ * The book file is a header followed by one 64-bit entry per position, the
+ * canonical key of the position above its score in the low byte, sorted.
+ * Opening a book maps the file into memory, where a lookup is a binary
+ * search of the entries.  Where memory mapping is not available, as on
+ * Windows, the file is read into memory instead.  The file is written in
+ * the byte order of the computer that generates it.
+ *
+ */
+
+#ifndef CONNECTFOUROPENINGBOOK_H
+#define CONNECTFOUROPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ConnectFourBitboard.h"
+#include "Logger.h"
+
+class ConnectFourSolver;
+
+class ConnectFourOpeningBook
+{
+    public:
+        // Construct an empty book
+        ConnectFourOpeningBook() {}
+
+        // Unmap the book
+        ~ConnectFourOpeningBook() { Close(); }
+
+        // A book may own a memory mapping, so it is not copied
+        ConnectFourOpeningBook(const ConnectFourOpeningBook &) = delete;
+        ConnectFourOpeningBook & operator=(const ConnectFourOpeningBook &) = delete;
+
+        // Map a book file into memory
+        bool Open(const std::string &sFileName);
+        // Solve every position up to a number of plies into the book
+        void Generate(int nPlies, ConnectFourSolver &cSolver, const Logger &cLogger);
+        // Write the book to a file
+        bool Write(const std::string &sFileName) const;
+
+        // Look up the score of a position for the player to move
+        bool Lookup(const ConnectFourBitboard &cPosition, int &nScore) const;
+
+        // Return the number of plies the book covers
+        int  Plies() const { return m_nPlies; }
+
+    private:
+        // Release the memory mapping, if any
+        void Close();
+
+        // Book file header
+        struct Header
+        {
+            char     acMagic[8];
+            uint32_t uiPlies;
+            uint32_t uiReserved;
+            uint64_t uiEntries;
+        };
+
+        // Identifies a book file, and its version
+        static const char m_kacMagic[8];
+
+        // Number of plies covered
+        int m_nPlies {-1};
+
+        // The sorted entries, in the mapping or in m_vuiEntries
+        const uint64_t *m_puiEntries {nullptr};
+        size_t m_nEntries {0};
+
+        // Entries read or generated into memory
+        std::vector<uint64_t> m_vuiEntries {};
+
+        // Memory mapping of a book file
+        void  *m_pvMapping    {nullptr};
+        size_t m_nMappingSize {0};
+};
+
+#endif // CONNECTFOUROPENINGBOOK_H
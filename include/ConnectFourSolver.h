@@ -0,0 +1,118 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The ConnectFourSolver class finds the perfect move in a Connect
+ * Four position.
+ *
+ * The solver searches a ConnectFourBitboard to the end of the game with
+ * negamax and alpha-beta pruning, narrowing the score with null-window
+ * searches.  Moves are tried centre first and then by the number of lines
+ * they threaten, and bounds on the scores of positions searched are kept in
+ * a transposition table for the life of the solver, a position and its
+ * mirror image sharing one entry.  Positions in an opening book are looked
+ * up instead of searched.
+ *
+ * A score is zero for a draw, positive if the player to move can force a
+ * win, and negative if they cannot avoid a loss.  The sooner the win, the
+ * larger the score: a win with the player's last token is worth one.
+ *
+ */
+
+#ifndef CONNECTFOURSOLVER_H
+#define CONNECTFOURSOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ConnectFourBitboard.h"
+#include "ConnectFourOpeningBook.h"
+
+class ConnectFourSolver
+{
+    public:
+        // Construct a solver with a transposition table of a prime number of entries
+        explicit ConnectFourSolver(int nEntries = m_knDefaultEntries) :
+            m_vuiKeys(nEntries),
+            m_vuiValues(nEntries)
+        {}
+
+        // Return the score of a position for the player to move
+        int  Solve(const ConnectFourBitboard &cPosition);
+        // Return the best column for the player to move, and its score
+        int  BestColumn(const ConnectFourBitboard &cPosition, int &nScore);
+
+        // Return the number of positions searched
+        uint64_t Nodes() const { return m_uiNodes; }
+
+        // Look up positions in an opening book before searching them
+        void SetOpeningBook(std::shared_ptr<const ConnectFourOpeningBook> pcOpeningBook) { m_pcOpeningBook = pcOpeningBook; }
+
+        // Lowest and highest scores of a position that is not already won
+        static const int m_knMinScore {-(ConnectFourBitboard::m_knWidth * ConnectFourBitboard::m_knHeight) / 2 + 3};
+        static const int m_knMaxScore {(ConnectFourBitboard::m_knWidth * ConnectFourBitboard::m_knHeight + 1) / 2 - 3};
+
+    private:
+        // Solve a position within a range of scores
+        int  Solve(const ConnectFourBitboard &cPosition, int nLowest, int nHighest);
+        // Search a position, without a win for the player to move, within a window of scores
+        int  Negamax(const ConnectFourBitboard &cPosition, int nAlpha, int nBeta);
+
+        // Look up the score of a position in the opening book, if any
+        bool BookScore(const ConnectFourBitboard &cPosition, int &nScore) const
+            { return (m_pcOpeningBook != nullptr) && (cPosition.Moves() <= m_pcOpeningBook->Plies()) && m_pcOpeningBook->Lookup(cPosition, nScore); }
+
+        // Return the bound stored for a position, or zero if none
+        int  Probe(uint64_t uiKey) const
+        {
+            size_t nIndex = uiKey % m_vuiKeys.size();
+            return (m_vuiKeys[nIndex] == static_cast<uint32_t>(uiKey)) ? m_vuiValues[nIndex] : 0;
+        }
+        // Store a bound for a position, replacing whatever occupied its slot
+        void Store(uint64_t uiKey, int nValue)
+        {
+            size_t nIndex = uiKey % m_vuiKeys.size();
+            m_vuiKeys[nIndex]   = static_cast<uint32_t>(uiKey);
+            m_vuiValues[nIndex] = static_cast<uint8_t>(nValue);
+        }
+
+        // Default number of entries, a prime large enough that the low 32 bits
+        // of a key and its slot identify the position
+        static const int m_knDefaultEntries {8388593};
+
+        // Transposition table, the low 32 bits of the keys and a bound on the
+        // scores: upper bounds offset to be above zero, and lower bounds
+        // offset to be above the upper bounds
+        std::vector<uint32_t> m_vuiKeys;
+        std::vector<uint8_t>  m_vuiValues;
+
+        // Number of positions searched
+        uint64_t m_uiNodes {0};
+
+        // Opening book, if any
+        std::shared_ptr<const ConnectFourOpeningBook> m_pcOpeningBook {};
+
+        // Columns, centre first
+        static const int m_kanColumnOrder[ConnectFourBitboard::m_knWidth];
+};
+
+#endif // CONNECTFOURSOLVER_H
@@ -27,15 +27,20 @@
 #define GAME_H
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <new>
 #include <vector>
 
 #include "Blackboard.h"
+#include "BoardMove.h"
 #include "GameMove.h"
 #include "GameVocabulary.h"
 #include "Logger.h"
+#include "MoveList.h"
+#include "SharedStack.h"
 
 // Used to identify the type of game
 enum class GameType
@@ -44,6 +49,8 @@ enum class GameType
     TYPE_CONNECT_FOUR,
     TYPE_TTT,
     TYPE_REVERSI,
+    TYPE_GOMOKU,
+    TYPE_GOMOKU_19,
     TYPE_CHESS_GARDNER,
     TYPE_CHESS_BABY,
     TYPE_CHESS_JACOBS_MEIROVITZ,
@@ -59,6 +66,23 @@ enum class GameType
     TYPE_CARDGAME_BASIC_RUMMY
 };
 
+enum class GameOutcome
+{
+    OUTCOME_NOTHING,
+    OUTCOME_RESIGNATION,
+    OUTCOME_THREEFOLD_REPETITION,
+    OUTCOME_CHECKMATE,
+    OUTCOME_STALEMATE,
+    OUTCOME_HORIZONTAL,
+    OUTCOME_VERTICAL,
+    OUTCOME_DIAGONAL_ULLR,
+    OUTCOME_DIAGONAL_URLL,
+    OUTCOME_DIFFERENCE,
+    OUTCOME_ATTRITION,
+    OUTCOME_BOOKS,
+    OUTCOME_POINTS
+};
+
 class Game
 {
     public:
@@ -110,8 +134,43 @@ class Game
         // Generate a vector of valid moves
         virtual std::vector<GameMove> GenerateMoves(int nPlayer) = 0;
 
+        // Whether the game is searched with compact BoardMoves instead of GameMoves
+        virtual bool UsesBoardMoves() const { return false; }
+
+        // Fill a list with the valid moves in compact form
+        virtual void GenerateBoardMoves(int nPlayer, MoveList &cMoveList) { (void)nPlayer; cMoveList.Clear(); }
+
+        // Apply a move in compact form to the game
+        virtual bool ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove) { (void)nPlayer; (void)cBoardMove; return false; }
+        // Apply a move taken from GenerateBoardMoves() without validating it again
+        virtual bool ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove) { return ApplyBoardMove(nPlayer, cBoardMove); }
+
+        // Check to see if the game has ended and, if not, fill a list with the valid moves in compact form
+        virtual bool GameEndedWithMoves(int nPlayer, MoveList &cMoveList) { if (GameEnded(nPlayer)) return true; GenerateBoardMoves(nPlayer, cMoveList); return false; }
+
         // Evaluate the game state from the perspective of the nPlayer
         virtual int  EvaluateGameState(int nPlayer) = 0;
+        // Evaluate the game state with weights read from a file
+        virtual bool ReadEvaluationWeights(const std::string &sFileName) { (void)sFileName; return false; }
+        // Tune evaluation weights to a number of games played and write them to a file
+        virtual bool WriteEvaluationWeights(const std::string &sFileName, int nGames) { (void)sFileName; (void)nGames; return false; }
+        // Return a key shared by the position and every position symmetric to it, if the game keeps one
+        virtual bool CanonicalKey(uint64_t &uiKey) const { (void)uiKey; return false; }
+
+        // Whether the game can be solved for a perfect move
+        virtual bool Solvable() const { return false; }
+        // Whether the game is near enough its end to be solved for a perfect move without being told to
+        virtual bool EndgameSolvable() const { return false; }
+        // Set the number of empty squares left from which the endgame is solved
+        virtual void SetEndgameEmpties(int nEmpties) { (void)nEmpties; }
+        // Generate a perfect move by solving the game
+        virtual GameMove SolvedMove(int nPlayer) { (void)nPlayer; GameMove cGameMove; cGameMove.SetNoMove(true); return cGameMove; }
+        // Generate a move that forces a win, if a search of the player's threats finds one
+        virtual bool ThreatMove(int nPlayer, GameMove &cGameMove) { (void)nPlayer; (void)cGameMove; return false; }
+        // Solve the openings of the game to a number of plies and write them to a file
+        virtual bool WriteOpeningBook(const std::string &sFileName, int nPlies) { (void)sFileName; (void)nPlies; return false; }
+        // Use openings solved into a file when solving the game
+        virtual bool ReadOpeningBook(const std::string &sFileName) { (void)sFileName; return false; }
 
         // Update Blackboard
         virtual void BlackboardUpdate(int nPlayer, Blackboard &cBlackboard) = 0;
@@ -122,6 +181,10 @@ class Game
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const = 0;
 
+        // Clone the current game into a buffer of CloneSize() bytes, as a GameArena does
+        virtual Game *CloneInto(void *pvBuffer) const = 0;
+        virtual size_t CloneSize() const = 0;
+
         // Return the title of the game
         virtual std::string Title() const = 0;
 
@@ -158,10 +221,10 @@ class Game
         GameType Type() const      { return m_ecGameType; }
         int  Player1() const       { return m_knPlayer1; }
         int  Player2() const       { return m_knPlayer2; }
-        GameMove LastMove() const  { if (!m_vGameMoves.empty()) return m_vGameMoves.back(); else { GameMove cGameMove; cGameMove.SetNoMove(true); return cGameMove; } }
+        GameMove LastMove() const  { if (!m_cGameMoves.Empty()) return m_cGameMoves.Back(); else { GameMove cGameMove; cGameMove.SetNoMove(true); return cGameMove; } }
         int  Winner() const        { return m_nWinner; };
         int  NumberOfMoves() const { return m_nNumberOfMoves; }
-        std::string WinBy() const  { return m_sWinBy; }
+        std::string WinBy() const;
         bool GameOver() const      { return m_bGameOver; }
 
     protected:
@@ -188,15 +251,19 @@ class Game
         std::string m_sPlayer2Name {"??"};
         std::string m_sPlayer2Type {"??"};
 
-        // List of all game moves
-        std::vector<GameMove> m_vGameMoves;
+        // List of all game moves, shared with clones so that cloning does not copy it
+        SharedStack<GameMove> m_cGameMoves {};
 
         // Current winning players
         int m_nWinner {0};
         // Number of moves
         int m_nNumberOfMoves {0};
-        // How the winner won
-        std::string m_sWinBy  {};
+        // Record how the game ended, with a number for WinBy() to report
+        void SetOutcome(GameOutcome ecOutcome, int nDetail = 0) { m_ecOutcome = ecOutcome; m_nOutcomeDetail = nDetail; }
+
+        // How the winner won; the text is only built when WinBy() is called
+        GameOutcome m_ecOutcome  {GameOutcome::OUTCOME_NOTHING};
+        int m_nOutcomeDetail     {0};
         // Game Over flag
         bool m_bGameOver {false};
 
@@ -0,0 +1,112 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The GameArena class holds cloned games in reusable slots.
+ *
+ * A depth-first search needs one clone alive at each ply.  Giving each ply
+ * a slot, and cloning into it with Game::CloneInto(), replaces a heap
+ * allocation and free per node with a copy into memory allocated once.
+ * Cloning into a slot destroys the game previously held there, so a game
+ * returned by Clone() is valid until its slot is next used or released, or
+ * the arena is destroyed.  Cloning into a slot past the last adds slots.
+ *
+ */
+
+#ifndef GAMEARENA_H
+#define GAMEARENA_H
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "Game.h"
+
+class GameArena
+{
+    public:
+        // Construct an arena with a number of slots
+        explicit GameArena(int nSlots) :
+            m_vcSlots(nSlots)
+        {}
+
+        // Destroy the games held by the arena
+        ~GameArena()
+        {
+            for (Slot &cSlot : m_vcSlots)
+                Release(cSlot);
+        }
+
+        // An arena owns the games it holds, so it is not copied
+        GameArena(const GameArena &) = delete;
+        GameArena & operator=(const GameArena &) = delete;
+
+        // Clone a game into a slot, destroying the game previously held there
+        Game * Clone(int nSlot, const Game &cGame)
+        {
+            if (nSlot >= static_cast<int>(m_vcSlots.size()))
+                m_vcSlots.resize(nSlot + 1);
+
+            Slot &cSlot = m_vcSlots[nSlot];
+
+            // A game cannot be cloned over itself
+            assert((cSlot.pcGame != &cGame) && "GameArena::Clone() slot holds the game being cloned");
+
+            Release(cSlot);
+
+            // Storage from new[] is aligned for any fundamental type
+            if (cSlot.nSize < cGame.CloneSize())
+            {
+                cSlot.nSize = cGame.CloneSize();
+                cSlot.pucBuffer.reset(new unsigned char[cSlot.nSize]);
+            }
+
+            cSlot.pcGame = cGame.CloneInto(cSlot.pucBuffer.get());
+
+            return cSlot.pcGame;
+        }
+
+        // Destroy the game held in a slot
+        void Release(int nSlot)                  { Release(m_vcSlots[nSlot]); }
+
+    private:
+        // Storage for one game
+        struct Slot
+        {
+            std::unique_ptr<unsigned char[]> pucBuffer {};
+            size_t nSize  {0};
+            Game  *pcGame {nullptr};
+        };
+
+        // Destroy the game held in a slot, keeping its storage
+        static void Release(Slot &cSlot)
+        {
+            if (cSlot.pcGame != nullptr)
+            {
+                cSlot.pcGame->~Game();
+                cSlot.pcGame = nullptr;
+            }
+        }
+
+        // The slots
+        std::vector<Slot> m_vcSlots;
+};
+
+#endif // GAMEARENA_H
@@ -20,26 +20,29 @@
 /** \file
  *
  * \brief The GameBoard class represents a game board for two players.  The
- * game board is a multi-dimensional vector, loaded with game pieces.
+ * game board is a flat, fixed-size array of game pieces, so that a board is
+ * copied as a single block of memory.
  *
  */
 
 #ifndef GAMEBOARD_H
 #define GAMEBOARD_H
 
-#include <chrono>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
-#include <random>
+#include <iterator>
 #include <string>
-#include <vector>
 
 #if defined(_WIN32)
 #include <windows.h>
 #endif
 
-#include "GameMove.h"
+#include "BoardMove.h"
 #include "GamePiece.h"
 #include "GameAIException.h"
+#include "Zobrist.h"
 
 class GameBoard
 {
@@ -47,7 +50,6 @@ class GameBoard
         // Construct a game board of size X & Y, and display characteristics
         GameBoard(int nX, int nY, int nNumberOfTypesOfPieces,
                   bool bDisplayGrid, bool bDisplayXCoordinates, bool bDisplayYCoordinates) :
-            m_vBoard(m_knMaxY, Row(m_knMaxX)),
             m_knX(nX),
             m_knY(nY),
             m_knNumberOfTypesOfPieces(nNumberOfTypesOfPieces),
@@ -73,10 +75,10 @@ class GameBoard
                 std::string sErrorMessage = "Number of game pieces " + std::to_string(m_knNumberOfTypesOfPieces) + " exceeds max number of game pieces " + std::to_string(m_knMaxNumberOfTypesOfPieces);
                 throw GameAIException(sErrorMessage);
             }
-        }
 
-        // Destructor
-        ~GameBoard() {}
+            // No square is in a piece list
+            std::fill(std::begin(m_anPieceListIndex), std::end(m_anPieceListIndex), m_knNotListed);
+        }
 
         // Evaluate location validity
         bool ValidLocation(int nX, int nY) const;
@@ -87,58 +89,70 @@ class GameBoard
         // Set a piece on the board
         bool SetPiece(int nX, int nY, const GamePiece &cGamePiece);
         // Move a piece on the board
-        bool MovePiece(const GameMove &cGameMove);
+        bool MovePiece(const BoardMove &cBoardMove);
         // Return the piece at the location coordinates
-        const GamePiece & Piece(int nX, int nY) const { return m_vBoard[nY][nX].Piece(); }
+        const GamePiece & Piece(int nX, int nY) const { return m_acBoard[Square(nX, nY)]; }
         // Evaluate locations on the board
         bool PositionOccupied(int nX, int nY) const;
         int  PositionOccupiedBy(int nX, int nY) const;
         bool PositionOccupiedByPlayer(int nX, int nY, int nPlayer) const;
         // Return the token for a board location
-        char Token(int nX, int nY) const { return m_vBoard[nY][nX].Token(); }
+        char Token(int nX, int nY) const { return m_acBoard[Square(nX, nY)].Token(); }
         // Return the player for a board location
-        char Player(int nX, int nY) const { return m_vBoard[nY][nX].Player(); }
+        char Player(int nX, int nY) const { return m_acBoard[Square(nX, nY)].Player(); }
         // Return the value of the piece
-        int PieceValue(int nX, int nY) const { return m_vBoard[nY][nX].Value();}
+        int PieceValue(int nX, int nY) const { return m_acBoard[Square(nX, nY)].Value();}
         // Return the general number of the piece
-        int PieceNumber(int nX, int nY) const { return m_vBoard[nY][nX].Number();}
+        int PieceNumber(int nX, int nY) const { return m_acBoard[Square(nX, nY)].Number();}
+
+        // Return the number of pieces a player has on the board
+        int  PieceCount(int nPlayer) const { return m_anPieceCount[nPlayer - 1]; }
+        // Return the square of a player's piece, for nIndex less than PieceCount()
+        int  PieceSquare(int nPlayer, int nIndex) const { return m_aanPieceList[nPlayer - 1][nIndex]; }
+        // Convert a square returned by PieceSquare() to coordinates
+        static int SquareX(int nSquare) { return nSquare % m_knMaxX; }
+        static int SquareY(int nSquare) { return nSquare / m_knMaxX; }
 
         // Initialize the Zobrist key
         void InitializeZobrist();
-        // Update the Zobrist key
+        // Update the Zobrist key for a piece, or with any other key
         void UpdateZobristKey(int nPX, int nPY, int nSX, int nSY);
+        void UpdateZobristKey(uint64_t uiKey) { m_uiZobristKey ^= uiKey; }
         // Return the Zobrist key
         uint64_t ZKey() const { return m_uiZobristKey; }
+        // Update the Zobrist key of the pawns alone
+        void UpdatePawnZobristKey(int nPX, int nPY, int nSX, int nSY);
+        // Return the Zobrist key of the pawns alone
+        uint64_t PawnZKey() const { return m_uiPawnZobristKey; }
 
         // Reverse token colors for players
-#if defined(_WIN32)
-        void ReverseColors() { int nColor = m_nPlayer1TokenColor; m_nPlayer1TokenColor = m_nPlayer2TokenColor; m_nPlayer2TokenColor = nColor; }
-#else
-        void ReverseColors() { std::string sColor = m_sPlayer1TokenColor; m_sPlayer1TokenColor = m_sPlayer2TokenColor; m_sPlayer2TokenColor = sColor; }
-#endif
+        void ReverseColors() { m_bReverseColors = !m_bReverseColors; }
 
         // Reverse Y-Coordinates of the board
         void ReverseY()      { m_bReverseY = true; }
 
-    protected:
-        // Vector of vectors to represent the board
-        typedef std::vector<GamePiece> Row;
-        typedef std::vector<Row>       Board;
-        Board m_vBoard;
-
     private:
         // Max X-coordinate for any game
         static const int m_knMaxX {8};
         // Max Y-coordinate for any game
         static const int m_knMaxY {8};
 
+        // Number of squares on the game board
+        static const int m_knNumberOfSquares {m_knMaxX * m_knMaxY};
+
+        // Convert coordinates to a square of the board array
+        static int Square(int nX, int nY) { return nX + (nY * m_knMaxX); }
+
+        // Array of squares to represent the board, row by row
+        std::array<GamePiece, m_knNumberOfSquares> m_acBoard;
+
         // Max X-coordinate for this game
         const int  m_knX;
         // Max Y-coordinate this game
         const int  m_knY;
 
         // Max number of types of pieces allowed
-        static const int m_knMaxNumberOfTypesOfPieces {12};
+        static const int m_knMaxNumberOfTypesOfPieces {Zobrist::m_knMaxNumberOfTypesOfPieces};
 
         // Number of types of pieces for this game
         const int m_knNumberOfTypesOfPieces;
@@ -149,31 +163,41 @@ class GameBoard
         const bool m_kbDisplayYCoordinates;
 
         // Used to convert alpha X coordinates to integer values for internal representation
-        const char m_kcXCoordinate {'a'};
+        static const char m_kcXCoordinate {'a'};
 
         // Used to provide color for game pieces
 #if defined(_WIN32)
-        int m_nPlayer1TokenColor      {FOREGROUND_INTENSITY | FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE}; // White
-        int m_nPlayer2TokenColor      {FOREGROUND_INTENSITY | FOREGROUND_RED};
-        const int m_knResetTokenColor {FOREGROUND_INTENSITY | FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE}; // White
+        static const int m_knPlayer1TokenColor {FOREGROUND_INTENSITY | FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE}; // White
+        static const int m_knPlayer2TokenColor {FOREGROUND_INTENSITY | FOREGROUND_RED};
+        static const int m_knResetTokenColor   {FOREGROUND_INTENSITY | FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE}; // White
 #else
-        std::string m_sPlayer1TokenColor       {"\033[1;37m"}; // White
-        std::string m_sPlayer2TokenColor       {"\033[1;31m"}; // Red
-        const std::string m_ksResetTokenColor  {"\033[0m"};    // Reset
+        static const char * const m_kszPlayer1TokenColor; // White
+        static const char * const m_kszPlayer2TokenColor; // Red
+        static const char * const m_kszResetTokenColor;   // Reset
 #endif
 
+        // Flag for swapping the token colors of the players
+        bool m_bReverseColors = false;
+
         // Flag for reversing the Y-Coordinates
         bool m_bReverseY = false;
 
-        // Number of squares on the game board
-        static const int m_knNumberOfSquares {m_knMaxX * m_knMaxY};
+        // Add and remove a square from the piece list of the player occupying it
+        void AddToPieceList(int nX, int nY);
+        void RemoveFromPieceList(int nX, int nY);
 
-        // Array representing the number of types of positions on each square, assigned to a random number
-        // used to create the Zobrist hash
-        uint64_t m_auiZobrist[m_knMaxNumberOfTypesOfPieces][m_knMaxX * m_knMaxY] {{}};
+        // Piece lists: the squares holding each player's pieces, and the
+        // position of each square within its list
+        static const int8_t m_knNotListed {-1};
+        uint8_t m_aanPieceList[2][m_knNumberOfSquares] {{}};
+        int     m_anPieceCount[2] {0, 0};
+        int8_t  m_anPieceListIndex[m_knNumberOfSquares];
 
         // The Zobrist hash, representing the position of the board
-        uint64_t m_uiZobristKey;
+        uint64_t m_uiZobristKey {0};
+
+        // The Zobrist hash of the pawns alone, representing pawn structure
+        uint64_t m_uiPawnZobristKey {0};
 };
 
 #endif // GAMEBOARD_H
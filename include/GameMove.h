@@ -113,6 +113,12 @@ class GameMove
         char ToInputX() const   { return m_cToX; }
         char ToInputY() const   { return m_cToY; }
 
+        // Set and return the promotion, a game-defined piece index where 0
+        // means none, and the character it is entered and announced as
+        void SetPromotion(int nPromotion, char cPromotion = '\0') { m_nPromotion = nPromotion; m_cPromotion = cPromotion; }
+        int  Promotion() const      { return m_nPromotion; }
+        char PromotionInput() const { return m_cPromotion; }
+
         // Set and return whether the Y-coordinate is used
         void SetUseY(bool b)   { m_bUseY = b; }
         bool UseY() const      { return m_bUseY; }
@@ -215,6 +221,9 @@ class GameMove
         static const char m_kcXOffset {'a'};
         static const char m_kcYOffset {'1'};
 
+        // Announce a Y-coordinate, as its row number past the ninth row
+        static std::string AnnounceY(int nY, char cY);
+
         // Player's number
         int m_nPlayerNumber {-1};
 
@@ -235,6 +244,10 @@ class GameMove
         int  m_nToY {-1};
         char m_cToY {'?'};
 
+        // Game move promotion - none
+        int  m_nPromotion {0};
+        char m_cPromotion {'\0'};
+
         // Whether the Y-coordinates are used
         bool m_bUseY {true};
 
@@ -20,92 +20,129 @@
 /** \file
  *
  * \brief The GamePiece class represents a game piece.
+ *
+ * A piece is packed into one byte: the index of its type, the player, and
+ * the has-moved flag.  The token, value, and number of a piece are looked
+ * up from its type in a constant table of every type of piece the games
+ * use, where the number may differ between the two players.  Setting a
+ * piece finds its type by token; a debug build asserts that the value and
+ * number given match the type's.
  */
 
 #ifndef GAMEPIECE_H
 #define GAMEPIECE_H
 
+#include <cassert>
+#include <cstdint>
+
 class GamePiece
 {
     public:
         // Constructor with no arguments - blank or clear piece
-        GamePiece() :
-            m_cToken(m_kcNoToken),
-            m_nPlayer(m_knNoValue),
-            m_nValue(m_knNoValue),
-            m_nNumber(m_knNoValue)
-        {}
+        GamePiece() {}
 
         // Constructor with token and player number
-        GamePiece(char cToken, int nPlayer) :
-            m_cToken(cToken),
-            m_nPlayer(nPlayer),
-            m_nValue(m_knNoValue),
-            m_nNumber(m_knNoValue)
-        {}
+        GamePiece(char cToken, int nPlayer)
+            { Set(cToken, nPlayer); }
 
         // Constructor with token, player number, and value
-        GamePiece(char cToken, int nPlayer, int nValue) :
-            m_cToken(cToken),
-            m_nPlayer(nPlayer),
-            m_nValue(nValue),
-            m_nNumber(m_knNoValue)
-        {}
+        GamePiece(char cToken, int nPlayer, int nValue)
+            { Set(cToken, nPlayer, nValue); }
 
         // Constructor with token, player number, value, and number
-        GamePiece(char cToken, int nPlayer, int nValue, int nNumber) :
-            m_cToken(cToken),
-            m_nPlayer(nPlayer),
-            m_nValue(nValue),
-            m_nNumber(nNumber)
-        {}
-
-        // Deconstructor
-        ~GamePiece() {}
+        GamePiece(char cToken, int nPlayer, int nValue, int nNumber)
+            { Set(cToken, nPlayer, nValue, nNumber); }
 
         // Return token
-        char Token() const    { return m_cToken; }
+        char Token() const    { return m_kastTypes[Type()].cToken; }
         // Return player number
-        int  Player() const   { return m_nPlayer; }
+        int  Player() const   { return ((m_nBits >> m_knPlayerShift) & m_knPlayerMask) - m_knPlayerBias; }
         // Return value
-        int  Value() const    { return m_nValue; }
+        int  Value() const    { return m_kastTypes[Type()].nValue; }
         // Return general number
-        int  Number() const    { return m_nNumber; }
+        int  Number() const    { return m_kastTypes[Type()].anNumber[Player() == 2]; }
         // Return piece
         const GamePiece & Piece() const { return *this; }
         // Evaluate whether piece is a game pice (vs a non-game piece or clear)
-        bool IsAGamePiece() const { return m_cToken != m_kcNoToken; }
+        bool IsAGamePiece() const { return Type() != m_knNoType; }
 
         // Set game piece
         void Set(char cToken, int nPlayer)
-            { m_cToken = cToken; m_nPlayer = nPlayer; m_nValue = m_knNoValue; m_nNumber = m_knNoValue; }
+            { Set(cToken, nPlayer, m_knNoValue, m_knNoValue); }
         void Set(char cToken, int nPlayer, int nValue)
-            { m_cToken = cToken; m_nPlayer = nPlayer; m_nValue = nValue; m_nNumber = m_knNoValue; }
+            { Set(cToken, nPlayer, nValue, m_knNoValue); }
         void Set(char cToken, int nPlayer, int nValue, int nNumber)
-            { m_cToken = cToken; m_nPlayer = nPlayer; m_nValue = nValue; m_nNumber = nNumber; }
+        {
+            m_nBits = (m_nBits & m_knMovedFlag) | TypeOf(cToken) | (((nPlayer + m_knPlayerBias) & m_knPlayerMask) << m_knPlayerShift);
+            assert(((cToken == m_kcNoToken) || IsAGamePiece()) && "GamePiece::Set() token is not a type of piece");
+            assert((nValue == Value()) && (nNumber == Number()) && "GamePiece::Set() value or number does not match the type of piece");
+            (void)nValue;
+            (void)nNumber;
+        }
+
+        // Set the type and player of another game piece, keeping this piece's moved flag
+        void Assign(const GamePiece &cGamePiece)
+            { m_nBits = (m_nBits & m_knMovedFlag) | (cGamePiece.m_nBits & ~m_knMovedFlag); }
 
         // Clear a game piece
-        void Clear()                       { m_cToken = m_kcNoToken; m_nPlayer = m_knNoValue; m_nValue = m_knNoValue; m_bHasMoved = false; }
+        void Clear()                       { m_nBits = 0; }
 
         // Flag for piece movement
-        bool HasMoved() const              { return m_bHasMoved; }
-        void SetMoved(bool bMoved=true)    { m_bHasMoved = bMoved; }
+        bool HasMoved() const              { return (m_nBits & m_knMovedFlag) != 0; }
+        void SetMoved(bool bMoved=true)    { if (bMoved) m_nBits |= m_knMovedFlag; else m_nBits &= ~m_knMovedFlag; }
 
     private:
         // Constants for clear pieces
         static const char m_kcNoToken {32};
         static const int  m_knNoValue {-1};
 
-        // Board representation of a piece, for example 'X' and 'O' for tic-tac-toe
-        char m_cToken;
-        // Player number
-        int  m_nPlayer;
-        // Value number
-        int  m_nValue;
-        // General number
-        int m_nNumber;
-        // Flag for whether the piece has moved
-        bool m_bHasMoved {false};
+        // A type of piece: its board representation, for example 'X' and 'O'
+        // for tic-tac-toe, its value, and its general number for each player
+        struct PieceType
+        {
+            char cToken;
+            int  nValue;
+            int  anNumber[2];
+        };
+
+        // Table of piece types; the first type is the clear piece
+        static const int m_knNumberOfTypes {13};
+        static const int m_knNoType {0};
+        static constexpr PieceType m_kastTypes[m_knNumberOfTypes]
+        {
+            {m_kcNoToken, m_knNoValue, {m_knNoValue, m_knNoValue}},
+            // Tic-tac-toe, Gomoku, Connect Four, and Reversi tokens
+            {'X', m_knNoValue, {m_knNoValue, m_knNoValue}},
+            {'O', m_knNoValue, {m_knNoValue, m_knNoValue}},
+            {'1', m_knNoValue, {m_knNoValue, m_knNoValue}},
+            {'2', m_knNoValue, {m_knNoValue, m_knNoValue}},
+            {'D', m_knNoValue, {m_knNoValue, m_knNoValue}},
+            {'L', m_knNoValue, {m_knNoValue, m_knNoValue}},
+            // Chess pieces, with the values and the White and Black indices of ChessGame
+            {'P', 1, {0,  6}},
+            {'R', 5, {1,  7}},
+            {'N', 3, {2,  8}},
+            {'B', 3, {3,  9}},
+            {'Q', 9, {4, 10}},
+            {'K', 4, {5, 11}}
+        };
+
+        // Return the index of the type of piece with a token, or the clear piece if none
+        static constexpr int TypeOf(char cToken, int nType = m_knNoType + 1)
+            { return (nType == m_knNumberOfTypes) ? m_knNoType : (m_kastTypes[nType].cToken == cToken) ? nType : TypeOf(cToken, nType + 1); }
+
+        // Layout of the byte: the type in the low bits, then the player number
+        // plus a bias, so that the clear player -1 is zero, and the moved flag
+        static const int m_knTypeMask    {0x0F};
+        static const int m_knPlayerShift {4};
+        static const int m_knPlayerBias  {1};
+        static const int m_knPlayerMask  {0x03};
+        static const int m_knMovedFlag   {0x40};
+
+        int  Type() const                  { return m_nBits & m_knTypeMask; }
+
+        // Type, player number, and moved flag
+        uint8_t m_nBits {0};
 };
 
 #endif // GAMEPIECE_H
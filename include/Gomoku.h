@@ -0,0 +1,49 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The Gomoku class represents a Gomoku game, on a 15x15 board.
+ *
+ */
+
+#ifndef GOMOKU_H
+#define GOMOKU_H
+
+#include "GomokuGame.h"
+
+class Gomoku : public GomokuGame<LinearLines<15, 15, 5>>
+{
+    public:
+        // Constructor
+        explicit Gomoku(GameType ecGameType) : GomokuGame(ecGameType) {}
+        // Destructor
+        ~Gomoku() {}
+
+        // Clone the current game
+        virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new Gomoku(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) Gomoku(*this); }
+        virtual size_t CloneSize() const override { return sizeof(Gomoku); }
+
+        // Return the title of the game
+        virtual std::string Title() const override { return "Gomoku"; }
+};
+
+#endif // GOMOKU_H
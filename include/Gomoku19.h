@@ -0,0 +1,49 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The Gomoku19 class represents a Gomoku game, on a 19x19 board.
+ *
+ */
+
+#ifndef GOMOKU19_H
+#define GOMOKU19_H
+
+#include "GomokuGame.h"
+
+class Gomoku19 : public GomokuGame<LinearLines<19, 19, 5>>
+{
+    public:
+        // Constructor
+        explicit Gomoku19(GameType ecGameType) : GomokuGame(ecGameType) {}
+        // Destructor
+        ~Gomoku19() {}
+
+        // Clone the current game
+        virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new Gomoku19(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) Gomoku19(*this); }
+        virtual size_t CloneSize() const override { return sizeof(Gomoku19); }
+
+        // Return the title of the game
+        virtual std::string Title() const override { return "Gomoku 19x19"; }
+};
+
+#endif // GOMOKU19_H
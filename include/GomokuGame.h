@@ -0,0 +1,64 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The GomokuGame class template represents a game of Gomoku, five
+ * tokens in a row on a board larger than the GameBoard array of pieces.
+ *
+ * The template parameter is a LinearLines giving the board size, so the
+ * game is LinearGame's, with its lines and evaluation, on a StoneBoard.
+ * Moves are generated only next to and one square beyond the tokens
+ * already placed, from the bitboards of the stones, as a move far from
+ * every token is rarely worth searching.  Before the minimax search,
+ * the AI looks for a win by a sequence of fours.  The member functions are
+ * defined in GomokuGame.cpp, which instantiates GomokuGame for each board.
+ *
+ */
+
+#ifndef GOMOKUGAME_H
+#define GOMOKUGAME_H
+
+#include "LinearGame.h"
+#include "StoneBoard.h"
+
+template <class Lines>
+class GomokuGame : public LinearGame<Lines, StoneBoard>
+{
+    public:
+        // Construct a GomokuGame
+        explicit GomokuGame(GameType ecGameType) : LinearGame<Lines, StoneBoard>(ecGameType, 'X', 'O', 8, true, true, true, true) {}
+
+        // Destructor
+        virtual ~GomokuGame() {}
+
+        // Fill a list with the valid moves worth searching
+        virtual void GenerateBoardMoves(int nPlayer, MoveList &cMoveList) override;
+        // Generate a move that wins by a sequence of fours, if there is one
+        virtual bool ThreatMove(int nPlayer, GameMove &cGameMove) override;
+
+        // Return the description of the game
+        virtual std::string Description() const override { return "Five or more tokens in a row win."; }
+
+    private:
+        // Add a move for each square of a set
+        static void AddMoves(StoneBoard::StoneBitboard cSquares, MoveList &cMoveList);
+};
+
+#endif // GOMOKUGAME_H
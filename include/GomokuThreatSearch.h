@@ -0,0 +1,409 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The GomokuThreatSearch class template finds a move that wins a
+ * game of tokens in a row by a sequence of fours.
+ *
+ * A four is a line of the board, as long as a winning line, holding all
+ * but one of its squares with the attacker's tokens and none with the
+ * defender's; the empty square is a gain, where the attacker completes the
+ * line next.  The defender must take every gain at once, so after each four
+ * there is one reply to search: the block.  The attacker wins when a four
+ * leaves two gains, or when a line of fours ends in one.
+ *
+ * A block that makes a four for the defender must be answered by the
+ * attacker taking its gain, and so the attacker continues only if that
+ * take is itself a four.  Lines of threats that pass through threes, which
+ * the defender has more than one way to answer, are not searched; those
+ * are left to the minimax search.
+ *
+ * The search works on a copy of the board kept as one player number per
+ * square, as LinearGame keeps it, and is limited in the number of fours in
+ * a line and the number of positions searched.
+ *
+ */
+
+#ifndef GOMOKUTHREATSEARCH_H
+#define GOMOKUTHREATSEARCH_H
+
+#include <cstdint>
+#include <cstring>
+
+template <class Lines>
+class GomokuThreatSearch
+{
+    public:
+        // Most fours played by the attacker in a line of threats
+        static const int m_knMaxDepth {10};
+        // Most positions searched for one move
+        static const int m_knMaxNodes {200000};
+
+        // Find a move that wins by a sequence of fours
+        bool WinningMove(const uint8_t *pnSquarePlayers, int nPlayer, int &nSquare);
+
+        // Return the number of positions searched
+        uint64_t Nodes() const { return m_uiNodes; }
+
+    private:
+        // Number of tokens in a winning line
+        static const int m_knInARow {Lines::m_knInARow};
+        // Most gains through one square
+        static const int m_knMaxGains {Lines::m_knDirections * Lines::m_knInARow};
+
+        // Play a square for the attacker and return whether it wins by fours
+        bool Attack(int nAttacker, int nSquare, int nDepth);
+
+        // Return whether a token placed on a square completes a winning line
+        bool Completes(int nPlayer, int nSquare) const;
+        // Collect the gains of the lines through a square
+        int  Gains(int nPlayer, int nSquare, int anGains[m_knMaxGains]) const;
+        // Collect the gains of every line of the board, stopping after a number of them
+        int  AllGains(int nPlayer, int anGains[], int nMax) const;
+        // Collect the empty squares that make a four
+        int  Fours(int nPlayer, int anFours[Lines::m_knSquares]) const;
+
+        // The player on each square
+        uint8_t  m_anSquarePlayers[Lines::m_knSquares] {};
+
+        // Number of positions searched
+        uint64_t m_uiNodes {0};
+};
+
+/**
+  * Find a winning move.
+  *
+  * Complete a line if the player can.  Otherwise, if the opponent has a
+  * four, take its gain, and if two, give up.  Then search each four the
+  * player can make for a win.
+  *
+  * \param pnSquarePlayers The player on each square
+  * \param nPlayer         The player to move
+  * \param nSquare         The winning square, if one is found
+  *
+  * \return True, if a winning move is found.  False otherwise.
+  */
+
+template <class Lines>
+inline bool GomokuThreatSearch<Lines>::WinningMove(const uint8_t *pnSquarePlayers, int nPlayer, int &nSquare)
+{
+    std::memcpy(m_anSquarePlayers, pnSquarePlayers, sizeof(m_anSquarePlayers));
+    m_uiNodes = 0;
+
+    int anGains[2];
+
+    if (AllGains(nPlayer, anGains, 1) > 0)
+    {
+        nSquare = anGains[0];
+        return true;
+    }
+
+    const int knOpponentGains = AllGains(3 - nPlayer, anGains, 2);
+    if (knOpponentGains > 1)
+        return false;
+    if (knOpponentGains == 1)
+    {
+        if (!Attack(nPlayer, anGains[0], m_knMaxDepth))
+            return false;
+
+        nSquare = anGains[0];
+        return true;
+    }
+
+    int anFours[Lines::m_knSquares];
+    const int knFours = Fours(nPlayer, anFours);
+
+    for (int iii = 0; iii < knFours; ++iii)
+    {
+        if (Attack(nPlayer, anFours[iii], m_knMaxDepth))
+        {
+            nSquare = anFours[iii];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+  * Play a square for the attacker and search the fours that follow.
+  *
+  * The square must make a four.  Two gains win.  One gain is blocked, and
+  * the attacker goes on from the block, taking the gain of a four the block
+  * makes, or else trying each four the attacker can make.
+  *
+  * \param nAttacker The attacker
+  * \param nSquare   The square played
+  * \param nDepth    The number of fours left to play
+  *
+  * \return True, if the attacker wins.  False otherwise.
+  */
+
+template <class Lines>
+inline bool GomokuThreatSearch<Lines>::Attack(int nAttacker, int nSquare, int nDepth)
+{
+    if (++m_uiNodes > static_cast<uint64_t>(m_knMaxNodes))
+        return false;
+
+    const int knDefender = 3 - nAttacker;
+    bool bWin = false;
+
+    m_anSquarePlayers[nSquare] = nAttacker;
+
+    int anGains[m_knMaxGains];
+    const int knGains = Gains(nAttacker, nSquare, anGains);
+
+    if (knGains >= 2)
+    {
+        bWin = true;
+    }
+    else if ((knGains == 1) && (nDepth > 1))
+    {
+        // The defender blocks the gain, which must not win for the defender
+        const int knBlock = anGains[0];
+        m_anSquarePlayers[knBlock] = knDefender;
+
+        if (!Completes(knDefender, knBlock))
+        {
+            int anDefenderGains[m_knMaxGains];
+            const int knDefenderGains = Gains(knDefender, knBlock, anDefenderGains);
+
+            if (knDefenderGains == 1)
+            {
+                bWin = Attack(nAttacker, anDefenderGains[0], nDepth - 1);
+            }
+            else if (knDefenderGains == 0)
+            {
+                int anFours[Lines::m_knSquares];
+                const int knFours = Fours(nAttacker, anFours);
+
+                for (int iii = 0; (iii < knFours) && !bWin; ++iii)
+                    bWin = Attack(nAttacker, anFours[iii], nDepth - 1);
+            }
+        }
+
+        m_anSquarePlayers[knBlock] = 0;
+    }
+
+    m_anSquarePlayers[nSquare] = 0;
+
+    return bWin;
+}
+
+/**
+  * Return whether a token on a square completes a winning line.
+  *
+  * \param nPlayer The player of the token
+  * \param nSquare The square
+  *
+  * \return True, if the token is part of a line as long as a winning line.
+  */
+
+template <class Lines>
+inline bool GomokuThreatSearch<Lines>::Completes(int nPlayer, int nSquare) const
+{
+    for (int nDirection = 0; nDirection < Lines::m_knDirections; ++nDirection)
+    {
+        const int knStep = Lines::Step(nDirection);
+        int nCount = 1;
+
+        for (int iii = 1; (iii <= Lines::Reach(nSquare, nDirection, false)) && (m_anSquarePlayers[nSquare - (iii * knStep)] == nPlayer); ++iii)
+            ++nCount;
+        for (int iii = 1; (iii <= Lines::Reach(nSquare, nDirection, true)) && (m_anSquarePlayers[nSquare + (iii * knStep)] == nPlayer); ++iii)
+            ++nCount;
+
+        if (nCount >= m_knInARow)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+  * Collect the gains of the lines through a square.
+  *
+  * \param nPlayer The player
+  * \param nSquare The square
+  * \param anGains The gains, each once
+  *
+  * \return The number of gains.
+  */
+
+template <class Lines>
+inline int GomokuThreatSearch<Lines>::Gains(int nPlayer, int nSquare, int anGains[m_knMaxGains]) const
+{
+    int nGains = 0;
+
+    for (int nDirection = 0; nDirection < Lines::m_knDirections; ++nDirection)
+    {
+        const int knStep    = Lines::Step(nDirection);
+        const int knBack    = Lines::Reach(nSquare, nDirection, false);
+        const int knForward = Lines::Reach(nSquare, nDirection, true);
+
+        // Each line through the square, by the number of squares it starts behind it
+        for (int nBehind = 0; nBehind < m_knInARow; ++nBehind)
+        {
+            if ((nBehind > knBack) || (m_knInARow - 1 - nBehind > knForward))
+                continue;
+
+            const int knStart = nSquare - (nBehind * knStep);
+            int nPlayerTokens = 0;
+            int nEmpty = -1;
+
+            for (int iii = 0; iii < m_knInARow; ++iii)
+            {
+                const int knPlayer = m_anSquarePlayers[knStart + (iii * knStep)];
+
+                if (knPlayer == nPlayer)
+                    ++nPlayerTokens;
+                else if (knPlayer == 0)
+                    nEmpty = knStart + (iii * knStep);
+            }
+
+            if ((nPlayerTokens == m_knInARow - 1) && (nEmpty >= 0))
+            {
+                int jjj = 0;
+                while ((jjj < nGains) && (anGains[jjj] != nEmpty))
+                    ++jjj;
+                if (jjj == nGains)
+                    anGains[nGains++] = nEmpty;
+            }
+        }
+    }
+
+    return nGains;
+}
+
+/**
+  * Collect the gains of every line of the board.
+  *
+  * \param nPlayer The player
+  * \param anGains The gains, each once
+  * \param nMax    The number of gains to stop after
+  *
+  * \return The number of gains, up to nMax.
+  */
+
+template <class Lines>
+inline int GomokuThreatSearch<Lines>::AllGains(int nPlayer, int anGains[], int nMax) const
+{
+    int nGains = 0;
+
+    for (int nDirection = 0; nDirection < Lines::m_knDirections; ++nDirection)
+    {
+        const int knStep = Lines::Step(nDirection);
+
+        for (int nLine = Lines::FirstLine(nDirection); nLine < Lines::FirstLine(nDirection) + Lines::Lines(nDirection); ++nLine)
+        {
+            const int knStart = Lines::LineStart(nLine);
+            int nPlayerTokens = 0;
+            int nEmpty = -1;
+
+            for (int iii = 0; iii < m_knInARow; ++iii)
+            {
+                const int knPlayer = m_anSquarePlayers[knStart + (iii * knStep)];
+
+                if (knPlayer == nPlayer)
+                    ++nPlayerTokens;
+                else if (knPlayer == 0)
+                    nEmpty = knStart + (iii * knStep);
+            }
+
+            if ((nPlayerTokens == m_knInARow - 1) && (nEmpty >= 0))
+            {
+                int jjj = 0;
+                while ((jjj < nGains) && (anGains[jjj] != nEmpty))
+                    ++jjj;
+                if (jjj == nGains)
+                {
+                    anGains[nGains++] = nEmpty;
+                    if (nGains == nMax)
+                        return nGains;
+                }
+            }
+        }
+    }
+
+    return nGains;
+}
+
+/**
+  * Collect the empty squares that make a four.
+  *
+  * A line holding all but two of its squares with the player's tokens, and
+  * none with the opponent's, becomes a four with either empty square.
+  *
+  * \param nPlayer The player
+  * \param anFours The squares, each once
+  *
+  * \return The number of squares.
+  */
+
+template <class Lines>
+inline int GomokuThreatSearch<Lines>::Fours(int nPlayer, int anFours[Lines::m_knSquares]) const
+{
+    bool abFound[Lines::m_knSquares] {};
+    int nFours = 0;
+
+    for (int nDirection = 0; nDirection < Lines::m_knDirections; ++nDirection)
+    {
+        const int knStep = Lines::Step(nDirection);
+
+        for (int nLine = Lines::FirstLine(nDirection); nLine < Lines::FirstLine(nDirection) + Lines::Lines(nDirection); ++nLine)
+        {
+            const int knStart = Lines::LineStart(nLine);
+            int nPlayerTokens = 0;
+            int nEmpties = 0;
+            int anEmpty[2];
+
+            for (int iii = 0; (iii < m_knInARow) && (nEmpties <= 2); ++iii)
+            {
+                const int knPlayer = m_anSquarePlayers[knStart + (iii * knStep)];
+
+                if (knPlayer == nPlayer)
+                {
+                    ++nPlayerTokens;
+                }
+                else if (knPlayer == 0)
+                {
+                    if (nEmpties < 2)
+                        anEmpty[nEmpties] = knStart + (iii * knStep);
+                    ++nEmpties;
+                }
+            }
+
+            if ((nPlayerTokens == m_knInARow - 2) && (nEmpties == 2))
+            {
+                for (int nEmpty : anEmpty)
+                {
+                    if (!abFound[nEmpty])
+                    {
+                        abFound[nEmpty] = true;
+                        anFours[nFours++] = nEmpty;
+                    }
+                }
+            }
+        }
+    }
+
+    return nFours;
+}
+
+#endif // GOMOKUTHREATSEARCH_H
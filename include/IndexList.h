@@ -0,0 +1,55 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The IndexList class template is a compile-time list of indices
+ * 0 .. N-1, used to build tables as constant expressions.
+ *
+ * A C++11 constexpr function cannot loop, so a table is built by expanding
+ * a function of the index over a list of indices, as
+ *
+ *     template <int... anIndices>
+ *     static constexpr std::array<int, sizeof...(anIndices)> MakeTable(IndexList<anIndices...>)
+ *         { return {{ Entry(anIndices)... }}; }
+ *
+ * called with MakeIndexList<N>::Type().  The list is built in logarithmic
+ * depth, so that long tables do not exceed the compiler's limit on nested
+ * templates.
+ *
+ */
+
+#ifndef INDEXLIST_H
+#define INDEXLIST_H
+
+template <int... anIndices> struct IndexList {};
+
+// Join two lists, the second counting on from the end of the first
+template <typename First, typename Second> struct JoinIndexLists;
+template <int... anFirst, int... anSecond>
+struct JoinIndexLists<IndexList<anFirst...>, IndexList<anSecond...>>
+    { typedef IndexList<anFirst..., (static_cast<int>(sizeof...(anFirst)) + anSecond)...> Type; };
+
+// The list of indices 0 .. N-1
+template <int N, typename = void> struct MakeIndexList
+    { typedef typename JoinIndexLists<typename MakeIndexList<N / 2>::Type, typename MakeIndexList<N - (N / 2)>::Type>::Type Type; };
+template <typename Dummy> struct MakeIndexList<0, Dummy> { typedef IndexList<> Type; };
+template <typename Dummy> struct MakeIndexList<1, Dummy> { typedef IndexList<0> Type; };
+
+#endif // INDEXLIST_H
@@ -23,26 +23,42 @@
  * two-dimensonal space, navigated with X and Y coordinates, and using one type
  * of token per player.
  *
+ * The template parameters are a LinearLines giving the board size and the
+ * number of tokens in a row that win, so that each game gets its lines of
+ * tokens counted and checked with the bounds folded into constants, and the
+ * type of the board, a StoneBoard for a board larger than a GameBoard.  The
+ * lines are followed on a copy of the board kept as one player number per
+ * square, rather than through the board.
+ *
+ * The position may be hashed under each symmetry of the board that leaves
+ * the game unchanged, so that symmetric positions share a canonical key.
+ *
  */
 
 #ifndef LINEARGAME_H
 #define LINEARGAME_H
 
+#include <chrono>
 #include <climits>
+#include <cstdint>
 #include <iostream>
+#include <random>
 
 #include "BoardGame.h"
+#include "LinearLines.h"
+#include "SymmetricZobrist.h"
 
-class LinearGame : public BoardGame
+template <class Lines, class Board = GameBoard>
+class LinearGame : public BoardGame<Board>
 {
     public:
         // Construct a LinearGame
-        LinearGame(GameType ecGameType, int nX, int nY, char cToken1, char cToken2, int nInARow, bool bUseY, bool bDisplayGrid, bool bDisplayXCoordinates, bool bDisplayYCoordinates) :
-            BoardGame(ecGameType, nX, nY, 2, bDisplayGrid, bDisplayXCoordinates, bDisplayYCoordinates),
+        LinearGame(GameType ecGameType, char cToken1, char cToken2, int nSymmetries, bool bUseY, bool bDisplayGrid, bool bDisplayXCoordinates, bool bDisplayYCoordinates) :
+            BoardGame<Board>(ecGameType, Lines::m_knX, Lines::m_knY, 2, bDisplayGrid, bDisplayXCoordinates, bDisplayYCoordinates),
             m_kcToken1(cToken1),
             m_kcToken2(cToken2),
-            m_knTokensInARowWin(nInARow),
-            m_bUseY(bUseY)
+            m_bUseY(bUseY),
+            m_cSymmetricZobrist(Lines::m_knX, Lines::m_knY, nSymmetries)
             {  SetTokens(); }
 
         // Destructor
@@ -53,27 +69,38 @@ class LinearGame : public BoardGame
         // Provide a preferred move
         virtual int  PreferredMove(const GameMove &cGameMove) const override;
         // Apply the move to the game
-        virtual bool ApplyMove(int nPlayer, GameMove &cGameMove) override;
+        virtual bool ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
+        // Apply a move generated by the game without validating it
+        virtual bool ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
         // Announce the move made
         virtual std::string AnnounceMove(int nPlayer, const GameMove &cGameMove) const override;
         // Evaluate the game state from the perspective of the nPlayer
         virtual int  EvaluateGameState(int nPlayer) override;
         // Check to see if the game has ended
         virtual bool GameEnded(int nPlayer) override;
+        // Check to see if the game has ended and, if not, fill a list with the valid moves
+        virtual bool GameEndedWithMoves(int nPlayer, MoveList &cMoveList) override;
+        // Return a key shared by the position and every position symmetric to it
+        virtual bool CanonicalKey(uint64_t &uiKey) const override { uiKey = m_cSymmetricZobrist.Key(); return m_cSymmetricZobrist.Symmetries() > 0; }
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const = 0;
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const = 0;
+        virtual size_t CloneSize() const = 0;
 
     protected:
         // Set the tokens to be used for clear and both players
         void SetTokens() { m_acTokens[1] = m_kcToken1; m_acTokens[2] = m_kcToken2; }
 
-        // Check to see if a players tokens are connected linearly
-        bool CheckOrthogonal(int nPlayer, int nConnect);
-        int  CheckHorizontal(int nPlayer, int y, int x) const;
-        int  CheckVertical(int nPlayer, int y, int x) const;
-        bool CheckDiagonal(int nPlayer, int nConnect);
-        int  CheckDiagonalUpperLeftLowerRight(int nPlayer, int y, int x) const;
-        int  CheckDiagonalUpperRightLowerLeft(int nPlayer, int y, int x) const;
+        // Check the whole board to see if a player has won
+        bool FullScanEnded();
+
+        // Return the outcome of a win by a line in a direction
+        static GameOutcome LineOutcome(int nDirection);
+        // Check to see if a player's tokens fill a winning line in a direction
+        bool CheckLines(int nPlayer, int nDirection) const;
+        // Count a player's contiguous tokens from a square to the edge of the board
+        int  CountDirection(int nPlayer, int nSquare, int nStep, int nReach) const;
 
         // Player 1's token
         const char m_kcToken1;
@@ -81,25 +108,46 @@ class LinearGame : public BoardGame
         const char m_kcToken2;
 
         // For games that require tokens in a row
-        const int m_knTokensInARowWin;
+        static constexpr int m_knTokensInARowWin {Lines::m_knInARow};
 
         // Use of the Y-Coordinate
         const int m_bUseY;
 
+        // Number of moves made when the board was last found to have no winning line
+        int m_nNoWinnerAtMove {0};
+
+        // The player on each square, for games that require tokens in a row
+        uint8_t m_anSquarePlayers[Lines::m_knSquares] {};
+
+        // Direction of the first line through the last token placed that is
+        // long enough to win, or -1 if none is
+        int m_nWinningDirection {-1};
+
+        // Zobrist keys of the position under the symmetries of the board
+        // that do not change the game, if the game keeps them
+        SymmetricZobrist m_cSymmetricZobrist;
+
         // Number of tokens
         static const int m_knTokens {3};
         // Array used to hold tokens
         char m_acTokens[m_knTokens];
 
-        // Struct used to evaluate the game state
+        // Struct used to evaluate the game state: the number of lines of
+        // connected tokens at least one, two, three, and four long
         struct SequenceCounts {
             int nCount1 {0};
             int nCount2 {0};
             int nCount3 {0};
-        } m_stMyCounts, m_stOpponentCounts;
+            int nCount4 {0};
+        };
+
+        // Sequence counts per player, kept up to date as tokens are placed
+        SequenceCounts m_astSequenceCounts[m_knTokens] {};
 
-        // Count the number and length of connected tokens per player
-        void CountSequence(int nSequence, SequenceCounts &stSequenceCounts);
+        // Update the sequence counts for a token placed on a location
+        void CountPlacedToken(int nPlayer, int nX, int nY);
+        // Add or remove a line of connected tokens from the sequence counts
+        static void CountSequence(int nSequence, int nSign, SequenceCounts &stSequenceCounts);
 };
 
 #endif // LINEARGAME_H
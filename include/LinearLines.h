@@ -0,0 +1,154 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The LinearLines class template holds the board size of a linear
+ * game, the number of tokens in a row that win it, and the lines of its
+ * board, as compile-time constants.
+ *
+ * LinearGame takes a LinearLines as its template parameter, so each game
+ * gets its lines of tokens counted and checked with the board size folded
+ * into constants.  Squares are numbered along the X-coordinate first.
+ * Lines run in four directions: horizontal, vertical, upper left to lower
+ * right, and upper right to lower left.
+ *
+ * Two tables are built by the compiler: the number of squares from each
+ * square to the edge of the board, forward and back along each direction,
+ * so that a line is followed without checking each square is on the board;
+ * and the first square of every winning line, direction by direction.
+ *
+ */
+
+#ifndef LINEARLINES_H
+#define LINEARLINES_H
+
+#include <array>
+#include <cstdint>
+
+#include "IndexList.h"
+
+template <int nX, int nY, int nInARow>
+class LinearLines
+{
+    public:
+        // Board dimensions, and the number of tokens in a row that win
+        static constexpr int m_knX       {nX};
+        static constexpr int m_knY       {nY};
+        static constexpr int m_knInARow  {nInARow};
+        static constexpr int m_knSquares {nX * nY};
+
+        // Number of directions a line runs in
+        static constexpr int m_knDirections {4};
+
+        // Number of places a winning line fits along each side of the board
+        static constexpr int m_knFitX {((nInARow < 1) || (nInARow > nX)) ? 0 : nX - nInARow + 1};
+        static constexpr int m_knFitY {((nInARow < 1) || (nInARow > nY)) ? 0 : nY - nInARow + 1};
+
+        // Number of winning lines
+        static constexpr int m_knLines {(m_knFitX * nY) + (nX * m_knFitY) + (2 * m_knFitX * m_knFitY)};
+
+        // Return the number of a square
+        static constexpr int Square(int nSquareX, int nSquareY) { return nSquareX + (nSquareY * nX); }
+
+        // Return the step from a square to the next, forward along a direction
+        static constexpr int Step(int nDirection)
+            { return (nDirection == 0) ? 1 : (nDirection == 1) ? nX : (nDirection == 2) ? nX + 1 : nX - 1; }
+
+        // Return the number of squares from a square to the edge of the board,
+        // forward or back along a direction
+        static int Reach(int nSquare, int nDirection, bool bForward)
+            { return m_kanReach[(((nSquare * m_knDirections) + nDirection) * 2) + (bForward ? 0 : 1)]; }
+
+        // Return the number of winning lines in a direction, and the first of them
+        static constexpr int Lines(int nDirection)
+            { return (nDirection == 0) ? m_knFitX * nY : (nDirection == 1) ? nX * m_knFitY : m_knFitX * m_knFitY; }
+        static constexpr int FirstLine(int nDirection)
+            { return (nDirection == 0) ? 0 : FirstLine(nDirection - 1) + Lines(nDirection - 1); }
+
+        // Return the first square of a winning line
+        static int LineStart(int nLine) { return m_kanLineStarts[nLine]; }
+
+    private:
+        // Squares to the edge, and first squares of winning lines
+        static const std::array<int8_t, m_knSquares * m_knDirections * 2> m_kanReach;
+        static const std::array<int16_t, m_knLines>                        m_kanLineStarts;
+
+        static constexpr int Min(int nA, int nB) { return (nA < nB) ? nA : nB; }
+
+        // The number of squares from a square to the edge, one C++11 constexpr
+        // step at a time
+        static constexpr int ReachOf(int nSquareX, int nSquareY, int nDirection, bool bForward)
+        {
+            return (nDirection == 0) ? (bForward ? nX - 1 - nSquareX : nSquareX) :
+                   (nDirection == 1) ? (bForward ? nY - 1 - nSquareY : nSquareY) :
+                   (nDirection == 2) ? (bForward ? Min(nX - 1 - nSquareX, nY - 1 - nSquareY) : Min(nSquareX, nSquareY)) :
+                                       (bForward ? Min(nSquareX, nY - 1 - nSquareY) : Min(nX - 1 - nSquareX, nSquareY));
+        }
+        static constexpr int8_t ReachEntry(int nIndex)
+            { return ReachOf((nIndex / 8) % nX, (nIndex / 8) / nX, (nIndex / 2) % m_knDirections, (nIndex % 2) == 0); }
+
+        // The first square of the nth winning line in a direction
+        static constexpr int LineStartOf(int nDirection, int nLine)
+        {
+            return (nDirection == 1) ? Square(nLine % nX, nLine / nX) :
+                   (nDirection == 3) ? Square(nInARow - 1 + (nLine % m_knFitX), nLine / m_knFitX) :
+                                       Square(nLine % m_knFitX, nLine / m_knFitX);
+        }
+        static constexpr int LineDirection(int nLine)
+            { return (nLine < FirstLine(1)) ? 0 : (nLine < FirstLine(2)) ? 1 : (nLine < FirstLine(3)) ? 2 : 3; }
+        static constexpr int16_t LineStartEntry(int nLine)
+            { return LineStartOf(LineDirection(nLine), nLine - FirstLine(LineDirection(nLine))); }
+
+        // Generate the tables from lists of indices
+        template <int... anIndices>
+        static constexpr std::array<int8_t, sizeof...(anIndices)> MakeReach(IndexList<anIndices...>)
+            { return {{ ReachEntry(anIndices)... }}; }
+        template <int... anIndices>
+        static constexpr std::array<int16_t, sizeof...(anIndices)> MakeLineStarts(IndexList<anIndices...>)
+            { return {{ LineStartEntry(anIndices)... }}; }
+};
+
+// Definitions, for when a constant is passed by reference, and the tables,
+// built by the compiler rather than at start up
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knX;
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knY;
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knInARow;
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knSquares;
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knDirections;
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knFitX;
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knFitY;
+template <int nX, int nY, int nInARow>
+constexpr int LinearLines<nX, nY, nInARow>::m_knLines;
+
+template <int nX, int nY, int nInARow>
+const std::array<int8_t, LinearLines<nX, nY, nInARow>::m_knSquares * LinearLines<nX, nY, nInARow>::m_knDirections * 2> LinearLines<nX, nY, nInARow>::m_kanReach =
+    LinearLines<nX, nY, nInARow>::MakeReach(typename MakeIndexList<m_knSquares * m_knDirections * 2>::Type());
+template <int nX, int nY, int nInARow>
+const std::array<int16_t, LinearLines<nX, nY, nInARow>::m_knLines> LinearLines<nX, nY, nInARow>::m_kanLineStarts =
+    LinearLines<nX, nY, nInARow>::MakeLineStarts(typename MakeIndexList<m_knLines>::Type());
+
+#endif // LINEARLINES_H
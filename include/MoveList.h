@@ -0,0 +1,87 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The MoveList class is a fixed-capacity list of BoardMoves.
+ *
+ * The moves are held in the object itself, so a MoveList on the stack, or
+ * one reused from ply to ply of a search, never touches the allocator, and
+ * the storage is not initialized until a move is added to it.  The
+ * capacity covers the most moves available in any position of any board
+ * game: a chess position has at most 218, and a 19x19 board of Gomoku
+ * has 361 squares.
+ *
+ */
+
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "BoardMove.h"
+#include "GameAIException.h"
+
+class MoveList
+{
+    public:
+        // Type of the elements, for code written for any list of moves
+        typedef BoardMove value_type;
+
+        // Max number of moves in a list, one for each square of a 19x19 board
+        static const int m_knMaxMoves {361};
+
+        // Add a move to the end of the list
+        void Add(const BoardMove &cBoardMove)
+        {
+            if (m_nSize == m_knMaxMoves)
+                throw GameAIException("MoveList::Add() list is full");
+
+            new (&m_auMoves[m_nSize++]) BoardMove(cBoardMove);
+        }
+
+        // Remove all moves from the list
+        void Clear()                                 { m_nSize = 0; }
+
+        // Return the number of moves in the list
+        int  Size() const                            { return m_nSize; }
+        bool Empty() const                           { return m_nSize == 0; }
+
+        // Return the move at an index
+        const BoardMove & operator[](int n) const    { return begin()[n]; }
+
+        // Iterate through the moves
+        const BoardMove * begin() const              { return reinterpret_cast<const BoardMove *>(m_auMoves); }
+        const BoardMove * end() const                { return begin() + m_nSize; }
+
+        // Return the number of moves, for code written for any list of moves
+        size_t size() const                          { return m_nSize; }
+        bool   empty() const                         { return m_nSize == 0; }
+
+    private:
+        // Storage for the moves, left uninitialized until a move is added
+        std::aligned_storage<sizeof(BoardMove), alignof(BoardMove)>::type m_auMoves[m_knMaxMoves];
+
+        // Number of moves in the list
+        int m_nSize {0};
+};
+
+#endif // MOVELIST_H
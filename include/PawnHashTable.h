@@ -0,0 +1,75 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The PawnHashTable class caches pawn structure evaluations, keyed
+ * by a Zobrist hash of the pawns alone.
+ *
+ */
+
+#ifndef PAWNHASHTABLE_H
+#define PAWNHASHTABLE_H
+
+#include <cstdint>
+#include <vector>
+
+class PawnHashTable
+{
+    public:
+        // Pawn structure counts for both players
+        struct Entry
+        {
+            uint64_t uiKey {0};
+            bool     bValid {false};
+            int      anDoubled[2]  {0, 0};
+            int      anIsolated[2] {0, 0};
+            int      anPassed[2]   {0, 0};
+        };
+
+        // Construct a table with a power of two number of entries
+        explicit PawnHashTable(int nEntries = m_knDefaultEntries) :
+            m_vEntries(nEntries),
+            m_uiMask(nEntries - 1)
+        {}
+
+        // Return the entry for a key, or nullptr if the key is not cached
+        const Entry * Probe(uint64_t uiKey) const
+        {
+            const Entry &stEntry = m_vEntries[uiKey & m_uiMask];
+            if (stEntry.bValid && (stEntry.uiKey == uiKey))
+                return &stEntry;
+            return nullptr;
+        }
+
+        // Store an entry, replacing whatever occupied its slot
+        void Store(const Entry &stEntry) { m_vEntries[stEntry.uiKey & m_uiMask] = stEntry; }
+
+    private:
+        // Default number of entries
+        static const int m_knDefaultEntries {4096};
+
+        // Table entries
+        std::vector<Entry> m_vEntries;
+
+        // Mask to convert a key to a table index
+        const uint64_t m_uiMask;
+};
+
+#endif // PAWNHASHTABLE_H
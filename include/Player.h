@@ -87,6 +87,12 @@ class Player
         // Return the number of plies
         int  Plies() const        { return m_nDepth; }
 
+        // Set whether a machine player solves games that can be solved, instead of searching plies
+        void SetSolve(bool b)     { m_bSolve = b; }
+
+        // Return whether to solve
+        bool Solve() const        { return m_bSolve; }
+
         // Set the probability threshold a machine player will use to make a move
         void SetProbability(int nProb) { m_nProbabilityThreshold = nProb; }
 
@@ -110,6 +116,9 @@ class Player
         // Set the depth of plies to four
         int  m_nDepth             {4}; // For AI
 
+        // Search plies unless told to solve
+        bool m_bSolve             {false}; // For AI
+
         // Set the probability threshold to 5 (a.k.a., 0.5, 50%)
         int m_nProbabilityThreshold {5};
 
@@ -21,40 +21,76 @@
  *
  * \brief The Reversi class represents a Reversi game.
  *
+ * Alongside the GameBoard, the tokens are kept in a ReversiBitboard, from
+ * which moves, flips, and token counts are found for the whole board at
+ * once.
+ *
+ * The game state is evaluated from tables of tuned weights for patterns of
+ * squares, if weights are read, or else from the squares held, the number
+ * of tokens, and the number of moves.
+ *
+ * With few enough empty squares left, a machine player has the endgame
+ * solved by a ReversiEndgameSolver, for the move with the best final score.
+ *
  */
 
 #ifndef REVERSI_H
 #define REVERSI_H
 
+#include <memory>
+
 #include "LinearGame.h"
+#include "ReversiBitboard.h"
+#include "ReversiEndgameSolver.h"
+#include "ReversiPatterns.h"
 
-class Reversi : public LinearGame
+class Reversi : public LinearGame<LinearLines<ReversiBitboard::m_knDimension, ReversiBitboard::m_knDimension, 0>>
 {
     public:
         // Construct a Reversi game, and set up the board
-        explicit Reversi(GameType ecGameType) : LinearGame(ecGameType, m_kiDimension, m_kiDimension, 'D', 'L', 0, true, true, true, true)
+        explicit Reversi(GameType ecGameType) : LinearGame(ecGameType, 'D', 'L', 0, true, true, true, true)
         { SetBoard(); }
 
         // Deconstructor
         ~Reversi() {}
 
         // Apply the move to the game
-        virtual bool ApplyMove(int nPlayer, GameMove &cGameMove) override;
+        virtual bool ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
+        // Apply a move generated by the game without validating it
+        virtual bool ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove) override;
 
         // Evaluate the game state from the perspective of the nPlayer
         virtual int  EvaluateGameState(int nPlayer) override;
+        // Evaluate the game state with pattern weights read from a file
+        virtual bool ReadEvaluationWeights(const std::string &sFileName) override;
+        // Tune pattern weights to a number of games played at random and write them to a file
+        virtual bool WriteEvaluationWeights(const std::string &sFileName, int nGames) override;
+        // Return a key shared by the position and every position symmetric to it
+        virtual bool CanonicalKey(uint64_t &uiKey) const override { uiKey = m_cBitboard.CanonicalKey(); return true; }
 
         // Return the score of the game
         virtual std::string GameScore() const override;
 
         // Check to see if the game has ended
         virtual bool GameEnded(int nPlayer) override;
+        // Check to see if the game has ended and, if not, fill a list with the valid moves
+        virtual bool GameEndedWithMoves(int nPlayer, MoveList &cMoveList) override;
+
+        // Fill a list with the valid moves
+        virtual void GenerateBoardMoves(int nPlayer, MoveList &cMoveList) override;
 
-        // Generate a vector of valid moves
-        virtual std::vector<GameMove> GenerateMoves(int nPlayer) override;
+        // Whether few enough squares are left to solve the endgame
+        virtual bool EndgameSolvable() const override { return __builtin_popcountll(~m_cBitboard.Occupied()) <= m_nEndgameEmpties; }
+        // Set the number of empty squares left from which the endgame is solved
+        virtual void SetEndgameEmpties(int nEmpties) override { m_nEndgameEmpties = nEmpties; }
+        // Generate a perfect move by solving the endgame
+        virtual GameMove SolvedMove(int nPlayer) override;
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new Reversi(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) Reversi(*this); }
+        virtual size_t CloneSize() const override { return sizeof(Reversi); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "Reversi"; }
@@ -66,39 +102,40 @@ class Reversi : public LinearGame
         // Set up the board for initial play
         void SetBoard();
 
-        // A set of methods to check for contiguous tokens along all lines
-        bool Contiguous(int nX, int nY, int nPlayer) const;
-        bool ContiguousUp(int nX, int nY, int nPlayer) const;
-        bool ContiguousUpRight(int nX, int nY, int nPlayer) const;
-        bool ContiguousRight(int nX, int nY, int nPlayer) const;
-        bool ContiguousDownRight(int nX, int nY, int nPlayer) const;
-        bool ContiguousDown(int nX, int nY, int nPlayer) const;
-        bool ContiguousDownLeft(int nX, int nY, int nPlayer) const;
-        bool ContiguousLeft(int nX, int nY, int nPlayer) const;
-        bool ContiguousUpLeft(int nX, int nY, int nPlayer) const;
-        bool CheckContiguous(int nX, int nY, int nPlayer, bool &bOpponentPieceAdjacent) const;
-
-        // A set of methods to change tokens (aka, flip) along all lines
-        void Flip(int nPlayer, const GameMove &cGameMove);
-        void FlipUp(int nX, int nY, int nPlayer);
-        void FlipUpRight(int nX, int nY, int nPlayer);
-        void FlipRight(int nX, int nY, int nPlayer);
-        void FlipDownRight(int nX, int nY, int nPlayer);
-        void FlipDown(int nX, int nY, int nPlayer);
-        void FlipDownLeft(int nX, int nY, int nPlayer);
-        void FlipLeft(int nX, int nY, int nPlayer);
-        void FlipUpLeft(int nX, int nY, int nPlayer);
-        bool FlipToken(int nX, int nY, int nPlayer);
+        // Place a token on the bitboard and in the pattern indices
+        void Place(int nPlayer, const BoardMove &cBoardMove);
+        // Set the pattern indices from the bitboard
+        void SetPatternIndices();
+        // Flip (change) the tokens captured by a move
+        void Flip(int nPlayer, const BoardMove &cBoardMove);
+
+        // Check to see if the game has ended and, if not, return the squares nPlayer can move to
+        bool GameEndedWithMoveSquares(int nPlayer, uint64_t &uiMoves);
+        // Fill a list with a move to each square of a mask
+        static void AddBoardMoves(uint64_t uiMoves, MoveList &cMoveList);
 
         // Count the number of tokens for nPlayer
         int  CountEvaluation(int nPlayer) const;
         // Count the positional value of tokens for nPlayer
         int  SquareEvaluation(int nPlayer) const;
         // Count the number of valid moves for nPlayer
-        int  MobilityEvaluation(int nPlayer);
+        int  MobilityEvaluation(int nPlayer) const;
 
         // Board dimension
-        static const int m_kiDimension {8};
+        static const int m_kiDimension {ReversiBitboard::m_knDimension};
+
+        // The tokens of both players, kept alongside the GameBoard
+        ReversiBitboard m_cBitboard {};
+
+        // Number of empty squares left from which the endgame is solved
+        int m_nEndgameEmpties {16};
+        // Endgame solver, made when first used and shared with clones
+        std::shared_ptr<ReversiEndgameSolver> m_pcEndgameSolver {};
+
+        // Pattern weights, if read, shared with clones, and the pattern
+        // indices of the board, kept while there are weights
+        std::shared_ptr<const ReversiPatterns> m_pcPatterns {};
+        ReversiPatterns::Indices m_stPatternIndices {};
 
         // Static evaluation table
         const int m_kaiEvalTable[m_kiDimension][m_kiDimension] =
@@ -108,7 +145,7 @@ class Reversi : public LinearGame
             {  8,  -4,  7,  4,  4,  7,  -4,  8 },
             {  6,  -3,  4,  0,  0,  4,  -3,  6 },
             {  6,  -3,  4,  0,  0,  4,  -3,  6 },
-            {  8   -4,  7,  4,  4,  7,  -4,  8 },
+            {  8,  -4,  7,  4,  4,  7,  -4,  8 },
             { -8, -24, -4, -3, -3, -4, -24, -8 },
             { 99,  -8,  8,  6,  6,  8,  -8, 99 }
         };
@@ -0,0 +1,317 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The ReversiBitboard class holds an 8x8 Reversi position in two
+ * 64-bit masks, one per player.
+ *
+ * Each column takes eight bits, the top row in the lowest bit, so that the
+ * squares of a mask in ascending order run down each column in turn, from
+ * left to right.  A step along any of the eight directions is a shift of a
+ * mask; steps that would wrap from one edge of the board to the other are
+ * masked off.  The moves and the discs a move flips are found for all
+ * squares, or all directions, at once with Kogge-Stone fills: a fill from a
+ * player's discs through the opponent's discs doubles its reach with each
+ * shift.
+ *
+ * The eight symmetries of the board are reflections of the masks: left to
+ * right swaps the columns' bytes, top to bottom reverses the bits of each
+ * byte, and across the diagonal swaps columns with rows.
+ *
+ */
+
+#ifndef REVERSIBITBOARD_H
+#define REVERSIBITBOARD_H
+
+#include <cstdint>
+
+#include "Zobrist.h"
+
+class ReversiBitboard
+{
+    public:
+        // Board dimension
+        static const int m_knDimension {8};
+
+        // Return the bit of a square
+        static uint64_t Square(int nX, int nY)     { return UINT64_C(1) << (nX * m_knDimension + nY); }
+        // Return the coordinates of the lowest square of a mask
+        static int  X(uint64_t uiSquares)          { return __builtin_ctzll(uiSquares) / m_knDimension; }
+        static int  Y(uint64_t uiSquares)          { return __builtin_ctzll(uiSquares) % m_knDimension; }
+
+        // Place a disc for a player, without flipping
+        void Place(int nPlayer, int nX, int nY)    { m_auiDiscs[nPlayer - 1] |= Square(nX, nY); }
+        // Turn discs over to a player
+        void Flip(int nPlayer, uint64_t uiFlips)   { m_auiDiscs[nPlayer - 1] ^= uiFlips; m_auiDiscs[2 - nPlayer] ^= uiFlips; }
+        // Remove every disc
+        void Clear()                               { m_auiDiscs[0] = 0; m_auiDiscs[1] = 0; }
+
+        // Return the discs of a player, and every disc
+        uint64_t Discs(int nPlayer) const          { return m_auiDiscs[nPlayer - 1]; }
+        uint64_t Occupied() const                  { return m_auiDiscs[0] | m_auiDiscs[1]; }
+        // Return the number of discs of a player
+        int  Count(int nPlayer) const              { return __builtin_popcountll(m_auiDiscs[nPlayer - 1]); }
+
+        // Return the squares a player can move to
+        uint64_t Moves(int nPlayer) const          { return Moves(m_auiDiscs[nPlayer - 1], m_auiDiscs[2 - nPlayer]); }
+        // Return the discs a player's move to a square would flip
+        uint64_t Flips(int nPlayer, int nX, int nY) const { return Flips(Square(nX, nY), m_auiDiscs[nPlayer - 1], m_auiDiscs[2 - nPlayer]); }
+
+        // Return the squares a player with uiOwn discs can move to
+        static uint64_t Moves(uint64_t uiOwn, uint64_t uiOpponent);
+        // Return the discs a move to the square uiMove would flip
+        static uint64_t Flips(uint64_t uiMove, uint64_t uiOwn, uint64_t uiOpponent);
+
+        // Return a key shared by the position and every position symmetric to it
+        uint64_t CanonicalKey() const;
+
+    private:
+        // Reflect a mask left to right, top to bottom, and across the diagonal through the top left corner
+        static uint64_t MirrorX(uint64_t uiSquares)    { return __builtin_bswap64(uiSquares); }
+        static uint64_t MirrorY(uint64_t uiSquares);
+        static uint64_t Transpose(uint64_t uiSquares);
+
+        // Shift a mask a number of squares along a direction, to higher squares if positive
+        static uint64_t Shift(uint64_t uiSquares, int nShift) { return (nShift > 0) ? (uiSquares << nShift) : (uiSquares >> -nShift); }
+        // Fill from uiGenerator along a direction through uiPropagator, and return the fill
+        static uint64_t Fill(uint64_t uiGenerator, uint64_t uiPropagator, int nShift);
+
+        // Return the moves, or the flips of a move, along one direction
+        static uint64_t MovesAlong(uint64_t uiOwn, uint64_t uiOpponent, int nShift, uint64_t uiEntry);
+        static uint64_t FlipsAlong(uint64_t uiMove, uint64_t uiOwn, uint64_t uiOpponent, int nShift, uint64_t uiEntry);
+
+        // Squares that can be stepped onto down a column, and up a column,
+        // without wrapping into the next column
+        static const uint64_t m_kuiNotTopRow    {UINT64_C(0xFEFEFEFEFEFEFEFE)};
+        static const uint64_t m_kuiNotBottomRow {UINT64_C(0x7F7F7F7F7F7F7F7F)};
+        static const uint64_t m_kuiAllSquares   {~UINT64_C(0)};
+
+        // Discs of player 1 and player 2
+        uint64_t m_auiDiscs[2] {};
+};
+
+/**
+  * Fill along a direction.
+  *
+  * Kogge-Stone fill: spread the generator through the propagator one, two,
+  * and then four squares further, narrowing the propagator to the squares
+  * from which the next span is also clear.
+  *
+  * \param uiGenerator  Squares to fill from
+  * \param uiPropagator Squares the fill may pass through
+  * \param nShift       The shift of one step along the direction
+  *
+  * \return The generator and every square it reached.
+  */
+
+inline uint64_t ReversiBitboard::Fill(uint64_t uiGenerator, uint64_t uiPropagator, int nShift)
+{
+    uiGenerator  |= uiPropagator & Shift(uiGenerator, nShift);
+    uiPropagator &= Shift(uiPropagator, nShift);
+    uiGenerator  |= uiPropagator & Shift(uiGenerator, 2 * nShift);
+    uiPropagator &= Shift(uiPropagator, 2 * nShift);
+    uiGenerator  |= uiPropagator & Shift(uiGenerator, 4 * nShift);
+
+    return uiGenerator;
+}
+
+/**
+  * Return the moves along one direction.
+  *
+  * Fill from the player's discs through the opponent's discs; an empty
+  * square one step past the opponent's discs reached is a move.
+  *
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param nShift     The shift of one step along the direction
+  * \param uiEntry    The squares a step along the direction can land on
+  *
+  * \return A bit per move.
+  */
+
+inline uint64_t ReversiBitboard::MovesAlong(uint64_t uiOwn, uint64_t uiOpponent, int nShift, uint64_t uiEntry)
+{
+    uint64_t uiFill = Fill(uiOwn, uiOpponent & uiEntry, nShift) & ~uiOwn;
+
+    return Shift(uiFill, nShift) & uiEntry & ~(uiOwn | uiOpponent);
+}
+
+/**
+  * Return the flips of a move along one direction.
+  *
+  * Fill from the move through the opponent's discs; if the step past the
+  * fill lands on one of the player's discs, the opponent's discs filled are
+  * flipped.
+  *
+  * \param uiMove     The square of the move
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param nShift     The shift of one step along the direction
+  * \param uiEntry    The squares a step along the direction can land on
+  *
+  * \return A bit per disc flipped.
+  */
+
+inline uint64_t ReversiBitboard::FlipsAlong(uint64_t uiMove, uint64_t uiOwn, uint64_t uiOpponent, int nShift, uint64_t uiEntry)
+{
+    uint64_t uiFill = Fill(uiMove, uiOpponent & uiEntry, nShift) & ~uiMove;
+    uint64_t uiBracketed = Shift(uiFill, nShift) & uiEntry & uiOwn;
+
+    // All the filled discs if bracketed, none otherwise
+    return uiFill & (UINT64_C(0) - (uiBracketed != 0));
+}
+
+/**
+  * Return the squares a player can move to.
+  *
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  *
+  * \return A bit per move.
+  */
+
+inline uint64_t ReversiBitboard::Moves(uint64_t uiOwn, uint64_t uiOpponent)
+{
+    return MovesAlong(uiOwn, uiOpponent,  1,                   m_kuiNotTopRow)    |
+           MovesAlong(uiOwn, uiOpponent, -1,                   m_kuiNotBottomRow) |
+           MovesAlong(uiOwn, uiOpponent,  m_knDimension,       m_kuiAllSquares)   |
+           MovesAlong(uiOwn, uiOpponent, -m_knDimension,       m_kuiAllSquares)   |
+           MovesAlong(uiOwn, uiOpponent,  m_knDimension + 1,   m_kuiNotTopRow)    |
+           MovesAlong(uiOwn, uiOpponent,  m_knDimension - 1,   m_kuiNotBottomRow) |
+           MovesAlong(uiOwn, uiOpponent, -m_knDimension + 1,   m_kuiNotTopRow)    |
+           MovesAlong(uiOwn, uiOpponent, -m_knDimension - 1,   m_kuiNotBottomRow);
+}
+
+/**
+  * Return the discs a move flips.
+  *
+  * \param uiMove     The square of the move
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  *
+  * \return A bit per disc flipped, or zero if the move is not valid.
+  */
+
+inline uint64_t ReversiBitboard::Flips(uint64_t uiMove, uint64_t uiOwn, uint64_t uiOpponent)
+{
+    return FlipsAlong(uiMove, uiOwn, uiOpponent,  1,                   m_kuiNotTopRow)    |
+           FlipsAlong(uiMove, uiOwn, uiOpponent, -1,                   m_kuiNotBottomRow) |
+           FlipsAlong(uiMove, uiOwn, uiOpponent,  m_knDimension,       m_kuiAllSquares)   |
+           FlipsAlong(uiMove, uiOwn, uiOpponent, -m_knDimension,       m_kuiAllSquares)   |
+           FlipsAlong(uiMove, uiOwn, uiOpponent,  m_knDimension + 1,   m_kuiNotTopRow)    |
+           FlipsAlong(uiMove, uiOwn, uiOpponent,  m_knDimension - 1,   m_kuiNotBottomRow) |
+           FlipsAlong(uiMove, uiOwn, uiOpponent, -m_knDimension + 1,   m_kuiNotTopRow)    |
+           FlipsAlong(uiMove, uiOwn, uiOpponent, -m_knDimension - 1,   m_kuiNotBottomRow);
+}
+
+/**
+  * Return the canonical key of the position.
+  *
+  * Reflect both masks under each of the eight symmetries in turn, keep the
+  * lowest pair of masks, and hash it.  Symmetric positions have the same
+  * lowest pair, and so the same key.
+  *
+  * \return The key.
+  */
+
+inline uint64_t ReversiBitboard::CanonicalKey() const
+{
+    uint64_t uiDiscs1 = m_auiDiscs[0];
+    uint64_t uiDiscs2 = m_auiDiscs[1];
+
+    uint64_t uiLowest1 = uiDiscs1;
+    uint64_t uiLowest2 = uiDiscs2;
+
+    // Reflecting top to bottom, left to right, top to bottom again, and then
+    // across the diagonal, visits every symmetry
+    for (int nSymmetry = 1; nSymmetry < 8; ++nSymmetry)
+    {
+        if (nSymmetry == 4)
+        {
+            uiDiscs1 = Transpose(uiDiscs1);
+            uiDiscs2 = Transpose(uiDiscs2);
+        }
+        else if (nSymmetry % 2 == 1)
+        {
+            uiDiscs1 = MirrorY(uiDiscs1);
+            uiDiscs2 = MirrorY(uiDiscs2);
+        }
+        else
+        {
+            uiDiscs1 = MirrorX(uiDiscs1);
+            uiDiscs2 = MirrorX(uiDiscs2);
+        }
+
+        if ((uiDiscs1 < uiLowest1) || ((uiDiscs1 == uiLowest1) && (uiDiscs2 < uiLowest2)))
+        {
+            uiLowest1 = uiDiscs1;
+            uiLowest2 = uiDiscs2;
+        }
+    }
+
+    return Zobrist::SplitMix64(uiLowest1 ^ Zobrist::SplitMix64(uiLowest2, 0), 0);
+}
+
+/**
+  * Reflect a mask top to bottom.
+  *
+  * Reverse the bits of each column's byte, swapping single bits, then pairs,
+  * then nibbles.
+  *
+  * \param uiSquares The mask
+  *
+  * \return The reflected mask.
+  */
+
+inline uint64_t ReversiBitboard::MirrorY(uint64_t uiSquares)
+{
+    uiSquares = ((uiSquares >> 1) & UINT64_C(0x5555555555555555)) | ((uiSquares & UINT64_C(0x5555555555555555)) << 1);
+    uiSquares = ((uiSquares >> 2) & UINT64_C(0x3333333333333333)) | ((uiSquares & UINT64_C(0x3333333333333333)) << 2);
+    uiSquares = ((uiSquares >> 4) & UINT64_C(0x0F0F0F0F0F0F0F0F)) | ((uiSquares & UINT64_C(0x0F0F0F0F0F0F0F0F)) << 4);
+
+    return uiSquares;
+}
+
+/**
+  * Reflect a mask across the diagonal through the top left corner.
+  *
+  * Swap the squares either side of the diagonal with three delta swaps:
+  * four by four blocks, then two by two, then single squares.
+  *
+  * \param uiSquares The mask
+  *
+  * \return The reflected mask.
+  */
+
+inline uint64_t ReversiBitboard::Transpose(uint64_t uiSquares)
+{
+    uint64_t uiDelta;
+
+    uiDelta    = UINT64_C(0x0F0F0F0F00000000) & (uiSquares ^ (uiSquares << 28));
+    uiSquares ^= uiDelta ^ (uiDelta >> 28);
+    uiDelta    = UINT64_C(0x3333000033330000) & (uiSquares ^ (uiSquares << 14));
+    uiSquares ^= uiDelta ^ (uiDelta >> 14);
+    uiDelta    = UINT64_C(0x5500550055005500) & (uiSquares ^ (uiSquares << 7));
+    uiSquares ^= uiDelta ^ (uiDelta >> 7);
+
+    return uiSquares;
+}
+
+#endif // REVERSIBITBOARD_H
@@ -0,0 +1,137 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The ReversiEndgameSolver class finds the perfect move in a Reversi
+ * endgame.
+ *
+ * The solver searches the discs of the player to move and of their opponent
+ * to the end of the game with negamax and alpha-beta pruning.  Moves that
+ * leave the opponent the fewest replies are tried first, and among equals,
+ * moves into a quadrant with an odd number of empty squares, so as to have
+ * the last move there.  Near the end of the game, only the parity of the
+ * quadrants orders the moves.  Bounds on the scores of positions searched
+ * are kept in a small transposition table.
+ *
+ * The moves at the top of the tree are split among threads: the first move
+ * is solved, then each thread takes the next move left, shows with a
+ * null-window search whether it beats the best so far, and only if it does
+ * solves it.  Each thread has its own transposition table, kept for the
+ * life of the solver.  The threads only see bitboards, and never the game.
+ *
+ * A score is the number of the player to move's discs less the number of
+ * their opponent's discs, when the game ends.
+ *
+ */
+
+#ifndef REVERSIENDGAMESOLVER_H
+#define REVERSIENDGAMESOLVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ReversiBitboard.h"
+
+class ReversiEndgameSolver
+{
+    public:
+        // Construct a solver searching with a number of threads, or one per
+        // processor if zero
+        explicit ReversiEndgameSolver(int nThreads = 0);
+
+        // Return the score of a position for the player to move
+        int  Solve(uint64_t uiOwn, uint64_t uiOpponent);
+        // Return the square of the best move for the player to move, and its score
+        int  BestMove(uint64_t uiOwn, uint64_t uiOpponent, int &nScore);
+
+        // Return the number of positions searched
+        uint64_t Nodes() const;
+
+        // Lowest and highest scores
+        static const int m_knMinScore {-ReversiBitboard::m_knDimension * ReversiBitboard::m_knDimension};
+        static const int m_knMaxScore {ReversiBitboard::m_knDimension * ReversiBitboard::m_knDimension};
+
+    private:
+        // Bounds on the score of a position, and its best move
+        struct Entry
+        {
+            uint64_t uiOwn      {0};
+            uint64_t uiOpponent {0};
+            int8_t   nLower     {m_knMinScore};
+            int8_t   nUpper     {m_knMaxScore};
+            int8_t   nMove      {-1};
+        };
+
+        // The transposition table and count of positions searched of one thread
+        struct Worker
+        {
+            std::vector<Entry> vstTable;
+            uint64_t           uiNodes {0};
+        };
+
+        // The search at the top of the tree, shared by the threads
+        struct Root
+        {
+            std::vector<int>    vnMoves;
+            std::atomic<size_t> nNext {0};
+            std::mutex          mtxBest;
+            int                 nBestScore {m_knMinScore};
+            int                 nBestMove  {-1};
+        };
+
+        // Search the moves at the top of the tree left after the first
+        static void SearchRootMoves(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent, Root &stRoot);
+
+        // Search a position within a window of scores
+        static int  Negamax(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent, int nAlpha, int nBeta);
+        // Search a position with few empty squares, without the transposition table
+        static int  NegamaxShallow(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent, int nAlpha, int nBeta);
+        // Score a position with one empty square
+        static int  LastMove(uint64_t uiOwn, uint64_t uiOpponent, uint64_t uiEmpty);
+
+        // Return the moves of a position, a first move and then the best first
+        static int  OrderMoves(uint64_t uiOwn, uint64_t uiOpponent, uint64_t uiMoves, int nFirstMove, int anMoves[]);
+        // Return the quadrants holding an odd number of empty squares
+        static uint64_t OddQuadrants(uint64_t uiEmpty);
+
+        // Return the slot of a position in a transposition table
+        static Entry & Slot(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent);
+
+        // Return the score of a finished game
+        static int  FinalScore(uint64_t uiOwn, uint64_t uiOpponent)
+            { return __builtin_popcountll(uiOwn) - __builtin_popcountll(uiOpponent); }
+
+        // Positions with no more empty squares than this are searched without
+        // the transposition table or ordering by replies
+        static const int m_knShallowEmpties {6};
+        // Number of entries in each transposition table, a power of two
+        static const int m_knTableEntries {1 << 16};
+
+        // One worker per thread
+        std::vector<Worker> m_vstWorkers;
+
+        // Quadrants of the board
+        static const uint64_t m_kauiQuadrants[4];
+};
+
+#endif // REVERSIENDGAMESOLVER_H
@@ -0,0 +1,175 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The ReversiPatterns class evaluates a Reversi position as a sum of
+ * weights looked up in pattern tables.
+ *
+ * A pattern is a fixed sequence of squares: an edge with its two X squares,
+ * a 3x3 corner, a 2x5 corner, or a diagonal of four to eight squares.  Each
+ * pattern is laid on the board in each of its symmetric positions, and
+ * every position of a pattern shares one table.  The index of a position
+ * into its table reads its squares as a ternary number, the first square
+ * the lowest digit: 0 for empty, 1 for player 1, and 2 for player 2.  The
+ * indices are kept up to date as discs are placed and flipped, so that an
+ * evaluation is one lookup per position.
+ *
+ * Weights are tuned offline for a number of phases of the game, the phase
+ * following the number of discs on the board.  A weight file is a header,
+ * the eight characters "GAIRVPW1", the number of phases, and the number of
+ * patterns, as 32-bit integers, followed by the 16-bit weights, phase by
+ * phase, and pattern by pattern in the order above, each table in order of
+ * index.  A weight is from player 1's perspective.  The file is read and
+ * written in the byte order of the computer that reads or writes it.
+ *
+ * Weights are tuned to samples of positions, each with the disc difference
+ * its game ended with, by stochastic gradient descent on the squared error
+ * of the evaluation.
+ *
+ */
+
+#ifndef REVERSIPATTERNS_H
+#define REVERSIPATTERNS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Logger.h"
+
+class ReversiPatterns
+{
+    public:
+        // Number of patterns, and of positions of them on the board
+        static const int m_knPatterns  {8};
+        static const int m_knPositions {34};
+
+        // The index of every position of a pattern
+        struct Indices
+        {
+            uint16_t auiIndex[m_knPositions] {};
+        };
+
+        // A position of a game, and the disc difference the game ended with for player 1
+        struct Sample
+        {
+            Indices stIndices {};
+            int     nDiscs    {0};
+            int     nResult   {0};
+        };
+
+        // Read the weights from a file
+        bool Read(const std::string &sFileName);
+        // Write the weights to a file
+        bool Write(const std::string &sFileName) const;
+
+        // Tune weights for a number of phases to samples of positions
+        void Tune(const std::vector<Sample> &vstSamples, int nPhases, int nEpochs, const Logger &cLogger);
+
+        // Return the evaluation of the positions for player 1
+        int  Evaluate(const Indices &stIndices, int nDiscs) const;
+        // Return the phase of the game for a number of discs
+        static int Phase(int nDiscs, int nPhases);
+
+        // Update the indices for a disc placed on an empty square
+        static void Place(Indices &stIndices, int nPlayer, int nSquare);
+        // Update the indices for a disc flipped to a player
+        static void Flip(Indices &stIndices, int nPlayer, int nSquare);
+
+    private:
+        // The positions a square is part of, and the value of its digit in each
+        struct SquarePositions
+        {
+            int      nCount {0};
+            uint8_t  anPosition[8];
+            uint16_t anPower[8];
+        };
+
+        // Where the patterns lie on the board
+        struct Layout
+        {
+            Layout();
+
+            // Pattern of each position
+            int anPattern[m_knPositions];
+            // Positions of each square
+            SquarePositions astSquares[64];
+        };
+
+        // Number of squares in each pattern
+        static const int m_kanPatternSquares[m_knPatterns];
+        // Offset of each pattern's table in the weights of a phase
+        static const int m_kanTableOffsets[m_knPatterns + 1];
+
+        static const Layout m_kstLayout;
+
+        // Identifies a weight file, and its version
+        static const char m_kacMagic[8];
+
+        // Evaluation of one disc of the difference a game ends with
+        static const int m_knDiscWeight {100};
+        // Step of the gradient descent
+        static constexpr double m_kdLearningRate {0.002};
+
+        // Weights per phase, the tables of every pattern end to end
+        std::vector<std::vector<int16_t>> m_vvnWeights {};
+};
+
+/**
+  * Update the indices for a disc placed on an empty square.
+  *
+  * \param stIndices The indices
+  * \param nPlayer   The player placing the disc
+  * \param nSquare   The square, as a ReversiBitboard bit number
+  */
+
+inline void ReversiPatterns::Place(Indices &stIndices, int nPlayer, int nSquare)
+{
+    const SquarePositions &kstSquare = m_kstLayout.astSquares[nSquare];
+
+    for (int iii = 0; iii < kstSquare.nCount; ++iii)
+        stIndices.auiIndex[kstSquare.anPosition[iii]] += nPlayer * kstSquare.anPower[iii];
+}
+
+/**
+  * Update the indices for a disc flipped to a player.
+  *
+  * The digit changes from the opponent's to the player's: down by one for a
+  * flip to player 1, and up by one for a flip to player 2.
+  *
+  * \param stIndices The indices
+  * \param nPlayer   The player the disc is flipped to
+  * \param nSquare   The square, as a ReversiBitboard bit number
+  */
+
+inline void ReversiPatterns::Flip(Indices &stIndices, int nPlayer, int nSquare)
+{
+    const SquarePositions &kstSquare = m_kstLayout.astSquares[nSquare];
+
+    for (int iii = 0; iii < kstSquare.nCount; ++iii)
+    {
+        if (nPlayer == 1)
+            stIndices.auiIndex[kstSquare.anPosition[iii]] -= kstSquare.anPower[iii];
+        else
+            stIndices.auiIndex[kstSquare.anPosition[iii]] += kstSquare.anPower[iii];
+    }
+}
+
+#endif // REVERSIPATTERNS_H
@@ -0,0 +1,87 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The SharedStack class is a stack whose storage is shared between
+ * copies.
+ *
+ * Copying a SharedStack copies a pointer and a length, not the elements.
+ * A copy sees the elements below its length exactly as they were when it
+ * was made, and pushes by writing past that length into the shared storage.
+ * This suits depth-first search over cloned games: a clone only writes above
+ * the depth of the game it was cloned from, so the ancestors' elements are
+ * never disturbed, and siblings simply overwrite one another's abandoned
+ * elements.  Two copies of equal length must not both push and then read
+ * back what they pushed while both are alive.
+ *
+ */
+
+#ifndef SHAREDSTACK_H
+#define SHAREDSTACK_H
+
+#include <memory>
+#include <vector>
+
+template <typename T>
+class SharedStack
+{
+    public:
+        // Construct an empty stack with its own storage
+        SharedStack() :
+            m_pvBuffer(std::make_shared<std::vector<T>>())
+        {}
+
+        // Push an element onto the top of the stack
+        void Push(const T &t)
+        {
+            if (m_nLength < m_pvBuffer->size())
+                (*m_pvBuffer)[m_nLength] = t;
+            else
+                m_pvBuffer->push_back(t);
+
+            ++m_nLength;
+        }
+
+        // Remove the element on the top of the stack
+        void Pop()                             { --m_nLength; }
+
+        // Return the element on the top of the stack
+        const T & Back() const                 { return (*m_pvBuffer)[m_nLength - 1]; }
+
+        // Return the element at an index from the bottom of the stack
+        const T & operator[](size_t n) const   { return (*m_pvBuffer)[n]; }
+
+        // Return the number of elements on the stack
+        size_t Size() const                    { return m_nLength; }
+        bool   Empty() const                   { return m_nLength == 0; }
+
+        // Iterate from the bottom of the stack to the top
+        const T * begin() const                { return m_pvBuffer->data(); }
+        const T * end() const                  { return m_pvBuffer->data() + m_nLength; }
+
+    private:
+        // Storage shared by all copies of this stack
+        std::shared_ptr<std::vector<T>> m_pvBuffer;
+
+        // Number of elements on this copy of the stack
+        size_t m_nLength {0};
+};
+
+#endif // SHAREDSTACK_H
@@ -0,0 +1,126 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The StoneBoard class represents a game board of stones for two
+ * players, larger than the GameBoard array of pieces, up to 19x19.
+ *
+ * A stone is one token for each player, and nothing else: stones do not
+ * move, and carry no value or number.  The stones of each player are kept
+ * in a multi-word bitboard, so that a board is copied as a single block of
+ * memory and sets of squares are found a word at a time.
+ *
+ */
+
+#ifndef STONEBOARD_H
+#define STONEBOARD_H
+
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "GamePiece.h"
+#include "GameAIException.h"
+#include "WideBitboard.h"
+
+class StoneBoard
+{
+    public:
+        // Multi-word bitboard of the largest board of stones
+        typedef WideBitboard<19, 19> StoneBitboard;
+
+        // Construct a board of stones of size X & Y, and display characteristics
+        StoneBoard(int nX, int nY, int nNumberOfTypesOfPieces,
+                   bool bDisplayGrid, bool bDisplayXCoordinates, bool bDisplayYCoordinates) :
+            m_knX(nX),
+            m_knY(nY),
+            m_kbDisplayGrid(bDisplayGrid),
+            m_kbDisplayXCoordinates(bDisplayXCoordinates),
+            m_kbDisplayYCoordinates(bDisplayYCoordinates)
+        {
+            // Ensure X- and Y-coordinates do not exceed maximum board sizes
+            if (m_knX > StoneBitboard::m_knX)
+            {
+                std::string sErrorMessage = "X-coordinate " + std::to_string(m_knX) + " exceeds max X-coordinate " + std::to_string(StoneBitboard::m_knX);
+                throw GameAIException(sErrorMessage);
+            }
+            if (m_knY > StoneBitboard::m_knY)
+            {
+                std::string sErrorMessage = "Y-coordinate " + std::to_string(m_knY) + " exceeds max Y-coordinate " + std::to_string(StoneBitboard::m_knY);
+                throw GameAIException(sErrorMessage);
+            }
+
+            // A board of stones holds one token for each player
+            if (nNumberOfTypesOfPieces > 2)
+            {
+                std::string sErrorMessage = "Number of game pieces " + std::to_string(nNumberOfTypesOfPieces) + " exceeds the one per player of a board of stones";
+                throw GameAIException(sErrorMessage);
+            }
+        }
+
+        // Evaluate location validity
+        bool ValidLocation(int nX, int nY) const { return (nX >= 0) && (nX < m_knX) && (nY >= 0) && (nY < m_knY); }
+        // Clear the board
+        void Clear() { m_acStones[0] = StoneBitboard(); m_acStones[1] = StoneBitboard(); }
+        // Display the board
+        void Display() const;
+        // Place the stone of a piece's player, or remove the stone for a piece of no player
+        bool SetPiece(int nX, int nY, const GamePiece &cGamePiece);
+        // Evaluate locations on the board
+        bool PositionOccupied(int nX, int nY) const { return PositionOccupiedBy(nX, nY) != 0; }
+        int  PositionOccupiedBy(int nX, int nY) const;
+        bool PositionOccupiedByPlayer(int nX, int nY, int nPlayer) const { return PositionOccupiedBy(nX, nY) == nPlayer; }
+
+        // Return the stones of a player
+        const StoneBitboard & Stones(int nPlayer) const { return m_acStones[nPlayer - 1]; }
+
+    private:
+        // Max X-coordinate for this game
+        const int  m_knX;
+        // Max Y-coordinate this game
+        const int  m_knY;
+
+        // The stones of each player, and their tokens
+        StoneBitboard m_acStones[2] {};
+        char          m_acStoneTokens[2] {};
+
+        // Booleans to display game information
+        const bool m_kbDisplayGrid;
+        const bool m_kbDisplayXCoordinates;
+        const bool m_kbDisplayYCoordinates;
+
+        // Used to convert alpha X coordinates to integer values for internal representation
+        static const char m_kcXCoordinate {'a'};
+
+        // Used to provide color for the stones
+#if defined(_WIN32)
+        static const int m_knPlayer1TokenColor {FOREGROUND_INTENSITY | FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE}; // White
+        static const int m_knPlayer2TokenColor {FOREGROUND_INTENSITY | FOREGROUND_RED};
+        static const int m_knResetTokenColor   {FOREGROUND_INTENSITY | FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE}; // White
+#else
+        static const char * const m_kszPlayer1TokenColor; // White
+        static const char * const m_kszPlayer2TokenColor; // Red
+        static const char * const m_kszResetTokenColor;   // Reset
+#endif
+};
+
+#endif // STONEBOARD_H
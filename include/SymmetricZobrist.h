@@ -0,0 +1,130 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The SymmetricZobrist class keeps the Zobrist key of a position
+ * under each symmetry of its board, and returns the lowest as the key of
+ * every position symmetric to it.
+ *
+ * A symmetry maps each square of the board to another.  The key under a
+ * symmetry hashes each token as if it stood on the square it is mapped to,
+ * so that the keys of two symmetric positions are the same keys in another
+ * order, and the lowest of them is the same.  Each key is updated as
+ * tokens are placed and removed, one Zobrist key per symmetry.
+ *
+ * A board has one, two, four or eight symmetries: itself, its mirror image
+ * left to right, its mirror image top to bottom, and its half turn, and for
+ * a square board also its reflections along either diagonal and its quarter
+ * turns.  A game keeps those of the first symmetries that do not change
+ * its play, as the left to right mirror for a game whose tokens drop, or
+ * none, if it finds its key some other way.
+ *
+ */
+
+#ifndef SYMMETRICZOBRIST_H
+#define SYMMETRICZOBRIST_H
+
+#include <cassert>
+#include <cstdint>
+
+#include "Zobrist.h"
+
+class SymmetricZobrist
+{
+    public:
+        // Most symmetries of a board
+        static const int m_knMaxSymmetries {8};
+
+        // Construct the keys of an empty board, under a number of its symmetries
+        SymmetricZobrist(int nWidth, int nHeight, int nSymmetries) :
+            m_knWidth(nWidth),
+            m_knHeight(nHeight),
+            m_knSymmetries(nSymmetries)
+        {
+            assert((nWidth * nHeight <= Zobrist::m_knNumberOfStoneSquares) && "SymmetricZobrist() board too large");
+            assert(((nSymmetries == 0) || (nSymmetries == 1) || (nSymmetries == 2) || (nSymmetries == 4) || ((nSymmetries == 8) && (nWidth == nHeight))) &&
+                   "SymmetricZobrist() not a symmetry of the board");
+        }
+
+        // Place or remove a player's token on a square
+        void Toggle(int nPlayer, int nX, int nY);
+        // Turn a token over from one player to the other
+        void Flip(int nX, int nY)                    { Toggle(1, nX, nY); Toggle(2, nX, nY); }
+
+        // Return the lowest key of the position under its symmetries
+        uint64_t Key() const;
+        // Return the number of symmetries kept
+        int  Symmetries() const                      { return m_knSymmetries; }
+
+    private:
+        // Board dimensions, and the number of symmetries kept
+        const int m_knWidth;
+        const int m_knHeight;
+        const int m_knSymmetries;
+
+        // The key under each symmetry
+        uint64_t m_auiKeys[m_knMaxSymmetries] {};
+};
+
+/**
+  * Place or remove a token.
+  *
+  * Map the square under each symmetry and toggle the Zobrist key of the
+  * player's stone on the square it is mapped to.
+  *
+  * \param nPlayer The player whose token it is
+  * \param nX      X-coordinate of the square
+  * \param nY      Y-coordinate of the square
+  */
+
+inline void SymmetricZobrist::Toggle(int nPlayer, int nX, int nY)
+{
+    const int knRX = m_knWidth - 1 - nX;
+    const int knRY = m_knHeight - 1 - nY;
+
+    // The square under each symmetry: itself, mirror images, half turn,
+    // diagonal reflections, and quarter turns
+    const int kanX[m_knMaxSymmetries] {nX, knRX, nX,  knRX, nY, knRY, knRY, nY};
+    const int kanY[m_knMaxSymmetries] {nY, nY,   knRY, knRY, nX, knRX, nX,  knRX};
+
+    for (int nSymmetry = 0; nSymmetry < m_knSymmetries; ++nSymmetry)
+        m_auiKeys[nSymmetry] ^= Zobrist::Stone(nPlayer, kanX[nSymmetry] + (kanY[nSymmetry] * m_knWidth));
+}
+
+/**
+  * Return the key of the position.
+  *
+  * \return The lowest of the keys under the symmetries.
+  */
+
+inline uint64_t SymmetricZobrist::Key() const
+{
+    uint64_t uiKey = m_auiKeys[0];
+
+    for (int nSymmetry = 1; nSymmetry < m_knSymmetries; ++nSymmetry)
+    {
+        if (m_auiKeys[nSymmetry] < uiKey)
+            uiKey = m_auiKeys[nSymmetry];
+    }
+
+    return uiKey;
+}
+
+#endif // SYMMETRICZOBRIST_H
@@ -28,19 +28,22 @@
 
 #include "LinearGame.h"
 
-class TTT : public LinearGame
+class TTT : public LinearGame<LinearLines<3, 3, 3>>
 {
     public:
         // Constructor
-        explicit TTT(GameType ecGameType) : LinearGame(ecGameType, 3, 3, 'X', 'O', 3, true, true, true, true) {}
+        explicit TTT(GameType ecGameType) : LinearGame(ecGameType, 'X', 'O', 8, true, true, true, true) {}
         // Destructor
         ~TTT() {}
 
-        // Generate a vector of valis moves
-        virtual std::vector<GameMove> GenerateMoves(int nPlayer) override;
+        // Fill a list with the valid moves
+        virtual void GenerateBoardMoves(int nPlayer, MoveList &cMoveList) override;
 
         // Clone the current game
         virtual std::unique_ptr<Game> Clone() const override { return std::unique_ptr<Game>(new TTT(*this)); }
+        // Clone the current game into a buffer of CloneSize() bytes
+        virtual Game *CloneInto(void *pvBuffer) const override { return new (pvBuffer) TTT(*this); }
+        virtual size_t CloneSize() const override { return sizeof(TTT); }
 
         // Return the title of the game
         virtual std::string Title() const override { return "Tic-Tac-Toe"; }
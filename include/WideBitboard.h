@@ -0,0 +1,286 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The WideBitboard class template is a set of the squares of a
+ * board too large for one 64-bit word, held in as many words as it needs.
+ *
+ * Squares are numbered along the X-coordinate first, with one guard square
+ * past the end of each row, so that a step east or west is a shift by one
+ * bit, and a step north or south a shift by one row, without a square
+ * stepping off one edge of the board onto the other.  Bits shifted onto a
+ * guard square, or off the rows of the board, are cleared by masking with
+ * the squares of the board.
+ *
+ */
+
+#ifndef WIDEBITBOARD_H
+#define WIDEBITBOARD_H
+
+#include <array>
+#include <cstdint>
+
+template <int nX, int nY>
+class WideBitboard
+{
+    public:
+        // Board dimensions, and the bits of a row, its squares and a guard square
+        static const int m_knX      {nX};
+        static const int m_knY      {nY};
+        static const int m_knStride {nX + 1};
+
+        // Number of bits and words
+        static const int m_knBits  {m_knStride * nY};
+        static const int m_knWords {(m_knBits + 63) / 64};
+
+        // Convert coordinates to a square, and a square to coordinates
+        static int Square(int nSquareX, int nSquareY) { return nSquareX + (nSquareY * m_knStride); }
+        static int X(int nSquare)                     { return nSquare % m_knStride; }
+        static int Y(int nSquare)                     { return nSquare / m_knStride; }
+
+        // The squares of a board of up to nX by nY
+        static WideBitboard Board(int nBoardX, int nBoardY);
+
+        // Add, remove, and test a square
+        void Set(int nSquare)         { m_auiWords[nSquare / 64] |= UINT64_C(1) << (nSquare % 64); }
+        void Reset(int nSquare)       { m_auiWords[nSquare / 64] &= ~(UINT64_C(1) << (nSquare % 64)); }
+        bool Test(int nSquare) const  { return (m_auiWords[nSquare / 64] >> (nSquare % 64)) & 1; }
+
+        // Return whether no square is in the set, and the number that are
+        bool Empty() const;
+        int  Count() const;
+
+        // Return the lowest square in the set, removing it, or -1 if none is
+        int  PopFirst();
+
+        // Combine sets
+        WideBitboard & operator|=(const WideBitboard &cOther);
+        WideBitboard & operator&=(const WideBitboard &cOther);
+        WideBitboard   operator|(const WideBitboard &cOther) const { WideBitboard cResult(*this); return cResult |= cOther; }
+        WideBitboard   operator&(const WideBitboard &cOther) const { WideBitboard cResult(*this); return cResult &= cOther; }
+        // Return the squares in this set and not in another
+        WideBitboard   Without(const WideBitboard &cOther) const;
+
+        // Return the set shifted toward higher squares, or lower for a negative shift
+        WideBitboard   Shifted(int nShift) const;
+        // Return the squares of the board a king's step or less from the set
+        WideBitboard   Neighbours(const WideBitboard &cBoard) const;
+
+    private:
+        std::array<uint64_t, m_knWords> m_auiWords {};
+};
+
+/**
+  * Return the squares of a board.
+  *
+  * \param nBoardX Number of squares along the X-coordinate
+  * \param nBoardY Number of squares along the Y-coordinate
+  *
+  * \return The set of every square of the board.
+  */
+
+template <int nX, int nY>
+inline WideBitboard<nX, nY> WideBitboard<nX, nY>::Board(int nBoardX, int nBoardY)
+{
+    WideBitboard cBoard;
+
+    for (int yyy = 0; yyy < nBoardY; ++yyy)
+        for (int xxx = 0; xxx < nBoardX; ++xxx)
+            cBoard.Set(Square(xxx, yyy));
+
+    return cBoard;
+}
+
+/**
+  * Return whether the set is empty.
+  *
+  * \return True, if no square is in the set.  False otherwise.
+  */
+
+template <int nX, int nY>
+inline bool WideBitboard<nX, nY>::Empty() const
+{
+    for (uint64_t uiWord : m_auiWords)
+    {
+        if (uiWord != 0)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+  * Count the squares in the set.
+  *
+  * \return The number of squares.
+  */
+
+template <int nX, int nY>
+inline int WideBitboard<nX, nY>::Count() const
+{
+    int nCount {0};
+
+    for (uint64_t uiWord : m_auiWords)
+        nCount += __builtin_popcountll(uiWord);
+
+    return nCount;
+}
+
+/**
+  * Remove the lowest square from the set.
+  *
+  * \return The square, or -1 if the set is empty.
+  */
+
+template <int nX, int nY>
+inline int WideBitboard<nX, nY>::PopFirst()
+{
+    for (int nWord = 0; nWord < m_knWords; ++nWord)
+    {
+        if (m_auiWords[nWord] != 0)
+        {
+            const int knSquare = (nWord * 64) + __builtin_ctzll(m_auiWords[nWord]);
+            m_auiWords[nWord] &= m_auiWords[nWord] - 1;
+            return knSquare;
+        }
+    }
+
+    return -1;
+}
+
+/**
+  * Add the squares of another set.
+  *
+  * \param cOther The other set
+  *
+  * \return This set.
+  */
+
+template <int nX, int nY>
+inline WideBitboard<nX, nY> & WideBitboard<nX, nY>::operator|=(const WideBitboard &cOther)
+{
+    for (int nWord = 0; nWord < m_knWords; ++nWord)
+        m_auiWords[nWord] |= cOther.m_auiWords[nWord];
+
+    return *this;
+}
+
+/**
+  * Keep only the squares also in another set.
+  *
+  * \param cOther The other set
+  *
+  * \return This set.
+  */
+
+template <int nX, int nY>
+inline WideBitboard<nX, nY> & WideBitboard<nX, nY>::operator&=(const WideBitboard &cOther)
+{
+    for (int nWord = 0; nWord < m_knWords; ++nWord)
+        m_auiWords[nWord] &= cOther.m_auiWords[nWord];
+
+    return *this;
+}
+
+/**
+  * Return the squares in this set and not in another.
+  *
+  * \param cOther The other set
+  *
+  * \return The difference of the sets.
+  */
+
+template <int nX, int nY>
+inline WideBitboard<nX, nY> WideBitboard<nX, nY>::Without(const WideBitboard &cOther) const
+{
+    WideBitboard cResult;
+
+    for (int nWord = 0; nWord < m_knWords; ++nWord)
+        cResult.m_auiWords[nWord] = m_auiWords[nWord] & ~cOther.m_auiWords[nWord];
+
+    return cResult;
+}
+
+/**
+  * Shift the set.
+  *
+  * Each word takes its bits from the word the shift moves them out of, and
+  * from the word before or after it for the bits that cross between them.
+  * Bits shifted past the last word, or before the first, are lost.
+  *
+  * \param nShift Number of squares to shift toward higher squares, or, if
+  *               negative, toward lower squares.  Less than 64 either way.
+  *
+  * \return The shifted set.
+  */
+
+template <int nX, int nY>
+inline WideBitboard<nX, nY> WideBitboard<nX, nY>::Shifted(int nShift) const
+{
+    WideBitboard cResult;
+
+    if (nShift > 0)
+    {
+        for (int nWord = m_knWords - 1; nWord >= 0; --nWord)
+        {
+            cResult.m_auiWords[nWord] = m_auiWords[nWord] << nShift;
+            if (nWord > 0)
+                cResult.m_auiWords[nWord] |= m_auiWords[nWord - 1] >> (64 - nShift);
+        }
+    }
+    else if (nShift < 0)
+    {
+        for (int nWord = 0; nWord < m_knWords; ++nWord)
+        {
+            cResult.m_auiWords[nWord] = m_auiWords[nWord] >> -nShift;
+            if (nWord < m_knWords - 1)
+                cResult.m_auiWords[nWord] |= m_auiWords[nWord + 1] << (64 + nShift);
+        }
+    }
+    else
+    {
+        cResult = *this;
+    }
+
+    return cResult;
+}
+
+/**
+  * Return the squares a king's step or less from the set.
+  *
+  * Spread the set one square east and west, then that one row north and
+  * south, and keep what is on the board.  A square spread onto a guard
+  * square is cleared by the mask, rather than reaching the other edge.
+  *
+  * \param cBoard The squares of the board
+  *
+  * \return The set and its neighbours on the board.
+  */
+
+template <int nX, int nY>
+inline WideBitboard<nX, nY> WideBitboard<nX, nY>::Neighbours(const WideBitboard &cBoard) const
+{
+    WideBitboard cRow = *this | Shifted(1) | Shifted(-1);
+    cRow &= cBoard;
+
+    return (cRow | cRow.Shifted(m_knStride) | cRow.Shifted(-m_knStride)) & cBoard;
+}
+
+#endif // WIDEBITBOARD_H
@@ -0,0 +1,90 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *
+ * \brief The Zobrist class provides the random keys used for Zobrist
+ * hashing.
+ *
+ * The keys are produced at compile time by a SplitMix64 generator from a
+ * fixed seed, so every process and every game shares one table and a
+ * position always hashes to the same key.  Keys may therefore be stored on
+ * disk, in an opening book for example.
+ *
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+
+#include "IndexList.h"
+
+class Zobrist
+{
+    public:
+        // Max number of types of pieces and squares covered by the table
+        static const int m_knMaxNumberOfTypesOfPieces {12};
+        static const int m_knNumberOfSquares          {64};
+        // Max number of squares of a board of stones
+        static const int m_knNumberOfStoneSquares     {19 * 19};
+
+        // Key for a type of piece on a square
+        static uint64_t Piece(int nPieceNumber, int nSquare) { return m_kauiKeys[(nPieceNumber * m_knNumberOfSquares) + nSquare]; }
+        // Key for a player's stone on a square of a board of stones
+        static uint64_t Stone(int nPlayer, int nSquare)      { return m_kauiKeys[m_knStoneIndex + ((nPlayer - 1) * m_knNumberOfStoneSquares) + nSquare]; }
+        // Key toggled every time the player to move changes
+        static uint64_t SideToMove()                         { return m_kauiKeys[m_knSideToMoveIndex]; }
+        // Key present while a player may still castle to a side, 0 for west and 1 for east
+        static uint64_t Castling(int nPlayer, int nSide)     { return m_kauiKeys[m_knCastlingIndex + (2 * (nPlayer - 1)) + nSide]; }
+        // Key present while an en passant capture is possible on a file
+        static uint64_t EnPassantFile(int nFile)             { return m_kauiKeys[m_knEnPassantIndex + nFile]; }
+
+        // Return the nth output of a SplitMix64 generator started at uiSeed
+        static constexpr uint64_t SplitMix64(uint64_t uiSeed, uint64_t uiN)
+            { return MixFinal(MixSecond(MixFirst(uiSeed + ((uiN + 1) * m_kuiGoldenGamma)))); }
+
+    private:
+        // Layout of the table
+        static const int m_knSideToMoveIndex {m_knMaxNumberOfTypesOfPieces * m_knNumberOfSquares};
+        static const int m_knCastlingIndex   {m_knSideToMoveIndex + 1};
+        static const int m_knEnPassantIndex  {m_knCastlingIndex + 4};
+        static const int m_knStoneIndex      {m_knEnPassantIndex + 8};
+        static const int m_knNumberOfKeys    {m_knStoneIndex + (2 * m_knNumberOfStoneSquares)};
+
+        // SplitMix64 constants and seed
+        static constexpr uint64_t m_kuiGoldenGamma {0x9E3779B97F4A7C15ULL};
+        static constexpr uint64_t m_kuiSeed        {0x47616D6541492D5AULL};
+
+        // SplitMix64 finalizer, one C++11 constexpr step at a time
+        static constexpr uint64_t MixFirst(uint64_t z)  { return (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL; }
+        static constexpr uint64_t MixSecond(uint64_t z) { return (z ^ (z >> 27)) * 0x94D049BB133111EBULL; }
+        static constexpr uint64_t MixFinal(uint64_t z)  { return z ^ (z >> 31); }
+
+        // Generate the table from a list of indices
+        template <int... anIndices>
+        static constexpr std::array<uint64_t, sizeof...(anIndices)> MakeKeys(IndexList<anIndices...>)
+            { return {{ SplitMix64(m_kuiSeed, anIndices)... }}; }
+
+        // The keys
+        static const std::array<uint64_t, m_knNumberOfKeys> m_kauiKeys;
+};
+
+#endif // ZOBRIST_H
@@ -18,11 +18,15 @@
 */
 
 #include <getopt.h>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <vector>
 
 #include "GameAIException.h"
 #include "GameAIVersion.h"
+#include "GameArena.h"
+#include "MoveList.h"
 #include "Player.h"
 #include "Game.h"
 
@@ -52,6 +56,13 @@ static void ShowUsage(std::string sName)
               << "    -p PLIES, --plies=PLIES   assign the number of PLIES that ai players will use\n"
               << "              --plies1=PLIES  assign the number of PLIES to Player 1, if ai\n"
               << "              --plies2=PLIES  assign the number of PLIES to Player 2, if ai\n"
+              << "    -s,       --solve         solve GAME for perfect moves instead of searching PLIES, if ai\n"
+              << "              --book=FILE     read solved openings of GAME from FILE, if solving\n"
+              << "              --bookgen=PLIES solve the openings of GAME to PLIES, write them to FILE, and exit\n"
+              << "              --endgame=EMPTIES solve the endgame of GAME once EMPTIES squares are left, if ai\n"
+              << "              --weights=FILE  evaluate GAME with pattern weights read from FILE, if ai\n"
+              << "              --tune=GAMES    tune pattern weights of GAME to GAMES played at random, write them to FILE, and exit\n"
+              << "              --benchmark=PLIES search every move of GAME to PLIES, display evaluations per second, and exit\n"
               << "    -v LEVEL, --verbose=LEVEL display game information\n"
               << "    -V,       --version       display version and exit\n"
               << "    -H,       --help          display this help message and exit\n"
@@ -60,12 +71,17 @@ static void ShowUsage(std::string sName)
               << "HOST is a host name or address for a server.  The default is 127.0.0.1.\n"
               << "TYPE is either human, ai, client, or server.  Start a server before staring a client.\n"
               << "PLIES are from 1 to 9.  The default is 4.\n"
+              << "GAME is solved for connectfour only.\n"
+              << "PLIES of an opening book are from 0 to 41.  Solving every opening of a book takes hours.\n"
+              << "EMPTIES are for reversi only.  The default is 16; 0 never solves the endgame.\n"
+              << "FILE of weights is for reversi only.\n"
+              << "GAME is benchmarked for board games only.\n"
               << "GAME is one of the following:\n"
               << "    connectfour chess         chess-jm         war\n"
               << "    reversi     chess-attack  chess-los-alamos go-fish\n"
               << "    ttt         chess-baby    chess-petty      rummy\n"
-              << "                chess-elena   chess-quick      \n"
-              << "                chess-gardner chess-speed      \n"
+              << "    gomoku      chess-elena   chess-quick      \n"
+              << "    gomoku19    chess-gardner chess-speed      \n"
               << "LEVEL is an integer 0 to 3.  The default is 1.\n"
               << "    0 = display start and ending announcements\n"
               << "    1 = display game move-by-move\n"
@@ -75,6 +91,14 @@ static void ShowUsage(std::string sName)
               << "Examples:\n"
               << "Start a game on a single computer:\n"
               << "GameAI -1 human -2 ai -g ttt\n\n"
+              << "Compare the evaluations per second of two builds of a game:\n"
+              << "GameAI -g connectfour --benchmark=7\n\n"
+              << "Build a Connect Four opening book once, then solve with it:\n"
+              << "GameAI -g connectfour --bookgen=8 --book=connectfour.book\n"
+              << "GameAI -1 human -2 ai -g connectfour -s --book=connectfour.book\n\n"
+              << "Tune Reversi pattern weights, then play with them:\n"
+              << "GameAI -g reversi --tune=10000 --weights=reversi.weights\n"
+              << "GameAI -1 human -2 ai -g reversi --weights=reversi.weights\n\n"
               << "Start a game across two computers:\n"
               << "GameAI -1 human  -2 client -g connetcfour --port=60001\n"
               << "GameAI -1 server -2 human  -g connectfour --port=60001 --host=192.168.0.1\n"
@@ -93,6 +117,67 @@ static void ShowVersion()
     std::cerr << "Game AI version " << GameAIVersion::SemanticVersion() << " " << GameAIVersion::DateVersion() << std::endl;
 }
 
+/**
+  * Count evaluations.
+  *
+  * Search every move of a game to a depth, through the clones, moves, and
+  * evaluations an AI player uses, and count the evaluations made.
+  *
+  * \param nPlayer The player to move
+  * \param cGame   The game to search
+  * \param nDepth  The number of plies left to search
+  * \param cArena  The arena holding the clones for each ply
+  *
+  * \return The number of evaluations made.
+  */
+
+static long long CountEvaluations(int nPlayer, Game &cGame, int nDepth, GameArena &cArena)
+{
+    MoveList cMoveList;
+
+    if (cGame.GameEndedWithMoves(nPlayer, cMoveList) || (nDepth == 0))
+    {
+        volatile int nScore = cGame.EvaluateGameState(nPlayer);
+        (void)nScore;
+        return 1;
+    }
+
+    long long nEvaluations = 0;
+
+    for (int iii = 0; iii < cMoveList.Size(); ++iii)
+    {
+        Game *pcGameClone = cArena.Clone(nDepth - 1, cGame);
+        pcGameClone->ApplyTrustedBoardMove(nPlayer, cMoveList[iii]);
+        nEvaluations += CountEvaluations(3 - nPlayer, *pcGameClone, nDepth - 1, cArena);
+    }
+
+    cArena.Release(nDepth - 1);
+
+    return nEvaluations;
+}
+
+/**
+  * Benchmark a game.
+  *
+  * Search every move of a game from its start to a number of plies, and
+  * display the evaluations made per second, to compare builds of the game.
+  *
+  * \param cGame  The game to benchmark
+  * \param nPlies The number of plies to search
+  */
+
+static void Benchmark(Game &cGame, int nPlies)
+{
+    GameArena cArena(nPlies);
+
+    std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+    long long nEvaluations = CountEvaluations(1, cGame, nPlies, cArena);
+    std::chrono::duration<double> dSeconds = std::chrono::steady_clock::now() - tStart;
+
+    std::cout << "Evaluations: " << nEvaluations << "  Seconds: " << std::fixed << std::setprecision(3) << dSeconds.count()
+              << "  Evaluations per second: " << std::setprecision(0) << nEvaluations / dSeconds.count() << std::endl;
+}
+
 /**
   * Create the player.
   *
@@ -140,6 +225,10 @@ static std::unique_ptr<Game> GenerateGame(std::string sGame)
         return Game::Make(GameType::TYPE_TTT);
     else if (sGame == "reversi")
         return Game::Make(GameType::TYPE_REVERSI);
+    else if (sGame == "gomoku")
+        return Game::Make(GameType::TYPE_GOMOKU);
+    else if (sGame == "gomoku19")
+        return Game::Make(GameType::TYPE_GOMOKU_19);
     else if (sGame == "chess-gardner")
         return Game::Make(GameType::TYPE_CHESS_GARDNER);
     else if (sGame == "chess-baby")
@@ -308,6 +397,23 @@ int main(int argc, char* argv[])
     // Default verbosity
     int  nVerbosity              {1};
 
+    // Solve the game, instead of searching plies
+    bool bSolve                  {false};
+
+    // Opening book file, and plies to generate it to
+    std::string sBookFile        {};
+    int  nBookPlies              {-1};
+
+    // Empty squares left from which to solve the endgame
+    int  nEndgameEmpties         {-1};
+
+    // Evaluation weights file, and games to tune them to
+    std::string sWeightsFile     {};
+    int  nTuneGames              {-1};
+
+    // Plies to benchmark the game to
+    int  nBenchmarkPlies         {-1};
+
     // Check for command line arguments
     if (argc < 2)
     {
@@ -325,6 +431,13 @@ int main(int argc, char* argv[])
         {"plies",        required_argument, nullptr, 'p'},
         {"plies1",       required_argument, nullptr, 'x'},
         {"plies2",       required_argument, nullptr, 'y'},
+        {"solve",        no_argument,       nullptr, 's'},
+        {"book",         required_argument, nullptr, 'k'},
+        {"bookgen",      required_argument, nullptr, 'l'},
+        {"endgame",      required_argument, nullptr, 'e'},
+        {"weights",      required_argument, nullptr, 'w'},
+        {"tune",         required_argument, nullptr, 'u'},
+        {"benchmark",    required_argument, nullptr, 'a'},
         {"probability1", required_argument, nullptr, 'b'},
         {"probability2", required_argument, nullptr, 'c'},
         {"name1",        required_argument, nullptr, 'n'},
@@ -343,7 +456,7 @@ int main(int argc, char* argv[])
     // Execute getopt_long
     int nC = 0;
     int nOptionIndex = 0;
-    while ((nC = getopt_long(argc, argv, "1:2:p:x:y:b:c:n:m:g:t:h:i:o:v:HV", stLongOptions, &nOptionIndex)) != -1)
+    while ((nC = getopt_long(argc, argv, "1:2:p:x:y:sk:l:e:w:u:a:b:c:n:m:g:t:h:i:o:v:HV", stLongOptions, &nOptionIndex)) != -1)
     {
         switch (nC)
         {
@@ -367,6 +480,34 @@ int main(int argc, char* argv[])
             case 'y':
                 nPlies2 = atoi(optarg);
                 break;
+            // Solve
+            case 's':
+                bSolve = true;
+                break;
+            // Opening book
+            case 'k':
+                sBookFile = optarg;
+                break;
+            // Plies to generate the opening book to
+            case 'l':
+                nBookPlies = atoi(optarg);
+                break;
+            // Empty squares to solve the endgame from
+            case 'e':
+                nEndgameEmpties = atoi(optarg);
+                break;
+            // Evaluation weights
+            case 'w':
+                sWeightsFile = optarg;
+                break;
+            // Games to tune the evaluation weights to
+            case 'u':
+                nTuneGames = atoi(optarg);
+                break;
+            // Plies to benchmark the game to
+            case 'a':
+                nBenchmarkPlies = atoi(optarg);
+                break;
             // Probability for player 1
             case 'b':
                 nProbability1 = atoi(optarg);
@@ -443,6 +584,67 @@ int main(int argc, char* argv[])
     // Generate game
     pcGame = GenerateGame(sGame);
 
+    // Generate an opening book and exit
+    if (nBookPlies >= 0)
+    {
+        if ((pcGame == nullptr) || sBookFile.empty())
+        {
+            ShowUsage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+
+        pcGame->SetVerbosity(nVerbosity);
+
+        if (!pcGame->WriteOpeningBook(sBookFile, nBookPlies))
+        {
+            std::cerr << "could not write opening book " << sBookFile << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        exit(EXIT_SUCCESS);
+    }
+
+    // Tune evaluation weights and exit
+    if (nTuneGames >= 0)
+    {
+        if ((pcGame == nullptr) || sWeightsFile.empty())
+        {
+            ShowUsage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+
+        pcGame->SetVerbosity(nVerbosity);
+
+        if (!pcGame->WriteEvaluationWeights(sWeightsFile, nTuneGames))
+        {
+            std::cerr << "could not write evaluation weights " << sWeightsFile << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        exit(EXIT_SUCCESS);
+    }
+
+    // Benchmark the game and exit
+    if (nBenchmarkPlies >= 0)
+    {
+        if (pcGame == nullptr)
+        {
+            ShowUsage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+
+        if (!pcGame->UsesBoardMoves())
+        {
+            std::cerr << "game " << sGame << " cannot be benchmarked" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        pcGame->SetVerbosity(0);
+        Benchmark(*pcGame, nBenchmarkPlies);
+
+        exit(EXIT_SUCCESS);
+    }
+
     // Generate players
     if (!GeneratePlayer(sPlayer1, vPlayers))
     {
@@ -468,6 +670,36 @@ int main(int argc, char* argv[])
         sPlayer1Name, sPlayer2Name, nVerbosity, pcGame->Title(),
         sHost, nPort, vPlayers);
 
+    // Set AI players to solve the game
+    if (bSolve)
+    {
+        if (!pcGame->Solvable())
+        {
+            std::cerr << "game " << sGame << " cannot be solved" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        vPlayers[0]->SetSolve(true);
+        vPlayers[1]->SetSolve(true);
+
+        if (!sBookFile.empty() && !pcGame->ReadOpeningBook(sBookFile))
+        {
+            std::cerr << "could not read opening book " << sBookFile << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Set the empty squares to solve the endgame from
+    if (nEndgameEmpties >= 0)
+        pcGame->SetEndgameEmpties(nEndgameEmpties);
+
+    // Read the weights to evaluate the game with
+    if (!sWeightsFile.empty() && !pcGame->ReadEvaluationWeights(sWeightsFile))
+    {
+        std::cerr << "could not read evaluation weights " << sWeightsFile << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
     // Set verbosity of game
     pcGame->SetVerbosity(nVerbosity);
 
@@ -505,7 +737,11 @@ int main(int argc, char* argv[])
         std::cout << " Type " << vPlayers[iii]->TypeName();
         if (vPlayers[iii]->Type() == PlayerType::TYPE_AI)
         {
-            if (pcGame->EnvironmentDeterministic())
+            if (vPlayers[iii]->Solve())
+            {
+                std::cout << " Solving";
+            }
+            else if (pcGame->EnvironmentDeterministic())
             {
                 std::cout << " Plies: " << vPlayers[iii]->Plies();
             }
@@ -22,8 +22,9 @@
 /**
   * Make a move.
   *
-  * Call MinimaxMove or BlackboardMove to generate the best game move and
-  * apply it to the game.
+  * Call MinimaxMove or BlackboardMove to generate the best game move, or
+  * have the game solve for it, if told to or if the game has reached an
+  * endgame it solves, and apply it to the game.
   *
   * \param cGame The game.
   *
@@ -74,9 +75,20 @@ bool AIPlayer::Move(Game &cGame)
     }
 
     // Get best game move
-    if (cGame.EnvironmentDeterministic())
+    if ((m_bSolve && cGame.Solvable()) || cGame.EndgameSolvable())
     {
-        cGameMove = MinimaxMove(m_nPlayerNumber, cGame, m_nDepth);
+        cGameMove = cGame.SolvedMove(m_nPlayerNumber);
+    }
+    else if (cGame.EnvironmentDeterministic() && cGame.ThreatMove(m_nPlayerNumber, cGameMove))
+    {
+        m_cLogger.LogInfo("Forced win found by threat search", 2);
+    }
+    else if (cGame.EnvironmentDeterministic())
+    {
+        if (cGame.UsesBoardMoves())
+            cGameMove = MinimaxMove<MoveList>(m_nPlayerNumber, cGame, m_nDepth);
+        else
+            cGameMove = MinimaxMove<std::vector<GameMove>>(m_nPlayerNumber, cGame, m_nDepth);
     }
     else
     {
@@ -107,7 +119,13 @@ bool AIPlayer::Move(Game &cGame)
   * Evaluate moves and return the best move for this player.
   *
   * Use the minimax algorithm, with alpha-beta pruning, to determine the
-  * best move.
+  * best move.  Board games are searched with the compact BoardMove, kept
+  * in a MoveList per ply; other games with a vector of GameMoves.  The
+  * lists for every ply, and the arena slots that the clones at every ply
+  * are made in, are created here, once per search, and reused by every
+  * node at that ply.  Either way, the best move is returned as a GameMove.
+  * If the game keys its positions, a position searched before to the same
+  * depth, or one symmetric to it, is scored from the transposition table.
   *
   * \param nPlayer The player whose turn it is.
   * \param cGame   The game
@@ -116,6 +134,7 @@ bool AIPlayer::Move(Game &cGame)
   * \return The best game move.
   */
 
+template <typename List>
 GameMove AIPlayer::MinimaxMove(int nPlayer, Game &cGame, int nDepth)
 {
     // Initialize the best score for a move to the minimum integer
@@ -128,11 +147,22 @@ GameMove AIPlayer::MinimaxMove(int nPlayer, Game &cGame, int nDepth)
     // Used for logging
     std::string sMessage;
 
+    // The lists of moves, one for each ply of the search
+    std::vector<List> vMoveStack(nDepth + 1);
+    // The clones of the game, one for each ply below this one
+    GameArena cArena(nDepth);
+
+    // Make the transposition table, if the game keys its positions
+    uint64_t uiKey;
+    if (m_vstTranspositions.empty() && cGame.CanonicalKey(uiKey))
+        m_vstTranspositions.resize(m_knTranspositions);
+
     // Generate all possible valid moves for this player
-    std::vector<GameMove> vGameMoves = cGame.GenerateMoves(nPlayer);
+    List &vMoves = vMoveStack[nDepth];
+    GenerateMoves(cGame, nPlayer, vMoves);
 
     // If no valid moves are possible, return a "no move"
-    if (vGameMoves.empty())
+    if (vMoves.empty())
     {
         GameMove cNoMove = GameMove();
         cNoMove.SetNoMove(true);
@@ -140,22 +170,23 @@ GameMove AIPlayer::MinimaxMove(int nPlayer, Game &cGame, int nDepth)
     }
 
     // If only one move valid, return it
-    if (vGameMoves.size() == 1)
+    if (vMoves.size() == 1)
     {
-        return vGameMoves[0];
+        return ToGameMove(vMoves[0]);
     }
 
     // As a default, set the first possible move as the best move
-    GameMove cBestMove = vGameMoves[0];
+    GameMove cBestMove = ToGameMove(vMoves[0]);
 
-    float fGameMoves = vGameMoves.size();
+    float fGameMoves = vMoves.size();
     float fPercentComplete = 0.0;
     float fGameMoveEvaluated = 0.0;
 
     // Evaluate all possible moves
-    std::unique_ptr<Game> pcGameClone {};
-    for (GameMove cGameMove : vGameMoves)
+    for (typename List::value_type cMove : vMoves)
     {
+        GameMove cGameMove = ToGameMove(cMove);
+
         // Let them know that we're thinking
         if (m_cLogger.Level() >= 1)
         {
@@ -165,21 +196,27 @@ GameMove AIPlayer::MinimaxMove(int nPlayer, Game &cGame, int nDepth)
         }
 
         // Log the current move evaluation
-        sMessage = "MinimaxMove Player=" + std::to_string(nPlayer) + " Evaluate Move=" + cGameMove.AnnounceFromMove() + cGameMove.AnnounceToMove();
-        m_cLogger.LogInfo(sMessage,3);
+        if (m_cLogger.Level() >= 3)
+        {
+            sMessage = "MinimaxMove Player=" + std::to_string(nPlayer) + " Evaluate Move=" + cGameMove.AnnounceFromMove() + cGameMove.AnnounceToMove();
+            m_cLogger.LogInfo(sMessage,3);
+        }
 
-        // Clone the game
-        pcGameClone = cGame.Clone();
+        // Clone the game into the slot for the next ply
+        Game *pcGameClone = cArena.Clone(nDepth - 1, cGame);
 
         // Apply the move to the game clone
-        pcGameClone->ApplyMove(nPlayer, cGameMove);
+        ApplyMove(*pcGameClone, nPlayer, cMove);
 
         // Return the score of this applied move by calling the minimizing player's move evaluation
-        int nScore = MinMove(3 - nPlayer, *pcGameClone, nDepth - 1, nAlpha, nBeta);
+        int nScore = MinMove<List>(3 - nPlayer, *pcGameClone, nDepth - 1, nAlpha, nBeta, vMoveStack, cArena);
 
         // Log the evaluated moves score
-        sMessage = "MinimaxMove Move=" + cGameMove.AnnounceFromMove()+ cGameMove.AnnounceToMove() + " Score=" + std::to_string(nScore);
-        m_cLogger.LogInfo(sMessage, 2);
+        if (m_cLogger.Level() >= 2)
+        {
+            sMessage = "MinimaxMove Move=" + cGameMove.AnnounceFromMove()+ cGameMove.AnnounceToMove() + " Score=" + std::to_string(nScore);
+            m_cLogger.LogInfo(sMessage, 2);
+        }
 
         // If the current move's score is equal to the best move's score, ask the game to
         // determine a perferred move
@@ -214,55 +251,87 @@ GameMove AIPlayer::MinimaxMove(int nPlayer, Game &cGame, int nDepth)
   * \param nDepth  The number of plies (depth) to evaluate possible game moves
   * \param nAlpha  The alpha (maximizing) score
   * \param nBeta   The beta (minimizing) score
+  * \param vMoveStack The lists of moves for each ply
+  * \param cArena  The arena holding the clones for each ply
   *
   * \return The beta score.
   */
 
-int AIPlayer::MinMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta)
+template <typename List>
+int AIPlayer::MinMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta, std::vector<List> &vMoveStack, GameArena &cArena)
 {
     // Used for logging messages
     std::string sMessage;
 
+    // A position searched to this depth before, or one symmetric to it, may
+    // be scored from the bounds found then
+    uint64_t uiKey {0};
+    const bool kbKeyed = (nDepth > 0) && TranspositionKey(cGame, nPlayer, uiKey);
+    int nStoredScore {0};
+    if (kbKeyed && ProbeTransposition(uiKey, nDepth, nAlpha, nBeta, nStoredScore))
+        return nStoredScore;
+
+    // The window searched, kept for the bound found
+    const int knAlpha = nAlpha;
+    const int knBeta  = nBeta;
+
+    // Valid moves for the minimizing player, generated while checking for the end of
+    // the game; at the depth of the search, only the end of the game is checked
+    List &vMoves = vMoveStack[nDepth];
+    bool bGameEnded = (nDepth == 0) ? cGame.GameEnded(nPlayer) : GameEndedWithMoves(cGame, nPlayer, vMoves);
+
     // If the game has ended or we have reached the depth of the search,
     // return the score of the game state evaluation from the Min Player perspective
-    if (cGame.GameEnded(nPlayer) || nDepth == 0)
+    if (bGameEnded || nDepth == 0)
         //// TODO: consider modifying the score from the game state evaluation by the depth of the search
         ////return cGame.EvaluateGameState(3 - nPlayer) * (nDepth + 1);
         return cGame.EvaluateGameState(3 - nPlayer);
 
-    // Generate all possible valid moves for the minimizig player
-    std::vector<GameMove> vGameMoves = cGame.GenerateMoves(nPlayer);
+    // Building log messages is costly, so only do so when they will be logged
+    const bool kbLog = (m_cLogger.Level() >= 3);
 
     // Log the current depth and valid moves
-    sMessage = "MinMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
-        " Valid moves: " + cGame.ValidMoves(nPlayer);
-    m_cLogger.LogInfo(sMessage,3);
+    if (kbLog)
+    {
+        sMessage = "MinMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
+            " Valid moves: " + cGame.ValidMoves(nPlayer);
+        m_cLogger.LogInfo(sMessage,3);
+    }
 
     // Evaluate all possible moves
-    std::unique_ptr<Game> pcGameClone {};
-    for (GameMove cGameMove : vGameMoves)
+    for (typename List::value_type cMove : vMoves)
     {
-        // Clone the game
-        pcGameClone = cGame.Clone();
+        // Clone the game into the slot for the next ply
+        Game *pcGameClone = cArena.Clone(nDepth - 1, cGame);
 
         // Apply the move to the game clone
-        pcGameClone->ApplyMove(nPlayer, cGameMove);
+        ApplyMove(*pcGameClone, nPlayer, cMove);
 
         // Return the score of this applied move by calling the maximizing player's move evaluation
-        int nScore = MaxMove(3 - nPlayer, *pcGameClone, nDepth - 1, nAlpha, nBeta);
+        int nScore = MaxMove<List>(3 - nPlayer, *pcGameClone, nDepth - 1, nAlpha, nBeta, vMoveStack, cArena);
 
         // Log the evaluated moves score
-        sMessage = "MinMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
-            " Move=" + cGameMove.AnnounceFromMove() + cGameMove.AnnounceToMove() +
-            " Score=" + std::to_string(nScore);
+        if (kbLog)
+        {
+            GameMove cGameMove = ToGameMove(cMove);
+            sMessage = "MinMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
+                " Move=" + cGameMove.AnnounceFromMove() + cGameMove.AnnounceToMove() +
+                " Score=" + std::to_string(nScore);
+        }
 
         // If the score of the current move is less than or equal to the alpha
         // maximizing score, return alpha
         if (nScore <= nAlpha)
         {
             // Complete log message
-            sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "] alpha-cutoff";
-            m_cLogger.LogInfo(sMessage,3);
+            if (kbLog)
+            {
+                sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "] alpha-cutoff";
+                m_cLogger.LogInfo(sMessage,3);
+            }
+
+            if (kbKeyed)
+                StoreTransposition(uiKey, nDepth, knAlpha, knBeta, nAlpha);
 
             return nAlpha; // fail hard alpha-cutoff
         }
@@ -273,59 +342,95 @@ int AIPlayer::MinMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBet
             nBeta = nScore; // nBeta acts like min
 
         // Complete log message
-        sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "]";
-        m_cLogger.LogInfo(sMessage,3);
+        if (kbLog)
+        {
+            sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "]";
+            m_cLogger.LogInfo(sMessage,3);
+        }
     }
 
+    if (kbKeyed)
+        StoreTransposition(uiKey, nDepth, knAlpha, knBeta, nBeta);
+
     return nBeta;
 }
 
-int AIPlayer::MaxMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta)
+template <typename List>
+int AIPlayer::MaxMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBeta, std::vector<List> &vMoveStack, GameArena &cArena)
 {
     // Used for logging messages
     std::string sMessage;
 
+    // A position searched to this depth before, or one symmetric to it, may
+    // be scored from the bounds found then
+    uint64_t uiKey {0};
+    const bool kbKeyed = (nDepth > 0) && TranspositionKey(cGame, nPlayer, uiKey);
+    int nStoredScore {0};
+    if (kbKeyed && ProbeTransposition(uiKey, nDepth, nAlpha, nBeta, nStoredScore))
+        return nStoredScore;
+
+    // The window searched, kept for the bound found
+    const int knAlpha = nAlpha;
+    const int knBeta  = nBeta;
+
+    // Valid moves for the maximizing player, generated while checking for the end of
+    // the game; at the depth of the search, only the end of the game is checked
+    List &vMoves = vMoveStack[nDepth];
+    bool bGameEnded = (nDepth == 0) ? cGame.GameEnded(nPlayer) : GameEndedWithMoves(cGame, nPlayer, vMoves);
+
     // If the game has ended or we have reached the depth of the search,
     // return the score of the game state evaluation from the Max Player perspective
-    if (cGame.GameEnded(nPlayer) || nDepth == 0)
+    if (bGameEnded || nDepth == 0)
         //// TODO: consider modifying the score from the game state evaluation by the depth of the search
         //return cGame.EvaluateGameState(nPlayer) * (nDepth + 1);
         return cGame.EvaluateGameState(nPlayer);
 
-    // Generate all possible valid moves for the maximizing player
-    std::vector<GameMove> vGameMoves = cGame.GenerateMoves(nPlayer);
+    // Building log messages is costly, so only do so when they will be logged
+    const bool kbLog = (m_cLogger.Level() >= 3);
 
     // Log the current depth and valid moves
-    sMessage = "MaxMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
-        " Valid moves: " + cGame.ValidMoves(nPlayer);
-    m_cLogger.LogInfo(sMessage,3);
+    if (kbLog)
+    {
+        sMessage = "MaxMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
+            " Valid moves: " + cGame.ValidMoves(nPlayer);
+        m_cLogger.LogInfo(sMessage,3);
+    }
 
     // Evaluate all possible moves
 
-    std::unique_ptr<Game> pcGameClone {};
-    for (GameMove cGameMove : vGameMoves)
+    for (typename List::value_type cMove : vMoves)
     {
-        // Clone the game
-        pcGameClone = cGame.Clone();
+        // Clone the game into the slot for the next ply
+        Game *pcGameClone = cArena.Clone(nDepth - 1, cGame);
 
         // Apply the move to the game clone
-        pcGameClone->ApplyMove(nPlayer, cGameMove);
+        ApplyMove(*pcGameClone, nPlayer, cMove);
 
         // Return the score of this applied move by calling the maximizing player's move evaluation
-        int nScore = MinMove(3 - nPlayer, *pcGameClone, nDepth -1, nAlpha, nBeta);
+        int nScore = MinMove<List>(3 - nPlayer, *pcGameClone, nDepth -1, nAlpha, nBeta, vMoveStack, cArena);
 
         // Log the evaluated moves score
-        sMessage = "MaxMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
-            cGameMove.AnnounceFromMove() + " Move=" + cGameMove.AnnounceToMove() +
-            " Score=" + std::to_string(nScore);
+        if (kbLog)
+        {
+            GameMove cGameMove = ToGameMove(cMove);
+            sMessage = "MaxMove Depth=" + std::to_string(nDepth) + " Player=" + std::to_string(nPlayer) +
+                cGameMove.AnnounceFromMove() + " Move=" + cGameMove.AnnounceToMove() +
+                " Score=" + std::to_string(nScore);
+        }
 
         // If the score of the current move is greater than or equal to the beta
         // minimizing score, return beta
         if (nScore >= nBeta)
         {
             // Complete log message
-            sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "] beta-cutoff";
-            m_cLogger.LogInfo(sMessage,3);
+            if (kbLog)
+            {
+                sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "] beta-cutoff";
+                m_cLogger.LogInfo(sMessage,3);
+            }
+
+            if (kbKeyed)
+                StoreTransposition(uiKey, nDepth, knAlpha, knBeta, nBeta);
 
             return nBeta; // fail hard beta-cutoff
         }
@@ -336,9 +441,93 @@ int AIPlayer::MaxMove(int nPlayer, Game &cGame, int nDepth, int nAlpha, int nBet
             nAlpha = nScore; // nAlpha acts like a max
 
         // Complete log message
-        sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "]";
-        m_cLogger.LogInfo(sMessage,3);
+        if (kbLog)
+        {
+            sMessage += " [Alpha=" + std::to_string(nAlpha) + " Beta=" + std::to_string(nBeta) + "]";
+            m_cLogger.LogInfo(sMessage,3);
+        }
     }
 
+    if (kbKeyed)
+        StoreTransposition(uiKey, nDepth, knAlpha, knBeta, nAlpha);
+
     return nAlpha;
 }
+
+/**
+  * Score a position from the transposition table.
+  *
+  * The bounds kept for a position decide its score within a window if they
+  * put it at or below alpha, at or above beta, or at one value.  As the
+  * search fails hard, the score is then alpha, beta, or that value.
+  *
+  * \param uiKey  The key of the position and the player to move
+  * \param nDepth The number of plies searched below the position
+  * \param nAlpha The alpha (maximizing) score
+  * \param nBeta  The beta (minimizing) score
+  * \param nScore The score, if decided
+  *
+  * \return True if the bounds decide the score.  False otherwise.
+  */
+
+bool AIPlayer::ProbeTransposition(uint64_t uiKey, int nDepth, int nAlpha, int nBeta, int &nScore) const
+{
+    const Transposition &kstEntry = m_vstTranspositions[uiKey & (m_knTranspositions - 1)];
+
+    if ((kstEntry.uiKey != uiKey) || (kstEntry.nDepth != nDepth))
+        return false;
+
+    if (kstEntry.nLower >= nBeta)
+        nScore = nBeta;
+    else if (kstEntry.nUpper <= nAlpha)
+        nScore = nAlpha;
+    else if (kstEntry.nLower == kstEntry.nUpper)
+        nScore = kstEntry.nLower;
+    else
+        return false;
+
+    return true;
+}
+
+/**
+  * Keep the bound on a position found by a search.
+  *
+  * A score at or below alpha is an upper bound, at or above beta a lower
+  * bound, and between them the score itself.  The bound is added to those
+  * already kept for the position at the same depth; any other position in
+  * its slot is replaced.
+  *
+  * \param uiKey  The key of the position and the player to move
+  * \param nDepth The number of plies searched below the position
+  * \param nAlpha The alpha (maximizing) score of the search
+  * \param nBeta  The beta (minimizing) score of the search
+  * \param nScore The score the search returned
+  */
+
+void AIPlayer::StoreTransposition(uint64_t uiKey, int nDepth, int nAlpha, int nBeta, int nScore)
+{
+    Transposition &stEntry = m_vstTranspositions[uiKey & (m_knTranspositions - 1)];
+
+    if ((stEntry.uiKey != uiKey) || (stEntry.nDepth != nDepth))
+    {
+        stEntry = Transposition();
+        stEntry.uiKey  = uiKey;
+        stEntry.nDepth = nDepth;
+    }
+
+    if (nScore <= nAlpha)
+    {
+        if (nScore < stEntry.nUpper)
+            stEntry.nUpper = nScore;
+    }
+    else if (nScore >= nBeta)
+    {
+        if (nScore > stEntry.nLower)
+            stEntry.nLower = nScore;
+    }
+    else
+    {
+        stEntry.nLower = nScore;
+        stEntry.nUpper = nScore;
+    }
+}
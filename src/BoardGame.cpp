@@ -19,6 +19,8 @@
 
 #include "BoardGame.h"
 
+#include "StoneBoard.h"
+
 /**
   * Display the game board.
   *
@@ -27,7 +29,8 @@
   *
   */
 
-void BoardGame::Display() const
+template <class Board>
+void BoardGame<Board>::Display() const
 {
     cBoard.Display();
 }
@@ -43,7 +46,8 @@ void BoardGame::Display() const
   * \return True if information is available to be sent, false otherwise.
   */
 
-bool BoardGame::GetSyncInfo(std::string &sGameInformation)
+template <class Board>
+bool BoardGame<Board>::GetSyncInfo(std::string &sGameInformation)
 {
     (void) sGameInformation;
     return false;
@@ -57,7 +61,8 @@ bool BoardGame::GetSyncInfo(std::string &sGameInformation)
   * \return True if information is available to be sent, false otherwise.
   */
 
-bool BoardGame::ApplySyncInfo(const std::string &sGameInformation, std::string &sErrorMessage)
+template <class Board>
+bool BoardGame<Board>::ApplySyncInfo(const std::string &sGameInformation, std::string &sErrorMessage)
 {
     (void) sGameInformation;
     (void) sErrorMessage;
@@ -65,6 +70,60 @@ bool BoardGame::ApplySyncInfo(const std::string &sGameInformation, std::string &
 }
 
 
+/**
+  * Apply a move to the game.
+  *
+  * Check the player number and record a resignation.  Otherwise convert the
+  * move to a BoardMove and apply it with ApplyBoardMove().
+  *
+  * \param nPlayer   The player whose turn it is.
+  * \param cGameMove The player's move
+  *
+  * \return True, if valid.  False otherwise.
+  */
+
+template <class Board>
+bool BoardGame<Board>::ApplyMove(int nPlayer, GameMove &cGameMove)
+{
+    // Check player number
+    if ((nPlayer != m_knPlayer1) && (nPlayer != m_knPlayer2))
+        return false;
+
+    // Check for resignation
+    if (cGameMove.Resignation())
+    {
+        // Capture move for later playback or analysis
+        m_cGameMoves.Push(cGameMove);
+        return true;
+    }
+
+    return ApplyBoardMove(nPlayer, BoardMove(cGameMove));
+}
+
+/**
+  * Return a vector of valid game moves.
+  *
+  * Call GenerateBoardMoves and convert each move to a GameMove.
+  *
+  * \param nPlayer The player whose turn it is.
+  *
+  * \return A vector of valid moves.
+  */
+
+template <class Board>
+std::vector<GameMove> BoardGame<Board>::GenerateMoves(int nPlayer)
+{
+    std::vector<GameMove> vGameMoves {};
+    MoveList cMoveList;
+
+    GenerateBoardMoves(nPlayer, cMoveList);
+
+    for (const BoardMove &cBoardMove : cMoveList)
+        vGameMoves.push_back(cBoardMove.ToGameMove());
+
+    return vGameMoves;
+}
+
 /**
   * Return a string of valid moves.
   *
@@ -75,7 +134,8 @@ bool BoardGame::ApplySyncInfo(const std::string &sGameInformation, std::string &
   * \return A string of valid moves.
   */
 
-std::string BoardGame::ValidMoves(int nPlayer)
+template <class Board>
+std::string BoardGame<Board>::ValidMoves(int nPlayer)
 {
     std::string sValidMoves {};
 
@@ -106,7 +166,8 @@ std::string BoardGame::ValidMoves(int nPlayer)
   * \return A GameMove object.
   */
 
-GameMove BoardGame::GetMove(int nPlayer) const
+template <class Board>
+GameMove BoardGame<Board>::GetMove(int nPlayer) const
 {
     (void)nPlayer;
 
@@ -129,7 +190,8 @@ GameMove BoardGame::GetMove(int nPlayer) const
   */
 
 
-GameMove BoardGame::GenerateMove(std::string sMove) const
+template <class Board>
+GameMove BoardGame<Board>::GenerateMove(std::string sMove) const
 {
     // Generic GamevMove
     GameMove cGameMove(-1, -1, -1, -1, false, false);
@@ -159,7 +221,8 @@ GameMove BoardGame::GenerateMove(std::string sMove) const
   * \return 0
   */
 
-int BoardGame::PreferredMove(const GameMove &cGameMove) const
+template <class Board>
+int BoardGame<Board>::PreferredMove(const GameMove &cGameMove) const
 {
     (void)cGameMove;
 
@@ -174,7 +237,8 @@ int BoardGame::PreferredMove(const GameMove &cGameMove) const
   * \return ""
   */
 
-std::string BoardGame::GameScore() const
+template <class Board>
+std::string BoardGame<Board>::GameScore() const
 {
     return "";
 }
@@ -189,15 +253,16 @@ std::string BoardGame::GameScore() const
   * \return True, if any player has won the game.  False otherwise.
   */
 
-bool BoardGame::GameEnded(int nPlayer)
+template <class Board>
+bool BoardGame<Board>::GameEnded(int nPlayer)
 {
-    if (!m_vGameMoves.empty())
+    if (!m_cGameMoves.Empty())
     {
-        GameMove cGameMove = m_vGameMoves.back();
+        GameMove cGameMove = m_cGameMoves.Back();
         if (cGameMove.Resignation())
         {
             m_nWinner = nPlayer;
-            m_sWinBy.assign("resignation");
+            SetOutcome(GameOutcome::OUTCOME_RESIGNATION);
             m_bGameOver = true;
             return true;
         }
@@ -205,3 +270,7 @@ bool BoardGame::GameEnded(int nPlayer)
 
     return false;
 }
+
+// The board of each kind of board game
+template class BoardGame<GameBoard>;     // Games of pieces
+template class BoardGame<StoneBoard>;    // Games of stones on boards larger than a GameBoard
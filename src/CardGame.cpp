@@ -448,13 +448,13 @@ std::string CardGame::GameScore() const
 
 bool CardGame::GameEnded(int nPlayer)
 {
-    if (!m_vGameMoves.empty())
+    if (!m_cGameMoves.Empty())
     {
-        GameMove cGameMove = m_vGameMoves.back();
+        GameMove cGameMove = m_cGameMoves.Back();
         if (cGameMove.Resignation())
         {
             m_nWinner = nPlayer;
-            m_sWinBy.assign("resignation");
+            SetOutcome(GameOutcome::OUTCOME_RESIGNATION);
             m_bGameOver = true;
             return true;
         }
@@ -536,7 +536,7 @@ bool CardGameBasicRummy::ApplyMove(int nPlayer, GameMove &cGameMove)
     if (cGameMove.Resignation())
     {
         // Capture move for network play
-        m_vGameMoves.push_back(cGameMove);
+        m_cGameMoves.Push(cGameMove);
         return true;
     }
 
@@ -546,7 +546,7 @@ bool CardGameBasicRummy::ApplyMove(int nPlayer, GameMove &cGameMove)
         cGameMove.SetAnotherTurn(true);
         cGameMove.SetPlayerNumber(nPlayer);
         // Capture move for network play
-        m_vGameMoves.push_back(cGameMove);
+        m_cGameMoves.Push(cGameMove);
 
         // Display game
         for (Hand &cHand : m_vHands)
@@ -567,7 +567,7 @@ bool CardGameBasicRummy::ApplyMove(int nPlayer, GameMove &cGameMove)
         cGameMove.SetAnotherTurn(true);
         cGameMove.SetPlayerNumber(nPlayer);
         // Capture move for network play
-        m_vGameMoves.push_back(cGameMove);
+        m_cGameMoves.Push(cGameMove);
 
         return true;
     }
@@ -664,7 +664,7 @@ bool CardGameBasicRummy::ApplyMove(int nPlayer, GameMove &cGameMove)
     ++m_nNumberOfMoves;
 
     // Capture move for network play
-    m_vGameMoves.push_back(cGameMove);
+    m_cGameMoves.Push(cGameMove);
 
     return true;
 }
@@ -829,7 +829,7 @@ bool CardGameBasicRummy::GameEnded(int nPlayer)
 
     // Clear win variables
     m_nWinner = -1;
-    m_sWinBy.assign("nothing");
+    SetOutcome(GameOutcome::OUTCOME_NOTHING);
 
     if (CardGame::GameEnded(nPlayer))
         return true;
@@ -906,7 +906,7 @@ bool CardGameBasicRummy::GameEnded(int nPlayer)
     if (Score(nThisPlayer) >= TargetScore())
     {
         m_nWinner = nThisPlayer;
-        m_sWinBy = "having " + std::to_string(Score(nThisPlayer)) + " points.";
+        SetOutcome(GameOutcome::OUTCOME_POINTS, Score(nThisPlayer));
         m_bGameOver = true;
         return true;
     }
@@ -914,7 +914,7 @@ bool CardGameBasicRummy::GameEnded(int nPlayer)
     else if (Score(nPlayer) >= TargetScore())
     {
         m_nWinner = nPlayer;
-        m_sWinBy = "having " + std::to_string(Score(nPlayer)) + " points.";
+        SetOutcome(GameOutcome::OUTCOME_POINTS, Score(nPlayer));
         m_bGameOver = true;
         return true;
     }
@@ -216,7 +216,7 @@ bool CardGameGoFish::ApplyMove(int nPlayer, GameMove &cGameMove)
     if (cGameMove.Resignation())
     {
         // Capture move for network play
-        m_vGameMoves.push_back(cGameMove);
+        m_cGameMoves.Push(cGameMove);
         return true;
     }
 
@@ -226,7 +226,7 @@ bool CardGameGoFish::ApplyMove(int nPlayer, GameMove &cGameMove)
         cGameMove.SetAnotherTurn(true);
         cGameMove.SetPlayerNumber(nPlayer);
         // Capture move for network play
-        m_vGameMoves.push_back(cGameMove);
+        m_cGameMoves.Push(cGameMove);
 
         // Display game stats
         for (Hand &cHand : m_vHands)
@@ -246,7 +246,7 @@ bool CardGameGoFish::ApplyMove(int nPlayer, GameMove &cGameMove)
         cGameMove.SetAnotherTurn(true);
         cGameMove.SetPlayerNumber(nPlayer);
         // Capture move for network play
-        m_vGameMoves.push_back(cGameMove);
+        m_cGameMoves.Push(cGameMove);
         return true;
     }
 
@@ -346,7 +346,7 @@ bool CardGameGoFish::ApplyMove(int nPlayer, GameMove &cGameMove)
     ++m_nNumberOfMoves;
 
     // Capture move for network play
-    m_vGameMoves.push_back(cGameMove);
+    m_cGameMoves.Push(cGameMove);
 
     return true;
 }
@@ -447,7 +447,7 @@ bool CardGameGoFish::GameEnded(int nPlayer)
 {
     // Clear win variables
     m_nWinner = -1;
-    m_sWinBy.assign("nothing");
+    SetOutcome(GameOutcome::OUTCOME_NOTHING);
 
     if (CardGame::GameEnded(nPlayer))
         return true;
@@ -466,7 +466,7 @@ bool CardGameGoFish::GameEnded(int nPlayer)
             }
         }
 
-        m_sWinBy = "having " + std::to_string(nNumberOfBooks) + " books";
+        SetOutcome(GameOutcome::OUTCOME_BOOKS, nNumberOfBooks);
         m_bGameOver = true;
         return true;
     }
@@ -208,7 +208,7 @@ bool CardGameWar::ApplyMove(int nPlayer, GameMove &cGameMove)
     if (cGameMove.Resignation())
     {
         // Capture move for later playback or analysis
-        m_vGameMoves.push_back(cGameMove);
+        m_cGameMoves.Push(cGameMove);
         return true;
     }
 
@@ -338,7 +338,7 @@ bool CardGameWar::ApplyMove(int nPlayer, GameMove &cGameMove)
         ++m_nNumberOfMoves;
 
     // Capture move for network play
-    m_vGameMoves.push_back(cGameMove);
+    m_cGameMoves.Push(cGameMove);
 
     return true;
 }
@@ -395,7 +395,7 @@ bool CardGameWar::GameEnded(int nPlayer)
 {
     // Clear win variables
     m_nWinner = 0;
-    m_sWinBy.assign("nothing");
+    SetOutcome(GameOutcome::OUTCOME_NOTHING);
 
     if (CardGame::GameEnded(nPlayer))
         return true;
@@ -409,7 +409,7 @@ bool CardGameWar::GameEnded(int nPlayer)
         if (kit == m_uomBattle.end())
         {
             m_nWinner = 3 - nPlayer;
-            m_sWinBy.assign("attrition");
+            SetOutcome(GameOutcome::OUTCOME_ATTRITION);
             m_bGameOver = true;
             return true;
         }
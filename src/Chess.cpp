@@ -83,7 +83,7 @@ void Chess::SetBoard()
     cBoard.SetPiece(6, 6, cPiece);
     cBoard.SetPiece(7, 6, cPiece);
 
-    cBoard.InitializeZobrist();
+    InitializePosition();
 
     return;
 }
@@ -65,7 +65,7 @@ void ChessBaby::SetBoard()
     cBoard.SetPiece(3, 3, cPiece);
     cBoard.SetPiece(4, 3, cPiece);
 
-    cBoard.InitializeZobrist();
+    InitializePosition();
 
     return;
 }
@@ -65,7 +65,7 @@ void ChessElena::SetBoard()
     cBoard.SetPiece(3, 4, cPiece);
     cBoard.SetPiece(4, 4, cPiece);
 
-    cBoard.InitializeZobrist();
+    InitializePosition();
 
     return;
 }
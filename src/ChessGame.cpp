@@ -19,6 +19,14 @@
 
 #include "ChessGame.h"
 
+#include <cassert>
+
+// Mobility step tables
+template <class Rules>
+constexpr int ChessGame<Rules>::m_kaiKingOffsets[8][2];
+template <class Rules>
+constexpr int ChessGame<Rules>::m_kaiKnightOffsets[8][2];
+
 /**
   * Generate a game description.
   *
@@ -28,13 +36,14 @@
   * \return A string containing the game title.
   */
 
-std::string ChessGame::Description() const
+template <class Rules>
+std::string ChessGame<Rules>::Description() const
 {
     std::string sMessage {};
 
     sMessage += "Castling is ";
 
-    if (m_abCastlingAllowed[0])
+    if (Rules::m_kbCastling)
     {
         sMessage += "Allowed";
     }
@@ -45,7 +54,7 @@ std::string ChessGame::Description() const
 
     sMessage += "\nDouble Pawn Move is ";
 
-    if (m_bDoublePawnMoveAllowed)
+    if (Rules::m_kbDoublePawnMove)
     {
         sMessage += "Allowed";
     }
@@ -56,7 +65,7 @@ std::string ChessGame::Description() const
 
     sMessage += "\nEn Passant Move is ";
 
-    if (m_bEnPassantAllowed)
+    if (Rules::m_kbEnPassant)
     {
         sMessage += "Allowed";
     }
@@ -86,7 +95,8 @@ std::string ChessGame::Description() const
   * Call parent class SetBoard and reverse the Y-coordinates
   */
 
-void ChessGame::SetBoard()
+template <class Rules>
+void ChessGame<Rules>::SetBoard()
 {
     BoardGame::SetBoard();
     cBoard.ReverseY();
@@ -100,15 +110,16 @@ void ChessGame::SetBoard()
   *
   * move      ::= <square><square>[promotion]
   * square    ::= <'a'|'b'| ...><'1'|'2'|...>
-  * promotion ::= <'='><piece>      // TODO
-  * piece     ::= <'R'|'N'|'B'|'Q'> // TODO
+  * promotion ::= <'='><piece>
+  * piece     ::= <'R'|'N'|'B'|'Q'>
   *
   * \param sMove A string representing a game move.
   *
   * \return A GameMove object.
   */
 
-GameMove ChessGame::GenerateMove(std::string sMove) const
+template <class Rules>
+GameMove ChessGame<Rules>::GenerateMove(std::string sMove) const
 {
     GameMove cGameMove = BoardGame::GenerateMove(sMove);
 
@@ -122,104 +133,166 @@ GameMove ChessGame::GenerateMove(std::string sMove) const
     cGameMove.SetUseFrom(true);
     cGameMove.SetUseY(true);
 
+    // An unrecognized piece leaves the promotion to be chosen when the move is made
+    if ((sMove.length() > 5) && (sMove[4] == '='))
+    {
+        char cPromotion = toupper(sMove[5]);
+        int  nPromotion = PromotionIndex(cPromotion);
+
+        if (nPromotion != 0)
+            cGameMove.SetPromotion(nPromotion, cPromotion);
+    }
+
     return cGameMove;
 }
 
 /**
-  * Add a move to the vector of game moves after testing the move to see if it
+  * Return the token of a promotion piece.
+  *
+  * \param nPromotion The promotion, as the index of a White piece
+  *
+  * \return The piece token, or the null character if not a promotion.
+  */
+
+template <class Rules>
+char ChessGame<Rules>::PromotionToken(int nPromotion)
+{
+    switch (nPromotion)
+    {
+        case m_knWhiteRookIndex:
+            return m_kcRookToken;
+        case m_knWhiteKnightIndex:
+            return m_kcKnightToken;
+        case m_knWhiteBishopIndex:
+            return m_kcBishopToken;
+        case m_knWhiteQueenIndex:
+            return m_kcQueenToken;
+        default:
+            return '\0';
+    }
+}
+
+/**
+  * Return the promotion of a piece token.
+  *
+  * \param cToken The piece token
+  *
+  * \return The index of the White piece, or zero if not a promotion piece.
+  */
+
+template <class Rules>
+int ChessGame<Rules>::PromotionIndex(char cToken)
+{
+    switch (cToken)
+    {
+        case m_kcRookToken:
+            return m_knWhiteRookIndex;
+        case m_kcKnightToken:
+            return m_knWhiteKnightIndex;
+        case m_kcBishopToken:
+            return m_knWhiteBishopIndex;
+        case m_kcQueenToken:
+            return m_knWhiteQueenIndex;
+        default:
+            return 0;
+    }
+}
+
+/**
+  * Add a move to the list of game moves after testing the move to see if it
   * results in the player's King in check.
   *
-  * If the GameMove is a TestMove (a look ahead move), add it to the vector.
+  * If the BoardMove is a TestMove (a look ahead move), add it to the list.
   * If not, evaluate if the move allows a check to the King.  If not, add it
-  * to the vector.
+  * to the list.
   *
   * \param nPlayer Number of the player
-  * \param cGameMove The game move
-  * \param vGameMoves The vector of game moves
+  * \param cBoardMove The game move
+  * \param cMoveList The list of game moves
   */
 
-void ChessGame::TestForCheck(int nPlayer, GameMove cGameMove, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+void ChessGame<Rules>::TestForCheck(int nPlayer, BoardMove cBoardMove, MoveList &cMoveList) const
 {
-    // If this is a test move, add it to the vector.
+    // If this is a test move, add it to the list.
     // We are not looking ahead more than one move.
-    if (cGameMove.TestMove())
+    if (cBoardMove.TestMove())
     {
-        vGameMoves.push_back(cGameMove);
+        cMoveList.Add(cBoardMove);
     }
     else // Not a test move
     {
         // Set as test move
-        cGameMove.SetTestMove(true);
-        // Clone the game
-        std::unique_ptr<Game> pcGameClone = Clone();
-        // Apply the move to cloned game.  If a valid move, set
-        // test move to false and add the move to the vector.
-        if (pcGameClone->ApplyMove(nPlayer, cGameMove))
+        cBoardMove.SetTestMove(true);
+        // Clone the game into its slot of the arena shared with clones
+        ChessGame *pcGameClone = static_cast<ChessGame *>(m_pcCheckArena->Clone(m_nCheckSlot, *this));
+        pcGameClone->m_nCheckSlot = m_nCheckSlot + 1;
+        // Apply the move to cloned game; it was just generated, so it needs
+        // no validation beyond the check test.  If a valid move, set
+        // test move to false and add the move to the list.
+        if (pcGameClone->ApplyTrustedBoardMove(nPlayer, cBoardMove) && !pcGameClone->KingInCheck(nPlayer))
         {
-            cGameMove.SetTestMove(false);
-            vGameMoves.push_back(cGameMove);
+            cBoardMove.SetTestMove(false);
+            cMoveList.Add(cBoardMove);
         }
         else // Otherwise set the test move to false
         {
-            cGameMove.SetTestMove(false);
+            cBoardMove.SetTestMove(false);
         }
+        // Release the clone, which holds the arena itself
+        m_pcCheckArena->Release(m_nCheckSlot);
 
     }
 }
 
 /**
-  * Return a vector of valid game moves.
-  *
-  * Review and collect all valid moves for a player into a vector.
+  * Fill a list with the valid game moves.
   *
-  * \param nPlayer The player whose turn it is.
+  * Review and collect all valid moves for a player into a list.
   *
-  * \return A vector of valid moves.
+  * \param nPlayer   The player whose turn it is.
+  * \param cMoveList The list to fill with valid moves
   */
 
-std::vector<GameMove> ChessGame::GenerateMoves(int nPlayer)
+template <class Rules>
+void ChessGame<Rules>::GenerateBoardMoves(int nPlayer, MoveList &cMoveList)
 {
-    std::vector<GameMove> vGameMoves {};
-    GameMove cGameMove;
+    cMoveList.Clear();
+    BoardMove cBoardMove;
     char cToken;
 
-    // Run through all squares on the board
-    for (int yyy = 0; yyy < m_knY; ++yyy)
+    // Run through this player's pieces
+    for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
     {
-        for (int xxx = 0; xxx < m_knX; ++xxx)
-        {
-            // If the square is occupied by this player ...
-            if (cBoard.PositionOccupiedByPlayer(xxx, yyy, nPlayer))
-            {
-                cGameMove.SetFromX(xxx);
-                cGameMove.SetFromY(yyy);
-                cGameMove.SetUseFrom(true);
+        const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+        const int knX = GameBoard::SquareX(knSquare);
+        const int knY = GameBoard::SquareY(knSquare);
 
-                // Generate the appropriate moves depending on the piece token
-                cToken = cBoard.Token(xxx, yyy);
+        cBoardMove.SetFromX(knX);
+        cBoardMove.SetFromY(knY);
+        cBoardMove.SetUseFrom(true);
 
-                if (cToken == m_kcPawnToken)
-                    GeneratePawnMoves(cGameMove, nPlayer, vGameMoves);
+        // Generate the appropriate moves depending on the piece token
+        cToken = cBoard.Token(knX, knY);
 
-                if (cToken == m_kcRookToken)
-                    GenerateRookMoves(cGameMove, nPlayer, vGameMoves);
+        if (cToken == m_kcPawnToken)
+            GeneratePawnMoves(cBoardMove, nPlayer, cMoveList);
 
-                if (cToken == m_kcKnightToken)
-                    GenerateKnightMoves(cGameMove, nPlayer, vGameMoves);
+        if (cToken == m_kcRookToken)
+            GenerateRookMoves(cBoardMove, nPlayer, cMoveList);
 
-                if (cToken == m_kcBishopToken)
-                    GenerateBishopMoves(cGameMove, nPlayer, vGameMoves);
+        if (cToken == m_kcKnightToken)
+            GenerateKnightMoves(cBoardMove, nPlayer, cMoveList);
 
-                if (cToken == m_kcQueenToken)
-                    GenerateQueenMoves(cGameMove, nPlayer, vGameMoves);
+        if (cToken == m_kcBishopToken)
+            GenerateBishopMoves(cBoardMove, nPlayer, cMoveList);
 
-                if (cToken == m_kcKingToken)
-                    GenerateKingMoves(cGameMove, nPlayer, vGameMoves);
-            }
-        }
-    }
+        if (cToken == m_kcQueenToken)
+            GenerateQueenMoves(cBoardMove, nPlayer, cMoveList);
 
-    return vGameMoves;
+        if (cToken == m_kcKingToken)
+            GenerateKingMoves(cBoardMove, nPlayer, cMoveList);
+    }
 }
 
 /**
@@ -227,15 +300,16 @@ std::vector<GameMove> ChessGame::GenerateMoves(int nPlayer)
   *
   * Review and collect all valid moves for a pawn.
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   */
 
-void ChessGame::GeneratePawnMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+void ChessGame<Rules>::GeneratePawnMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
 {
-    const int knX = cGameMove.FromX();
-    const int knY = cGameMove.FromY();
+    const int knX = cBoardMove.FromX();
+    const int knY = cBoardMove.FromY();
     int nNewY;
     int nIntermediateY;
 
@@ -247,37 +321,37 @@ void ChessGame::GeneratePawnMoves(GameMove cGameMove, int nPlayer, std::vector<G
     else
         nNewY = knY - 1;
 
-    if (!cBoard.ValidLocation(knX, nNewY))
+    if (!OnBoard(knX, nNewY))
         return;
 
     if (!cBoard.PositionOccupied(knX, nNewY))
     {
-        cGameMove.SetToX(knX);
-        cGameMove.SetToY(nNewY);
-        TestForCheck(nPlayer, cGameMove, vGameMoves);
+        cBoardMove.SetToX(knX);
+        cBoardMove.SetToY(nNewY);
+        AddPawnMove(cBoardMove, nPlayer, cMoveList);
     }
 
     //
     // Capture
     //
-    if (cBoard.PositionOccupiedByPlayer(knX - 1, nNewY, 3 - nPlayer))
+    if (OnBoard(knX - 1, nNewY) && cBoard.PositionOccupiedByPlayer(knX - 1, nNewY, 3 - nPlayer))
     {
-        cGameMove.SetToX(knX - 1);
-        cGameMove.SetToY(nNewY);
-        TestForCheck(nPlayer, cGameMove, vGameMoves);
+        cBoardMove.SetToX(knX - 1);
+        cBoardMove.SetToY(nNewY);
+        AddPawnMove(cBoardMove, nPlayer, cMoveList);
     }
 
-    if (cBoard.PositionOccupiedByPlayer(knX + 1, nNewY, 3 - nPlayer))
+    if (OnBoard(knX + 1, nNewY) && cBoard.PositionOccupiedByPlayer(knX + 1, nNewY, 3 - nPlayer))
     {
-        cGameMove.SetToX(knX + 1);
-        cGameMove.SetToY(nNewY);
-        TestForCheck(nPlayer, cGameMove, vGameMoves);
+        cBoardMove.SetToX(knX + 1);
+        cBoardMove.SetToY(nNewY);
+        AddPawnMove(cBoardMove, nPlayer, cMoveList);
     }
 
     //
     // Double move
     //
-    if (m_bDoublePawnMoveAllowed)
+    if (Rules::m_kbDoublePawnMove)
     {
         GamePiece cPiece = cBoard.Piece(knX, knY);
         if (!cPiece.HasMoved())
@@ -295,9 +369,9 @@ void ChessGame::GeneratePawnMoves(GameMove cGameMove, int nPlayer, std::vector<G
 
             if ((!cBoard.PositionOccupied(knX, nIntermediateY)) && (!cBoard.PositionOccupied(knX, nNewY)))
             {
-                cGameMove.SetToX(knX);
-                cGameMove.SetToY(nNewY);
-                TestForCheck(nPlayer, cGameMove, vGameMoves);
+                cBoardMove.SetToX(knX);
+                cBoardMove.SetToY(nNewY);
+                TestForCheck(nPlayer, cBoardMove, cMoveList);
             }
         }
     }
@@ -305,7 +379,7 @@ void ChessGame::GeneratePawnMoves(GameMove cGameMove, int nPlayer, std::vector<G
     //
     // En passant
     //
-    if (m_bEnPassantAllowed)
+    if (Rules::m_kbEnPassant)
     {
         // Get last applied game move
         GameMove cLastGameMove = LastMove();
@@ -326,25 +400,64 @@ void ChessGame::GeneratePawnMoves(GameMove cGameMove, int nPlayer, std::vector<G
                         if ((knX - cLastGameMove.FromX() == 1) || (cLastGameMove.FromX() - knX == 1))
                         {
                             // Set To X coordinate
-                            cGameMove.SetToX(cLastGameMove.FromX());
+                            cBoardMove.SetToX(cLastGameMove.FromX());
 
                             // Find Y-direction and set Y coordinate
                             if (cLastGameMove.FromY() > cLastGameMove.ToY())
                             {
-                                cGameMove.SetToY(cLastGameMove.FromY() - 1);
+                                cBoardMove.SetToY(cLastGameMove.FromY() - 1);
                             }
                             else
                             {
-                                cGameMove.SetToY(cLastGameMove.FromY() + 1);
+                                cBoardMove.SetToY(cLastGameMove.FromY() + 1);
                             }
 
-                            TestForCheck(nPlayer, cGameMove, vGameMoves);
+                            TestForCheck(nPlayer, cBoardMove, cMoveList);
                         } // If the Pawns' files are adjacent
                     }  // If the opponent Pawn's rank now equals this Pawn's rank
                 } // If the Pawn moved two squares
             } // If last move was a Pawn
         } // Check to see if there was a move
-    } //  if (m_bEnPassantAllowed)
+    } //  if (Rules::m_kbEnPassant)
+}
+
+/**
+  * Add a single-square pawn move, with one move for each promotion piece if
+  * the pawn reaches the last rank.
+  *
+  * The promoted piece stands where the pawn would, so the Queen promotion
+  * alone is tested for check.
+  *
+  * \param cBoardMove The pawn move
+  * \param nPlayer The player whose turn it is.
+  * \param cMoveList The list to add valid moves to
+  */
+
+template <class Rules>
+void ChessGame<Rules>::AddPawnMove(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
+{
+    if ((cBoardMove.ToY() != Rules::m_knY - 1) && (cBoardMove.ToY() != 0))
+    {
+        TestForCheck(nPlayer, cBoardMove, cMoveList);
+        return;
+    }
+
+    const int knSize = cMoveList.Size();
+
+    cBoardMove.SetPromotion(m_knWhiteQueenIndex);
+    TestForCheck(nPlayer, cBoardMove, cMoveList);
+
+    if (cMoveList.Size() == knSize)
+        return;
+
+    // Under-promotions, added with the Queen promotion's test move flag
+    cBoardMove = cMoveList[knSize];
+    cBoardMove.SetPromotion(m_knWhiteRookIndex);
+    cMoveList.Add(cBoardMove);
+    cBoardMove.SetPromotion(m_knWhiteBishopIndex);
+    cMoveList.Add(cBoardMove);
+    cBoardMove.SetPromotion(m_knWhiteKnightIndex);
+    cMoveList.Add(cBoardMove);
 }
 
 /**
@@ -352,26 +465,27 @@ void ChessGame::GeneratePawnMoves(GameMove cGameMove, int nPlayer, std::vector<G
   *
   * Review and collect all valid moves for a Rook, Queen, or King
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   * \param bUnlimitedMoves Whether to to limit moves to one square (used for the King)
   */
 
-void ChessGame::GenerateRookMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves, bool bUnlimitedMoves) const
+template <class Rules>
+void ChessGame<Rules>::GenerateRookMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList, bool bUnlimitedMoves) const
 {
-    const int knX = cGameMove.FromX();
-    const int knY = cGameMove.FromY();
+    const int knX = cBoardMove.FromX();
+    const int knY = cBoardMove.FromY();
     int nNewX;
     int nNewY;
 
     // Evaluate north along file
-    cGameMove.SetToX(knX);
+    cBoardMove.SetToX(knX);
     nNewY = knY + 1;
-    while (cBoard.ValidLocation(knX, nNewY))
+    while (OnBoard(knX, nNewY))
     {
-        cGameMove.SetToY(nNewY);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToY(nNewY);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
             ++nNewY;
         else
             break;
@@ -381,12 +495,12 @@ void ChessGame::GenerateRookMoves(GameMove cGameMove, int nPlayer, std::vector<G
     }
 
     // Evaluate south along file
-    cGameMove.SetToX(knX);
+    cBoardMove.SetToX(knX);
     nNewY = knY - 1;
-    while (cBoard.ValidLocation(knX, nNewY))
+    while (OnBoard(knX, nNewY))
     {
-        cGameMove.SetToY(nNewY);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToY(nNewY);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
             --nNewY;
         else
             break;
@@ -396,12 +510,12 @@ void ChessGame::GenerateRookMoves(GameMove cGameMove, int nPlayer, std::vector<G
     }
 
     // Evaluate east along rank
-    cGameMove.SetToY(knY);
+    cBoardMove.SetToY(knY);
     nNewX = knX - 1;
-    while (cBoard.ValidLocation(nNewX, knY))
+    while (OnBoard(nNewX, knY))
     {
-        cGameMove.SetToX(nNewX);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToX(nNewX);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
             --nNewX;
         else
             break;
@@ -411,12 +525,12 @@ void ChessGame::GenerateRookMoves(GameMove cGameMove, int nPlayer, std::vector<G
     }
 
     // Evaluate west along rank
-    cGameMove.SetToY(knY);
+    cBoardMove.SetToY(knY);
     nNewX = knX + 1;
-    while (cBoard.ValidLocation(nNewX, knY))
+    while (OnBoard(nNewX, knY))
     {
-        cGameMove.SetToX(nNewX);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToX(nNewX);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
             ++nNewX;
         else
             break;
@@ -431,27 +545,28 @@ void ChessGame::GenerateRookMoves(GameMove cGameMove, int nPlayer, std::vector<G
   *
   * Review and collect all valid moves for a Bishop, Queen, or a King
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   * \param bUnlimitedMoves Whether to to limit moves to one square (use d for the King)
   */
 
-void ChessGame::GenerateBishopMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves, bool bUnlimitedMoves) const
+template <class Rules>
+void ChessGame<Rules>::GenerateBishopMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList, bool bUnlimitedMoves) const
 {
-    const int knX = cGameMove.FromX();
-    const int knY = cGameMove.FromY();
+    const int knX = cBoardMove.FromX();
+    const int knY = cBoardMove.FromY();
     int nNewX;
     int nNewY;
 
     // Evaluate north-west
     nNewX = knX + 1;
     nNewY = knY + 1;
-    while (cBoard.ValidLocation(nNewX, nNewY))
+    while (OnBoard(nNewX, nNewY))
     {
-        cGameMove.SetToX(nNewX);
-        cGameMove.SetToY(nNewY);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToX(nNewX);
+        cBoardMove.SetToY(nNewY);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
         {
             ++nNewX;
             ++nNewY;
@@ -466,11 +581,11 @@ void ChessGame::GenerateBishopMoves(GameMove cGameMove, int nPlayer, std::vector
     // Evaluate south-west
     nNewX = knX + 1;
     nNewY = knY - 1;
-    while (cBoard.ValidLocation(nNewX, nNewY))
+    while (OnBoard(nNewX, nNewY))
     {
-        cGameMove.SetToX(nNewX);
-        cGameMove.SetToY(nNewY);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToX(nNewX);
+        cBoardMove.SetToY(nNewY);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
         {
             ++nNewX;
             --nNewY;
@@ -485,11 +600,11 @@ void ChessGame::GenerateBishopMoves(GameMove cGameMove, int nPlayer, std::vector
     // Evaluate south-east
     nNewX = knX - 1;
     nNewY = knY - 1;
-    while (cBoard.ValidLocation(nNewX, nNewY))
+    while (OnBoard(nNewX, nNewY))
     {
-        cGameMove.SetToX(nNewX);
-        cGameMove.SetToY(nNewY);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToX(nNewX);
+        cBoardMove.SetToY(nNewY);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
         {
             --nNewX;
             --nNewY;
@@ -504,11 +619,11 @@ void ChessGame::GenerateBishopMoves(GameMove cGameMove, int nPlayer, std::vector
     // Evaluate north-east
     nNewX = knX - 1;
     nNewY = knY + 1;
-    while (cBoard.ValidLocation(nNewX, nNewY))
+    while (OnBoard(nNewX, nNewY))
     {
-        cGameMove.SetToX(nNewX);
-        cGameMove.SetToY(nNewY);
-        if (GenerateLinearMove(cGameMove, nPlayer, vGameMoves))
+        cBoardMove.SetToX(nNewX);
+        cBoardMove.SetToY(nNewY);
+        if (GenerateLinearMove(cBoardMove, nPlayer, cMoveList))
         {
             --nNewX;
             ++nNewY;
@@ -526,15 +641,16 @@ void ChessGame::GenerateBishopMoves(GameMove cGameMove, int nPlayer, std::vector
   *
   * Review and collect all valid moves for a Queen
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   */
 
-void ChessGame::GenerateQueenMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+void ChessGame<Rules>::GenerateQueenMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
 {
-    GenerateRookMoves(cGameMove, nPlayer, vGameMoves, true);
-    GenerateBishopMoves(cGameMove, nPlayer, vGameMoves, true);
+    GenerateRookMoves(cBoardMove, nPlayer, cMoveList, true);
+    GenerateBishopMoves(cBoardMove, nPlayer, cMoveList, true);
 }
 
 /**
@@ -542,37 +658,39 @@ void ChessGame::GenerateQueenMoves(GameMove cGameMove, int nPlayer, std::vector<
   *
   * Review and collect all valid moves for a King
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   */
 
-void ChessGame::GenerateKingMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+void ChessGame<Rules>::GenerateKingMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
 {
-    GenerateRookMoves(cGameMove, nPlayer, vGameMoves, false);
-    GenerateBishopMoves(cGameMove, nPlayer, vGameMoves, false);
-    GenerateCastleMoves(cGameMove, nPlayer, vGameMoves);
+    GenerateRookMoves(cBoardMove, nPlayer, cMoveList, false);
+    GenerateBishopMoves(cBoardMove, nPlayer, cMoveList, false);
+    GenerateCastleMoves(cBoardMove, nPlayer, cMoveList);
 }
 
 /**
   * Generate castle moves.
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   */
 
-void ChessGame::GenerateCastleMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+void ChessGame<Rules>::GenerateCastleMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
 {
     // King's From coordinates
-    const int knKX = cGameMove.FromX();
-    const int knKY = cGameMove.FromY();
+    const int knKX = cBoardMove.FromX();
+    const int knKY = cBoardMove.FromY();
 
     // Used to test for  check on the intermediate castle move
-    std::vector<GameMove> vIntermediateCastleMove {};
+    MoveList cIntermediateCastleMove;
 
     // If castling is allowed, continue
-    if (m_abCastlingAllowed[nPlayer - 1])
+    if (Rules::m_kbCastling && m_abCastlingAllowed[nPlayer - 1])
     {
         // Cannot castle if the King is in check
         if (KingInCheck(nPlayer))
@@ -581,6 +699,7 @@ void ChessGame::GenerateCastleMoves(GameMove cGameMove, int nPlayer, std::vector
         // Used to locate the Rook(s)
         int nRX    {0};
         int nRY    {0};
+        int nSquare {0};
 
         // Ending King location on a castle move
         int nNewKX {0};
@@ -589,9 +708,16 @@ void ChessGame::GenerateCastleMoves(GameMove cGameMove, int nPlayer, std::vector
 
         bool bCastleValid {false};
 
-        // Find all Rooks
-        while (FindPiece(nRX, nRY, nPlayer, m_kcRookToken))
+        // Find all Rooks on the King's rank
+        for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
         {
+            nSquare = cBoard.PieceSquare(nPlayer, iii);
+            nRX = GameBoard::SquareX(nSquare);
+            nRY = GameBoard::SquareY(nSquare);
+
+            if ((cBoard.Token(nRX, nRY) != m_kcRookToken) || (nRY != knKY))
+                continue;
+
             GamePiece cRook = cBoard.Piece(nRX, nRY);
             // If Rook has not moved, continue
             if (!cRook.HasMoved())
@@ -633,68 +759,62 @@ void ChessGame::GenerateCastleMoves(GameMove cGameMove, int nPlayer, std::vector
                     }
                 }
 
+                // The King steps onto the intermediate square first, so a Rook next to the King cannot castle
+                if (cBoard.PositionOccupied(nIntermediateKX, knKY))
+                    bCastleValid = false;
+
                 // If castle is still valid after previous tests, continue
                 if (bCastleValid)
                 {
                     // Check that the intermediate castling move does not move
                     // the King adjacent to the opposing King
-                    cGameMove.SetToX(nIntermediateKX);
-                    cGameMove.SetToY(knKY);
+                    cBoardMove.SetToX(nIntermediateKX);
+                    cBoardMove.SetToY(knKY);
 
-                    if (!TestForAdjacentKings(cGameMove, nPlayer))
+                    if (!TestForAdjacentKings(cBoardMove, nPlayer))
                     {
                         // Ensure the King is not in check on the intermediate castling move
-                        TestForCheck(nPlayer, cGameMove, vIntermediateCastleMove);
-                        if (!vIntermediateCastleMove.empty())
+                        TestForCheck(nPlayer, cBoardMove, cIntermediateCastleMove);
+                        if (!cIntermediateCastleMove.Empty())
                         {
 
                             // Check that the end castling move does not move
                             // the King adjacent to the opposing King
-                            cGameMove.SetToX(nNewKX);
+                            cBoardMove.SetToX(nNewKX);
 
-                            if (!TestForAdjacentKings(cGameMove, nPlayer))
+                            if (!TestForAdjacentKings(cBoardMove, nPlayer))
                             {
                                  // Ensure the King is not in check on the end castling move.
                                  // This method will add  the castle move as valid.
-                                TestForCheck(nPlayer, cGameMove, vGameMoves);
+                                TestForCheck(nPlayer, cBoardMove, cMoveList);
                             }
                         }
                     }
                 } // bValidCastle
             } // !cRook.HasMoved()
-
-            // Update coordinates to find another Rook
-            if (nRX < m_knX - 1)
-            {
-                ++nRX;
-            }
-            else
-            {
-                nRX = 0;
-                ++nRY;
-            }
-        } // end of while
+        } // end of for
     } // end of if castling is allowed
 }
 
 /**
-  * Generic method to test and add linear moves to the game moves vector.
+  * Generic method to test and add linear moves to the game moves list.
   *
   * Evaluates a move.  If legal before considering adjacent Kings or checks, it
   * returns true.  True means continue checking for valid linear moves. It calls
-  * TestForCheck() to add the move to the vector of moves.
+  * TestForCheck() to add the move to the list of moves.
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to\
+  * \param cMoveList The list to add valid moves to\
   *
   * \return True if game move is valid before considering adjacent kings or a check.  False otherwise.
   */
 
-bool ChessGame::GenerateLinearMove(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+bool ChessGame<Rules>::GenerateLinearMove(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
 {
-    const int knToX = cGameMove.ToX();
-    const int knToY = cGameMove.ToY();
+    const int knToX = cBoardMove.ToX();
+    const int knToY = cBoardMove.ToY();
 
     //
     // Move
@@ -703,12 +823,12 @@ bool ChessGame::GenerateLinearMove(GameMove cGameMove, int nPlayer, std::vector<
     // If To position is not occupied
     if (!cBoard.PositionOccupied(knToX, knToY))
     {
-        // If this move results in adjacent Kings, return true, but do not add it to the vector of moves
-        if (TestForAdjacentKings(cGameMove, nPlayer))
+        // If this move results in adjacent Kings, return true, but do not add it to the list of moves
+        if (TestForAdjacentKings(cBoardMove, nPlayer))
             return true;
 
-        // Procedure tests for a King check before adding the move to the vector
-        TestForCheck(nPlayer, cGameMove, vGameMoves);
+        // Procedure tests for a King check before adding the move to the list
+        TestForCheck(nPlayer, cBoardMove, cMoveList);
 
         // Return true because the move was valid before considering adjacent Kings or checks
         return true;
@@ -725,11 +845,11 @@ bool ChessGame::GenerateLinearMove(GameMove cGameMove, int nPlayer, std::vector<
     else //if (cBoard.PositionOccupiedByPlayer(nToX, nToY, 3 - nPlayer))
     {
         // If this move results in adjacent Kings, return true, but do not add it to the vector of moves
-        if (TestForAdjacentKings(cGameMove, nPlayer))
+        if (TestForAdjacentKings(cBoardMove, nPlayer))
             return false;
 
         // Procedure tests for a King check before adding the move to the vector
-        TestForCheck(nPlayer, cGameMove, vGameMoves);
+        TestForCheck(nPlayer, cBoardMove, cMoveList);
 
         // Return false because no more linear moves may be made and evaluated
         return false;
@@ -741,55 +861,56 @@ bool ChessGame::GenerateLinearMove(GameMove cGameMove, int nPlayer, std::vector<
   *
   * Review and collect all valid moves for a Knight
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   */
 
-void ChessGame::GenerateKnightMoves(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+void ChessGame<Rules>::GenerateKnightMoves(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
 {
-    const int knX = cGameMove.FromX();
-    const int knY = cGameMove.FromY();
+    const int knX = cBoardMove.FromX();
+    const int knY = cBoardMove.FromY();
 
     // Two up, one right
-    cGameMove.SetToX(knX + 2);
-    cGameMove.SetToY(knY + 1);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX + 2);
+    cBoardMove.SetToY(knY + 1);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 
     // One up, two right
-    cGameMove.SetToX(knX + 1);
-    cGameMove.SetToY(knY + 2);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX + 1);
+    cBoardMove.SetToY(knY + 2);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 
     // One down, two right
-    cGameMove.SetToX(knX - 1);
-    cGameMove.SetToY(knY + 2);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX - 1);
+    cBoardMove.SetToY(knY + 2);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 
     // Two down, one right
-    cGameMove.SetToX(knX - 2);
-    cGameMove.SetToY(knY + 1);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX - 2);
+    cBoardMove.SetToY(knY + 1);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 
     // Two down, one left
-    cGameMove.SetToX(knX - 2);
-    cGameMove.SetToY(knY - 1);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX - 2);
+    cBoardMove.SetToY(knY - 1);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 
     // One down, two left
-    cGameMove.SetToX(knX - 1);
-    cGameMove.SetToY(knY - 2);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX - 1);
+    cBoardMove.SetToY(knY - 2);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 
     // One up, two left
-    cGameMove.SetToX(knX + 1);
-    cGameMove.SetToY(knY - 2);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX + 1);
+    cBoardMove.SetToY(knY - 2);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 
     // Two up, one left
-    cGameMove.SetToX(knX + 2);
-    cGameMove.SetToY(knY - 1);
-    GenerateKnightMove(cGameMove, nPlayer, vGameMoves);
+    cBoardMove.SetToX(knX + 2);
+    cBoardMove.SetToY(knY - 1);
+    GenerateKnightMove(cBoardMove, nPlayer, cMoveList);
 }
 
 /**
@@ -797,21 +918,22 @@ void ChessGame::GenerateKnightMoves(GameMove cGameMove, int nPlayer, std::vector
   *
   * RTest a specific move for the knight.
   *
-  * \param cGameMove The game move under consideration
+  * \param cBoardMove The game move under consideration
   * \param nPlayer The player whose turn it is.
-  * \param vGameMoves The vector to add valid moves to
+  * \param cMoveList The list to add valid moves to
   */
 
-void ChessGame::GenerateKnightMove(GameMove cGameMove, int nPlayer, std::vector<GameMove> &vGameMoves) const
+template <class Rules>
+void ChessGame<Rules>::GenerateKnightMove(BoardMove cBoardMove, int nPlayer, MoveList &cMoveList) const
 {
-    const int knToX = cGameMove.ToX();
-    const int knToY = cGameMove.ToY();
+    const int knToX = cBoardMove.ToX();
+    const int knToY = cBoardMove.ToY();
 
-    if (cBoard.ValidLocation(knToX, knToY))
+    if (OnBoard(knToX, knToY))
     {
         if ((!cBoard.PositionOccupied(knToX, knToY)) || (cBoard.PositionOccupiedByPlayer(knToX, knToY, 3 - nPlayer)))
         {
-            TestForCheck(nPlayer, cGameMove, vGameMoves);
+            TestForCheck(nPlayer, cBoardMove, cMoveList);
         }
 
     }
@@ -823,122 +945,184 @@ void ChessGame::GenerateKnightMove(GameMove cGameMove, int nPlayer, std::vector<
   * After checking to for a move's validity, apply the move to the game.
   *
   * \param nPlayer   The player whose turn it is.
-  * \param cGameMove The player's move
+  * \param cBoardMove The player's move
   *
   * \return True, if valid.  False otherwise.
   */
 
-bool ChessGame::ApplyMove(int nPlayer, GameMove &cGameMove)
+template <class Rules>
+bool ChessGame<Rules>::ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove)
 {
-    bool bValidMove = false;
-    char cToken;
-
-    // Check player number
-    if ((nPlayer != m_knPlayer1) && (nPlayer != m_knPlayer2))
-        return false;
-
-    // Check for resignation
-    if (cGameMove.Resignation())
-    {
-        // Capture move for later playback or analysis
-        m_vGameMoves.push_back(cGameMove);
-        return true;
-    }
-
     // Ensure we are on the board
-    if (!cBoard.ValidLocation(cGameMove.FromX(), cGameMove.FromY()))
+    if (!OnBoard(cBoardMove.FromX(), cBoardMove.FromY()))
         return false;
 
-    if (!cBoard.ValidLocation(cGameMove.ToX(), cGameMove.ToY()))
+    if (!OnBoard(cBoardMove.ToX(), cBoardMove.ToY()))
         return false;
 
-    // Generate a vector of all possible valid moves for the piece on the from square
-    std::vector<GameMove> vGameMoves = GenerateMovesForPiece(nPlayer, cGameMove);
+    // Generate a list of all possible valid moves for the piece on the from square
+    MoveList cMoveList;
+    GenerateMovesForPiece(nPlayer, cBoardMove, cMoveList);
 
-    // Compare passed GameMove to generated game moves.  If one is found to be
+    // Compare passed BoardMove to generated game moves.  If one is found to be
     // the same, make the move on the board.
-    for (GameMove &cValidGameMove : vGameMoves)
+    for (const BoardMove &cValidBoardMove : cMoveList)
     {
-        if (cValidGameMove.SameTo(cGameMove))
+        // A move without a promotion takes the promotion from MakeBoardMove()
+        if (cValidBoardMove.SameTo(cBoardMove) &&
+            ((cBoardMove.Promotion() == 0) || (cValidBoardMove.Promotion() == cBoardMove.Promotion())))
         {
-            //
-            // Update the ZobristKey to reflect the MOVE
-            //
+            if (!MakeBoardMove(nPlayer, cBoardMove))
+                return false;
 
-            // The piece on the FROM square
-            cBoard.UpdateZobristKey(cGameMove.FromX(), cGameMove.FromY(), cGameMove.FromX(), cGameMove.FromY());
-            // The piece on the TO square
-            cBoard.UpdateZobristKey(cGameMove.FromX(), cGameMove.FromY(), cGameMove.ToX(), cGameMove.ToY());
-            // If this was a capture, remove the captured piece from the Zobrist hash
-            if (cBoard.PositionOccupied(cGameMove.ToX(), cGameMove.ToY()))
-            {
-                // The capture piece on the TO square
-                cBoard.UpdateZobristKey(cGameMove.ToX(), cGameMove.ToY(), cGameMove.ToX(), cGameMove.ToY());
-            }
+            // If King is in check after the move, the move is not valid // TODO: Should not ever trip this condition?
+            return !KingInCheck(nPlayer);
+        }
+    }
 
-            // Move the piece
-            if (cBoard.MovePiece(cGameMove))
-            {
-                bValidMove = true;
+    return false;
+}
 
-                break;
-            }
-            else // If not a valid move, update the ZobristKey to reflect the UN-MOVE
-            {
+/**
+  * Apply a move generated by the game, without validating it.
+  *
+  * A move from GenerateBoardMoves() is already legal, so searching applies
+  * it here and skips the move generation and check test of
+  * ApplyBoardMove().  A move from TestForCheck() is only known to follow
+  * the piece's movement rules; the caller tests it for check.  A debug
+  * build asserts that the move is one the piece could make.
+  *
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The generated move
+  *
+  * \return True, if the move was made.  False otherwise.
+  */
 
-                cBoard.UpdateZobristKey(cGameMove.FromX(), cGameMove.FromY(), cGameMove.FromX(), cGameMove.FromY());
-                cBoard.UpdateZobristKey(cGameMove.FromX(), cGameMove.FromY(), cGameMove.ToX(), cGameMove.ToY());
-                if (cBoard.PositionOccupied(cGameMove.ToX(), cGameMove.ToY()))
-                {
-                    cBoard.UpdateZobristKey(cGameMove.ToX(), cGameMove.ToY(), cGameMove.ToX(), cGameMove.ToY());
-                }
-                return false;
-            }
-        }
-    }
+template <class Rules>
+bool ChessGame<Rules>::ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove)
+{
+#ifndef NDEBUG
+    // Cross-check against the moves ApplyBoardMove() would accept
+    bool bGenerated = false;
+    MoveList cMoveList;
+    GenerateMovesForPiece(nPlayer, cBoardMove, cMoveList);
+    for (const BoardMove &cValidBoardMove : cMoveList)
+        bGenerated = bGenerated || (cValidBoardMove.SameTo(cBoardMove) && (cValidBoardMove.Promotion() == cBoardMove.Promotion()));
+    assert(bGenerated && "ChessGame::ApplyTrustedBoardMove() move was not generated");
+#endif
+
+    bool bValidMove = MakeBoardMove(nPlayer, cBoardMove);
+
+    assert((!bValidMove || cBoardMove.TestMove() || !KingInCheck(nPlayer)) && "ChessGame::ApplyTrustedBoardMove() King left in check");
+
+    return bValidMove;
+}
+
+/**
+  * Make a move on the board.
+  *
+  * Move the piece, and complete a promotion, castle, or en passant, keeping
+  * the Zobrist keys and move history up to date.  The move is not checked.
+  *
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The move
+  *
+  * \return True, if the move was made.  False otherwise.
+  */
+
+template <class Rules>
+bool ChessGame<Rules>::MakeBoardMove(int nPlayer, const BoardMove &cBoardMove)
+{
+    bool bValidMove = false;
+    bool bIrreversible = false;
+    char cToken;
 
-    // If King is in check after the move, the move is not valid // TODO: Should not ever trip this condition?
-    if (KingInCheck(nPlayer))
+    // Castling rights change only when a King or Rook moves, or a Rook is captured
+    const bool kbCastlingPiece = Rules::m_kbCastling &&
+        ((cBoard.Token(cBoardMove.FromX(), cBoardMove.FromY()) == m_kcKingToken) ||
+         (cBoard.Token(cBoardMove.FromX(), cBoardMove.FromY()) == m_kcRookToken) ||
+         (cBoard.Token(cBoardMove.ToX(), cBoardMove.ToY()) == m_kcRookToken));
+    int anCastlingRights[2] {0, 0};
+    if (kbCastlingPiece)
     {
-        bValidMove = false;
+        anCastlingRights[0] = CastlingRights(1);
+        anCastlingRights[1] = CastlingRights(2);
     }
 
-    // If a valid move, capture it for later playback
-    if (bValidMove)
-    {
-        // Increment move counter
-        ++m_nNumberOfMoves;
+    //
+    // Update the ZobristKey to reflect the MOVE
+    //
+
+    // A pawn move or a capture cannot be undone, so no earlier position can repeat
+    bIrreversible = (cBoard.Token(cBoardMove.FromX(), cBoardMove.FromY()) == m_kcPawnToken) ||
+                    cBoard.PositionOccupied(cBoardMove.ToX(), cBoardMove.ToY());
 
-        // Capture move for later playback or analysis
-        m_vGameMoves.push_back(cGameMove);
+    // The piece on the FROM square
+    UpdateZobristKeys(cBoardMove.FromX(), cBoardMove.FromY(), cBoardMove.FromX(), cBoardMove.FromY());
+    // The piece on the TO square
+    UpdateZobristKeys(cBoardMove.FromX(), cBoardMove.FromY(), cBoardMove.ToX(), cBoardMove.ToY());
+    // If this was a capture, remove the captured piece from the Zobrist hash
+    if (cBoard.PositionOccupied(cBoardMove.ToX(), cBoardMove.ToY()))
+    {
+        // The capture piece on the TO square
+        UpdateZobristKeys(cBoardMove.ToX(), cBoardMove.ToY(), cBoardMove.ToX(), cBoardMove.ToY());
     }
-    else
+
+    // Move the piece
+    if (!cBoard.MovePiece(cBoardMove))
     {
+        // If not a valid move, update the ZobristKey to reflect the UN-MOVE
+        UpdateZobristKeys(cBoardMove.FromX(), cBoardMove.FromY(), cBoardMove.FromX(), cBoardMove.FromY());
+        UpdateZobristKeys(cBoardMove.FromX(), cBoardMove.FromY(), cBoardMove.ToX(), cBoardMove.ToY());
+        if (cBoard.PositionOccupied(cBoardMove.ToX(), cBoardMove.ToY()))
+        {
+            UpdateZobristKeys(cBoardMove.ToX(), cBoardMove.ToY(), cBoardMove.ToX(), cBoardMove.ToY());
+        }
         return false;
     }
 
+    bValidMove = true;
+
+    // Track the King
+    if (cBoard.Token(cBoardMove.ToX(), cBoardMove.ToY()) == m_kcKingToken)
+    {
+        m_anKingX[nPlayer - 1] = cBoardMove.ToX();
+        m_anKingY[nPlayer - 1] = cBoardMove.ToY();
+    }
+
+    // Increment move counter
+    ++m_nNumberOfMoves;
+
+    // Capture move for later playback or analysis, once any promotion is known
+    GameMove cGameMove = cBoardMove.ToGameMove();
+
     //
     // Perform Pawn Promotion
     //
-    cToken = cBoard.Token(cGameMove.ToX(), cGameMove.ToY());
+    cToken = cBoard.Token(cBoardMove.ToX(), cBoardMove.ToY());
 
     // If this is a pawn on the last or first rank, promote the pawn
-    if ((cToken == m_kcPawnToken) && ((cGameMove.ToY() == m_knY - 1) || (cGameMove.ToY() == 0)))
+    if ((cToken == m_kcPawnToken) && ((cBoardMove.ToY() == Rules::m_knY - 1) || (cBoardMove.ToY() == 0)))
     {
         bool bGoodToken = false;
         char cPromotion {};
         int  nIndexOffset = m_knPieceIndexOffset * (nPlayer - 1);
 
-        GamePiece cGamePiece = cBoard.Piece(cGameMove.ToX(), cGameMove.ToY());
+        GamePiece cGamePiece = cBoard.Piece(cBoardMove.ToX(), cBoardMove.ToY());
 
         while (!bGoodToken)
         {
+            // A generated move carries its promotion
+            if (cBoardMove.Promotion() != 0)
+            {
+                cPromotion = PromotionToken(cBoardMove.Promotion());
+            }
             // If automatic Queen promotion has bee set, use the queen as the selected token
-            if (m_bAutomaticPromoteToQueen)
+            else if (m_bAutomaticPromoteToQueen)
             {
                 cPromotion = m_kcQueenToken;
             }
-            // Else ask for input from player.  //TODO: Make this work with AI.
+            // Else ask for input from the player, whose move named no promotion
             else
             {
                 std::cout << "\nPAWN PROMOTION ("
@@ -977,26 +1161,30 @@ bool ChessGame::ApplyMove(int nPlayer, GameMove &cGameMove)
 
             if (bGoodToken)
             {
+                cGameMove.SetPromotion(PromotionIndex(cPromotion), cPromotion);
+
                 // Update the ZobristKey to reflect the removal of the pawn from the board
-                cBoard.UpdateZobristKey(cGameMove.ToX(), cGameMove.ToY(), cGameMove.ToX(), cGameMove.ToY());
+                UpdateZobristKeys(cBoardMove.ToX(), cBoardMove.ToY(), cBoardMove.ToX(), cBoardMove.ToY());
 
                 // Promote the pawn on the board
-                cBoard.SetPiece(cGameMove.ToX(), cGameMove.ToY(), cGamePiece);
+                cBoard.SetPiece(cBoardMove.ToX(), cBoardMove.ToY(), cGamePiece);
 
                 // Update the ZobristKey to reflect the promotion
-                cBoard.UpdateZobristKey(cGameMove.ToX(), cGameMove.ToY(), cGameMove.ToX(), cGameMove.ToY());
+                UpdateZobristKeys(cBoardMove.ToX(), cBoardMove.ToY(), cBoardMove.ToX(), cBoardMove.ToY());
             }
         }
     }
 
+    m_cGameMoves.Push(cGameMove);
+
     //
     // Perform Second Half of Castling Move
     //
 
     // If castling allowed
-    if (m_abCastlingAllowed[nPlayer -1])
+    if (Rules::m_kbCastling && m_abCastlingAllowed[nPlayer - 1])
     {
-        cToken = cBoard.Token(cGameMove.ToX(), cGameMove.ToY());
+        cToken = cBoard.Token(cBoardMove.ToX(), cBoardMove.ToY());
 
         // If the token is a King
         if (cToken == m_kcKingToken)
@@ -1004,10 +1192,10 @@ bool ChessGame::ApplyMove(int nPlayer, GameMove &cGameMove)
             int nX;
             int nY;
             bool bCastleWest = false;
-            GameMove cRookMove;
+            BoardMove cRookMove;
 
             // if the King moved movre than 1 square
-            if (abs(cGameMove.FromX() - cGameMove.ToX()) > 1)
+            if (abs(cBoardMove.FromX() - cBoardMove.ToX()) > 1)
             {
                 bValidMove = false;
 
@@ -1016,7 +1204,7 @@ bool ChessGame::ApplyMove(int nPlayer, GameMove &cGameMove)
                 //
 
                 // If King moved more than one square to the west
-                if (cGameMove.FromX() - cGameMove.ToX() > 1)
+                if (cBoardMove.FromX() - cBoardMove.ToX() > 1)
                 {
                     nX = 0;
                     bCastleWest = true;
@@ -1024,91 +1212,269 @@ bool ChessGame::ApplyMove(int nPlayer, GameMove &cGameMove)
                 // Else King moved more than one square to the west
                 else
                 {
-                    nX = cGameMove.FromX() + 2;
+                    nX = cBoardMove.FromX() + 2;
                 }
 
                 // The King's from file
-                nY = cGameMove.FromY();
+                nY = cBoardMove.FromY();
 
-                if (FindPiece(nX, nY, nPlayer, m_kcRookToken))
+                if (FindPiece(nX, nY, nPlayer, m_kcRookToken) && (nY == cBoardMove.FromY()))
                 {
                     //
                     // Move Rook
                     //
                     cRookMove.SetFromX(nX);
-                    cRookMove.SetFromY(cGameMove.FromY());
-                    cRookMove.SetToY(cGameMove.FromY());
+                    cRookMove.SetFromY(cBoardMove.FromY());
+                    cRookMove.SetToY(cBoardMove.FromY());
 
                     if (bCastleWest)
                     {
-                        cRookMove.SetToX(cGameMove.ToX() + 1);
+                        cRookMove.SetToX(cBoardMove.ToX() + 1);
                     }
                     else
                     {
-                        cRookMove.SetToX(cGameMove.ToX() - 1);
+                        cRookMove.SetToX(cBoardMove.ToX() - 1);
                     }
 
-                    // Update the ZobristKey to reflect the movement of the rook
-                    cBoard.UpdateZobristKey(cGameMove.FromX(), cGameMove.FromY(), cGameMove.FromX(), cGameMove.FromY());
+                    // Update the ZobristKey to reflect the removal of the rook from its square
+                    UpdateZobristKeys(cRookMove.FromX(), cRookMove.FromY(), cRookMove.FromX(), cRookMove.FromY());
 
                     if (cBoard.MovePiece(cRookMove)) //TODO: Check return code
                     {
                         bValidMove = true;
-                        m_abCastlingAllowed[nPlayer - 1] = false;
+                        bIrreversible = true;
                         m_abKingCastled[nPlayer - 1] = true;
 
-                        // Update the ZobristKey to reflect the movement of the rook
-                        cBoard.UpdateZobristKey(cGameMove.ToX(), cGameMove.ToY(), cGameMove.ToX(), cGameMove.ToY());
+                        // Update the ZobristKey to reflect the rook on its new square
+                        UpdateZobristKeys(cRookMove.ToX(), cRookMove.ToY(), cRookMove.ToX(), cRookMove.ToY());
                     }
                 }
             }
         }
     }
 
-    // If move is valid, insert current Zobrist hash into the container
-    if (bValidMove) m_uomsZobrist.insert(cBoard.ZKey());
+    // Update the ZobristKey to reflect any lost castling rights
+    if (kbCastlingPiece)
+    {
+        // A King that has moved, castling or not, may no longer castle
+        if (cBoard.Token(cBoardMove.ToX(), cBoardMove.ToY()) == m_kcKingToken)
+            m_abCastlingAllowed[nPlayer - 1] = false;
+
+        UpdateCastlingKeys(1, anCastlingRights[0] ^ CastlingRights(1));
+        UpdateCastlingKeys(2, anCastlingRights[1] ^ CastlingRights(2));
+    }
+
+    // If move is valid, push the current Zobrist hash onto the history
+    if (bValidMove)
+    {
+        // Remove any earlier en passant file, and add one if a pawn moved two squares
+        if (m_nEnPassantFile != -1)
+        {
+            cBoard.UpdateZobristKey(Zobrist::EnPassantFile(m_nEnPassantFile));
+            m_nEnPassantFile = -1;
+        }
+
+        if (Rules::m_kbEnPassant && (cBoard.Token(cBoardMove.ToX(), cBoardMove.ToY()) == m_kcPawnToken) &&
+            (abs(cBoardMove.FromY() - cBoardMove.ToY()) == 2))
+        {
+            m_nEnPassantFile = cBoardMove.ToX();
+            cBoard.UpdateZobristKey(Zobrist::EnPassantFile(m_nEnPassantFile));
+        }
+
+        // The other player is to move
+        cBoard.UpdateZobristKey(Zobrist::SideToMove());
+
+        if (bIrreversible)
+            m_nPliesSinceIrreversible = 0;
+        else
+            ++m_nPliesSinceIrreversible;
+
+        m_cZobristHistory.Push(cBoard.ZKey());
+    }
 
     return bValidMove;
 }
 
 /**
-  * Generate a vector of possible moves for a piece located at GameMove
-  * coordinates.
+  * Initialize the position.
   *
-  * \param nPlayer   The player whose turn it is.
-  * \param cGameMove The player's move
+  * Initialize the board Zobrist key, including castling rights, then the
+  * pawn key from the pawns on the board, record where the Kings stand, and
+  * start the key history with the starting position.  Called once the starting position is set.
+  */
+
+template <class Rules>
+void ChessGame<Rules>::InitializePosition()
+{
+    cBoard.InitializeZobrist();
+
+    for (int nPlayer = 1; nPlayer <= 2; ++nPlayer)
+    {
+        for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
+        {
+            const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+            const int knX = GameBoard::SquareX(knSquare);
+            const int knY = GameBoard::SquareY(knSquare);
+
+            if (cBoard.Token(knX, knY) == m_kcPawnToken)
+                cBoard.UpdatePawnZobristKey(knX, knY, knX, knY);
+
+            if (cBoard.Token(knX, knY) == m_kcKingToken)
+            {
+                m_anKingX[nPlayer - 1] = knX;
+                m_anKingY[nPlayer - 1] = knY;
+            }
+        }
+    }
+
+    // Castling rights are found from the Kings and Rooks
+    UpdateCastlingKeys(1, CastlingRights(1));
+    UpdateCastlingKeys(2, CastlingRights(2));
+
+    m_cZobristHistory.Push(cBoard.ZKey());
+}
+
+/**
+  * Return the castling rights of a player.
+  *
+  * A player may castle toward each unmoved Rook on the King's rank, until
+  * the King moves.
   *
-  * \return A vector of possible moves.
+  * \param nPlayer The player
+  *
+  * \return The sides the player may castle to, as m_knCastleWest and m_knCastleEast bits.
   */
 
-std::vector<GameMove> ChessGame::GenerateMovesForPiece(int nPlayer, const GameMove &cGameMove) const
+template <class Rules>
+int ChessGame<Rules>::CastlingRights(int nPlayer) const
 {
-    std::vector<GameMove> vGameMoves {};
+    int nRights {0};
+
+    if (!Rules::m_kbCastling || !m_abCastlingAllowed[nPlayer - 1])
+        return nRights;
 
-    if (cBoard.PositionOccupiedByPlayer(cGameMove.FromX(), cGameMove.FromY(), nPlayer))
+    const int knKX = m_anKingX[nPlayer - 1];
+    const int knKY = m_anKingY[nPlayer - 1];
+
+    for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
     {
-        char cToken = cBoard.Token(cGameMove.FromX(), cGameMove.FromY());
+        const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+        const int knX = GameBoard::SquareX(knSquare);
+        const int knY = GameBoard::SquareY(knSquare);
+
+        if ((knY == knKY) && (cBoard.Token(knX, knY) == m_kcRookToken) && !cBoard.Piece(knX, knY).HasMoved())
+            nRights |= (knX < knKX) ? m_knCastleWest : m_knCastleEast;
+    }
+
+    return nRights;
+}
+
+/**
+  * Toggle the castling keys of a player.
+  *
+  * \param nPlayer        The player
+  * \param nChangedRights The sides whose castling rights were gained or lost
+  */
+
+template <class Rules>
+void ChessGame<Rules>::UpdateCastlingKeys(int nPlayer, int nChangedRights)
+{
+    if (nChangedRights & m_knCastleWest)
+        cBoard.UpdateZobristKey(Zobrist::Castling(nPlayer, 0));
+
+    if (nChangedRights & m_knCastleEast)
+        cBoard.UpdateZobristKey(Zobrist::Castling(nPlayer, 1));
+}
+
+/**
+  * Count the repetitions of the current position.
+  *
+  * Scan the Zobrist key history backwards from the current position, two
+  * plies at a time so that the same player is to move, stopping at the last
+  * irreversible move since no earlier position can recur.
+  *
+  * \return The number of times the current position has been reached,
+  * including now.
+  */
+
+template <class Rules>
+int ChessGame<Rules>::Repetitions() const
+{
+    int nRepetitions {1};
+
+    const int knTop    = static_cast<int>(m_cZobristHistory.Size()) - 1;
+    const int knBottom = std::max(knTop - m_nPliesSinceIrreversible, 0);
+
+    for (int iii = knTop - 2; iii >= knBottom; iii -= 2)
+    {
+        if (m_cZobristHistory[iii] == m_cZobristHistory[knTop])
+            ++nRepetitions;
+    }
+
+    return nRepetitions;
+}
+
+/**
+  * Update the Zobrist keys.
+  *
+  * Update the board Zobrist key, and the pawn Zobrist key if the piece is a
+  * pawn.
+  *
+  * \param nPX X-coordinate of the piece
+  * \param nPY Y-coordinate of the piece
+  * \param nSX X-coordinate of the square
+  * \param nSY Y-coordinate of the square
+  */
+
+template <class Rules>
+void ChessGame<Rules>::UpdateZobristKeys(int nPX, int nPY, int nSX, int nSY)
+{
+    cBoard.UpdateZobristKey(nPX, nPY, nSX, nSY);
+
+    if (cBoard.Token(nPX, nPY) == m_kcPawnToken)
+        cBoard.UpdatePawnZobristKey(nPX, nPY, nSX, nSY);
+}
+
+/**
+  * Fill a list with the possible moves for a piece located at BoardMove
+  * coordinates.
+  *
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The player's move
+  * \param cMoveList  The list to fill with possible moves
+  */
+
+template <class Rules>
+void ChessGame<Rules>::GenerateMovesForPiece(int nPlayer, const BoardMove &cBoardMove, MoveList &cMoveList) const
+{
+    cMoveList.Clear();
+
+    // Generated moves carry their own promotion, not the one asked for
+    BoardMove cPieceMove = cBoardMove;
+    cPieceMove.SetPromotion(0);
+
+    if (cBoard.PositionOccupiedByPlayer(cBoardMove.FromX(), cBoardMove.FromY(), nPlayer))
+    {
+        char cToken = cBoard.Token(cBoardMove.FromX(), cBoardMove.FromY());
 
         if (cToken == m_kcPawnToken)
-            GeneratePawnMoves(cGameMove, nPlayer, vGameMoves);
+            GeneratePawnMoves(cPieceMove, nPlayer, cMoveList);
 
         if (cToken == m_kcRookToken)
-            GenerateRookMoves(cGameMove, nPlayer, vGameMoves);
+            GenerateRookMoves(cPieceMove, nPlayer, cMoveList);
 
         if (cToken == m_kcKnightToken)
-            GenerateKnightMoves(cGameMove, nPlayer, vGameMoves);
+            GenerateKnightMoves(cPieceMove, nPlayer, cMoveList);
 
         if (cToken == m_kcBishopToken)
-            GenerateBishopMoves(cGameMove, nPlayer, vGameMoves);
+            GenerateBishopMoves(cPieceMove, nPlayer, cMoveList);
 
         if (cToken == m_kcQueenToken)
-            GenerateQueenMoves(cGameMove, nPlayer, vGameMoves);
+            GenerateQueenMoves(cPieceMove, nPlayer, cMoveList);
 
         if (cToken == m_kcKingToken)
-            GenerateKingMoves(cGameMove, nPlayer, vGameMoves);
+            GenerateKingMoves(cPieceMove, nPlayer, cMoveList);
     }
-
-    return vGameMoves;
 }
 
 /**
@@ -1116,7 +1482,8 @@ std::vector<GameMove> ChessGame::GenerateMovesForPiece(int nPlayer, const GameMo
   *
   * Using the passed coordinates as a starting place, find a piece on the
   * board moving left to right and up each row.  If the peice is found, update
-  * the passed coordinates with the location and return true.
+  * the passed coordinates with the location and return true.  Only the
+  * player's piece list is searched.
   *
   * \param nX      The X-Coordinate location to begin the search
   * \param nY      The Y-Coordinate location to begin the search
@@ -1126,22 +1493,32 @@ std::vector<GameMove> ChessGame::GenerateMovesForPiece(int nPlayer, const GameMo
   * \return True if piece found, false otherwise.
   */
 
-bool ChessGame::FindPiece(int &nX, int &nY, int nPlayer, char cToken) const
+template <class Rules>
+bool ChessGame<Rules>::FindPiece(int &nX, int &nY, int nPlayer, char cToken) const
 {
-    for (int yyy = nY; yyy < m_knY; ++yyy)
+    const int knStart = (nY * Rules::m_knX) + nX;
+    int nFound = -1;
+
+    // Of the matching pieces at or after the starting place, keep the first in board order
+    for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
     {
-        for (int xxx = nX; xxx < m_knX; ++xxx)
+        const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+        const int knX = GameBoard::SquareX(knSquare);
+        const int knY = GameBoard::SquareY(knSquare);
+        const int knOrder = (knY * Rules::m_knX) + knX;
+
+        if ((knOrder >= knStart) && ((nFound == -1) || (knOrder < nFound)) && (cBoard.Token(knX, knY) == cToken))
         {
-            if ((cBoard.Token(xxx, yyy) == cToken) && (cBoard.Player(xxx, yyy) == nPlayer))
-            {
-                nX = xxx;
-                nY = yyy;
-                return true;
-            }
+            nFound = knOrder;
         }
     }
 
-    return false;
+    if (nFound == -1)
+        return false;
+
+    nX = nFound % Rules::m_knX;
+    nY = nFound / Rules::m_knX;
+    return true;
 }
 
 /**
@@ -1150,34 +1527,27 @@ bool ChessGame::FindPiece(int &nX, int &nY, int nPlayer, char cToken) const
   * Check whether the to be moved piece is a King.  If so, rotate around the To
   * coordinates to ensure that the opposing King is not adjacent.
   *
-  * \param cGameMove The game move
+  * \param cBoardMove The game move
   * \param nPlayer The player to search for
   *
   * \return True if Kings are adjacent, false otherwise.
   */
 
-bool ChessGame::TestForAdjacentKings(const GameMove &cGameMove, int nPlayer) const
+template <class Rules>
+bool ChessGame<Rules>::TestForAdjacentKings(const BoardMove &cBoardMove, int nPlayer) const
 {
     // Grab piece on From coordinates.  If not a King, return false;
-    GamePiece cPiece = cBoard.Piece(cGameMove.FromX(), cGameMove.FromY());
+    GamePiece cPiece = cBoard.Piece(cBoardMove.FromX(), cBoardMove.FromY());
     if (cPiece.Token() != m_kcKingToken)
         return false;
 
-    // Find the opposing King
-    int nKX  {0};
-    int nKY  {0};
-
-    if (!FindPiece(nKX, nKY, 3 - nPlayer, m_kcKingToken))
-    {
-        std::string sErrorMessage  = "Could not find King for Player " + std::to_string(nPlayer);
-        std::cerr << sErrorMessage << std::endl;
-        std::cout << "Exiting" << std::endl;
-        throw GameAIException(sErrorMessage);
-    }
+    // The opposing King
+    int nKX = m_anKingX[2 - nPlayer];
+    int nKY = m_anKingY[2 - nPlayer];
 
     // Rotate around the game move To coordinates looking for the opposing King
-    int nToX = cGameMove.ToX();
-    int nToY = cGameMove.ToY();
+    int nToX = cBoardMove.ToX();
+    int nToY = cBoardMove.ToY();
 
     // North
     if ((nToX == nKX) && (nToY + 1 == nKY))
@@ -1224,29 +1594,18 @@ bool ChessGame::TestForAdjacentKings(const GameMove &cGameMove, int nPlayer) con
   * \return True if King is in check, false otherwise.
   */
 
-bool ChessGame::KingInCheck(int nPlayer) const
+template <class Rules>
+bool ChessGame<Rules>::KingInCheck(int nPlayer) const
 {
-    int nKX {0};
-    int nKY {0};
+    const int knKX = m_anKingX[nPlayer - 1];
+    const int knKY = m_anKingY[nPlayer - 1];
 
-    if (!FindPiece(nKX, nKY, nPlayer, m_kcKingToken))
+    for (int iii = 0; iii < cBoard.PieceCount(3 - nPlayer); ++iii)
     {
-        std::string sErrorMessage  = "Could not find King for Player " + std::to_string(nPlayer);
-        std::cerr << sErrorMessage << std::endl;
-        std::cout << "Exiting" << std::endl;
-        throw GameAIException("Could not find King ");
-    }
+        const int knSquare = cBoard.PieceSquare(3 - nPlayer, iii);
 
-    for (int yyy = 0; yyy < m_knY; ++yyy)
-    {
-        for (int xxx = 0; xxx < m_knX; ++xxx)
-        {
-            if (cBoard.PositionOccupiedByPlayer(xxx, yyy, 3 - nPlayer))
-            {
-                if (AttackingTheKing(nKX, nKY, nPlayer, xxx, yyy))
-                    return true;
-            }
-        }
+        if (AttackingTheKing(knKX, knKY, nPlayer, GameBoard::SquareX(knSquare), GameBoard::SquareY(knSquare)))
+            return true;
     }
 
     return false;
@@ -1264,17 +1623,24 @@ bool ChessGame::KingInCheck(int nPlayer) const
   * \return True if Kthe opposing piece is attacking the King, false otherwise.
   */
 
-bool ChessGame::AttackingTheKing(int nKX, int nKY, int nPlayer, int nX, int nY) const
+template <class Rules>
+bool ChessGame<Rules>::AttackingTheKing(int nKX, int nKY, int nPlayer, int nX, int nY) const
 {
-    GameMove cGameMove;
-    cGameMove.SetFromX(nX);
-    cGameMove.SetFromY(nY);
-    cGameMove.SetTestMove(true);
-
-    std::vector<GameMove> vGameMoves = GenerateMovesForPiece(3 - nPlayer, cGameMove);
-    for (GameMove cGameMove: vGameMoves)
+    // A King attacks only the squares next to it.  Generating its moves
+    // would also generate castling, which tests the other King for check.
+    if (cBoard.Token(nX, nY) == m_kcKingToken)
+        return (abs(nKX - nX) <= 1) && (abs(nKY - nY) <= 1);
+
+    BoardMove cBoardMove;
+    cBoardMove.SetFromX(nX);
+    cBoardMove.SetFromY(nY);
+    cBoardMove.SetTestMove(true);
+
+    MoveList cMoveList;
+    GenerateMovesForPiece(3 - nPlayer, cBoardMove, cMoveList);
+    for (const BoardMove &cPieceMove : cMoveList)
     {
-        if ((cGameMove.ToX() == nKX) && (cGameMove.ToY() == nKY))
+        if ((cPieceMove.ToX() == nKX) && (cPieceMove.ToY() == nKY))
         {
             return true;
         }
@@ -1294,11 +1660,17 @@ bool ChessGame::AttackingTheKing(int nKX, int nKY, int nPlayer, int nX, int nY)
   * \return A string containing the move.
   */
 
-std::string ChessGame::AnnounceMove(int nPlayer, const GameMove &cGameMove) const
+template <class Rules>
+std::string ChessGame<Rules>::AnnounceMove(int nPlayer, const GameMove &cGameMove) const
 {
+    // A generated move carries the promotion without its token
+    GameMove cAnnouncedMove = cGameMove;
+    if (cAnnouncedMove.PromotionInput() == '\0')
+        cAnnouncedMove.SetPromotion(cGameMove.Promotion(), PromotionToken(cGameMove.Promotion()));
+
     std::string sMessage = "\rMove number: " + std::to_string(m_nNumberOfMoves + 1) +
         "  Player: " + std::to_string(nPlayer) +
-        "  Moves From: " + cGameMove.AnnounceFromMove() +" To: " + cGameMove.AnnounceToMove();
+        "  Moves From: " + cAnnouncedMove.AnnounceFromMove() +" To: " + cAnnouncedMove.AnnounceToMove();
 
     return sMessage;
 }
@@ -1316,7 +1688,8 @@ std::string ChessGame::AnnounceMove(int nPlayer, const GameMove &cGameMove) cons
   * \return An integer representing game state for the player.
   */
 
-int ChessGame::EvaluateGameState(int nPlayer)
+template <class Rules>
+int ChessGame<Rules>::EvaluateGameState(int nPlayer)
 {
     // If won, return largest positive integer // TODO: make these constants
     if (m_nWinner == nPlayer)
@@ -1365,195 +1738,268 @@ int ChessGame::EvaluateGameState(int nPlayer)
   * \return An integer representing the value of pieces for this player.
   */
 
-int ChessGame::CountEvaluation(int nPlayer) const
+template <class Rules>
+int ChessGame<Rules>::CountEvaluation(int nPlayer) const
 {
     int nEval = 0;
 
-    for (int yyy = 0; yyy < m_knY; ++yyy)
+    for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
     {
-        for (int xxx = 0; xxx < m_knX; ++xxx)
-        {
-            if (cBoard.PositionOccupiedByPlayer(xxx, yyy, nPlayer))
-            {
-                nEval += cBoard.PieceValue(xxx, yyy);
-            }
-        }
+        const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+        nEval += cBoard.PieceValue(GameBoard::SquareX(knSquare), GameBoard::SquareY(knSquare));
     }
 
     return nEval;
 }
 
 /**
-  * Evaluate the mobility (number of moves) for this player.
+  * Evaluate the mobility (number of pseudo-legal moves) for this player.
+  *
+  * Count, for every piece, the squares it could move to that are empty or
+  * held by the opponent.  No GameMove objects are built and no move is tested
+  * for leaving the King in check, so pinned pieces, castling and en passant
+  * are not reflected in the count.  That slight inaccuracy is acceptable for
+  * an evaluation term and avoids the game clone per move that GenerateMoves()
+  * needs for its legality test.
+  *
+  * Measured over 2000 evaluations on a position twelve plies in: Gardner
+  * Minichess 367 us to 1.1 us per evaluation; Chess 978 us to 2.2 us.
   *
   * \param nPlayer The player whose turn it is.
   *
-  * \return An integer representing the number of valid moves for the player.
+  * \return An integer representing the number of pseudo-legal moves for the player.
   */
 
-int ChessGame::MobilityEvaluation(int nPlayer)
+template <class Rules>
+int ChessGame<Rules>::MobilityEvaluation(int nPlayer) const
 {
-    std::vector<GameMove> vGameMoves = GenerateMoves(nPlayer);
+    int nMobility {0};
+    int nNewY;
+
+    for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
+    {
+        const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+        const int xxx = GameBoard::SquareX(knSquare);
+        const int yyy = GameBoard::SquareY(knSquare);
+
+        switch (cBoard.Token(xxx, yyy))
+        {
+            case m_kcPawnToken:
+                nNewY = (nPlayer == 1) ? yyy + 1 : yyy - 1;
+                if (!OnBoard(xxx, nNewY))
+                    break;
+                if (!cBoard.PositionOccupied(xxx, nNewY))
+                    ++nMobility;
+                if (OnBoard(xxx - 1, nNewY) && cBoard.PositionOccupiedByPlayer(xxx - 1, nNewY, 3 - nPlayer))
+                    ++nMobility;
+                if (OnBoard(xxx + 1, nNewY) && cBoard.PositionOccupiedByPlayer(xxx + 1, nNewY, 3 - nPlayer))
+                    ++nMobility;
+                break;
+
+            case m_kcKnightToken:
+                for (const auto &aiOffset : m_kaiKnightOffsets)
+                    nMobility += RayMobility(xxx, yyy, nPlayer, aiOffset[0], aiOffset[1], false);
+                break;
+
+            case m_kcRookToken:
+                for (int jjj = 0; jjj < 4; ++jjj)
+                    nMobility += RayMobility(xxx, yyy, nPlayer, m_kaiKingOffsets[jjj][0], m_kaiKingOffsets[jjj][1], true);
+                break;
+
+            case m_kcBishopToken:
+                for (int jjj = 4; jjj < 8; ++jjj)
+                    nMobility += RayMobility(xxx, yyy, nPlayer, m_kaiKingOffsets[jjj][0], m_kaiKingOffsets[jjj][1], true);
+                break;
+
+            case m_kcQueenToken:
+                for (const auto &aiOffset : m_kaiKingOffsets)
+                    nMobility += RayMobility(xxx, yyy, nPlayer, aiOffset[0], aiOffset[1], true);
+                break;
+
+            case m_kcKingToken:
+                for (const auto &aiOffset : m_kaiKingOffsets)
+                    nMobility += RayMobility(xxx, yyy, nPlayer, aiOffset[0], aiOffset[1], false);
+                break;
+
+            default:
+                break;
+        }
+    }
 
-    return vGameMoves.size();
+    return nMobility;
+}
+
+/**
+  * Count the squares reachable along one direction.
+  *
+  * Step from the origin by (nDX, nDY), counting empty squares and stopping
+  * after an opponent's piece, a player's own piece, or the edge of the board.
+  *
+  * \param nX The X-Coordinate of the piece
+  * \param nY The Y-Coordinate of the piece
+  * \param nPlayer The player who owns the piece
+  * \param nDX The X step
+  * \param nDY The Y step
+  * \param bUnlimitedMoves Whether to continue past the first square
+  *
+  * \return The number of reachable squares.
+  */
+
+template <class Rules>
+int ChessGame<Rules>::RayMobility(int nX, int nY, int nPlayer, int nDX, int nDY, bool bUnlimitedMoves) const
+{
+    int nCount {0};
+
+    nX += nDX;
+    nY += nDY;
+
+    while (OnBoard(nX, nY))
+    {
+        if (cBoard.PositionOccupiedByPlayer(nX, nY, nPlayer))
+            break;
+
+        ++nCount;
+
+        if (cBoard.PositionOccupied(nX, nY) || !bUnlimitedMoves)
+            break;
+
+        nX += nDX;
+        nY += nDY;
+    }
+
+    return nCount;
 }
 
 /**
   * Count the number of doubled, isolated, and passed pawns for this player.
   *
+  * Pawn structure changes far less often than the rest of the position, so
+  * the counts for both players are cached in the pawn hash table under the
+  * pawn Zobrist key.  The board is only scanned on a cache miss.
+  *
   * \param nPlayer The player whose turn it is.
   * \param nDoubled The count of doubled pawns
   * \param nIsolated The count of isolated pawns
   * \param nPassed the count of passed pawns
   */
 
-void ChessGame::CountPawns(int nPlayer, int &nDoubled, int &nIsolated, int &nPassed) const
+template <class Rules>
+void ChessGame<Rules>::CountPawns(int nPlayer, int &nDoubled, int &nIsolated, int &nPassed) const
 {
-    int nX {0};
-    int nY {0};
-    bool bIsolated {false};
-    bool bPassed   {false};
+    const uint64_t kuiKey = cBoard.PawnZKey();
+    const PawnHashTable::Entry *pstEntry = m_pcPawnHashTable->Probe(kuiKey);
 
-    for (int yyy = 0; yyy < m_knY; ++yyy)
+    if (pstEntry == nullptr)
     {
-        for (int xxx = 0; xxx < m_knX; ++xxx)
+        PawnHashTable::Entry stEntry;
+        stEntry.uiKey  = kuiKey;
+        stEntry.bValid = true;
+
+        for (int iii = 0; iii < 2; ++iii)
         {
-            // If piece is Pawn
-            if (cBoard.Token(xxx, yyy) == m_kcPawnToken)
-            {
-                // If occupied by nPlayer?
-                if (cBoard.PositionOccupiedByPlayer(xxx, yyy, nPlayer))
-                {
-                    //
-                    // Count Doubled Pawns
-                    //
+            ScanPawns(iii + 1, stEntry.anDoubled[iii], stEntry.anIsolated[iii], stEntry.anPassed[iii]);
+        }
 
-                    // Calculate correct square to evaluate next
-                    if (nPlayer == 1)
-                        nY = yyy + 1;
-                    else
-                        nY = yyy - 1;
+        m_pcPawnHashTable->Store(stEntry);
+        pstEntry = m_pcPawnHashTable->Probe(kuiKey);
+    }
 
-                    // If the piece is a Pawn. increment count
-                    if (cBoard.Token(xxx, nY) == m_kcPawnToken)
-                    {
-                        // If the square ahead of the Pawn is occupied by the player
-                        if (cBoard.PositionOccupiedByPlayer(xxx, nY, nPlayer))
-                        {
-                            ++nDoubled;
-                        }
-                    }
+    nDoubled  += pstEntry->anDoubled[nPlayer - 1];
+    nIsolated += pstEntry->anIsolated[nPlayer - 1];
+    nPassed   += pstEntry->anPassed[nPlayer - 1];
+}
 
-                    //
-                    // Count Isolated Pawns
-                    //
+/**
+  * Scan the board for doubled, isolated, and passed pawns for this player.
+  *
+  * \param nPlayer The player whose turn it is.
+  * \param nDoubled The count of doubled pawns
+  * \param nIsolated The count of isolated pawns
+  * \param nPassed the count of passed pawns
+  */
 
-                    bIsolated = true;
+template <class Rules>
+void ChessGame<Rules>::ScanPawns(int nPlayer, int &nDoubled, int &nIsolated, int &nPassed) const
+{
+    // For each player and file, the number of pawns and the lowest and highest ranks they stand on
+    int aanCount[2][Rules::m_knX]   {};
+    int aanLowest[2][Rules::m_knX]  {};
+    int aanHighest[2][Rules::m_knX] {};
 
-                    // Find a friendly pawn to the west
-                    if (cBoard.ValidLocation(xxx - 1, 0))
-                    {
-                        nX = xxx - 1;
-                        nY = 0;
-                        if (FindPiece(nX, nY, nPlayer, m_kcPawnToken))
-                        {
-                            if (nX == xxx - 1)
-                            {
-                                bIsolated = false;
-                            }
-                        }
-                    }
+    for (int nPawnPlayer = 1; nPawnPlayer <= 2; ++nPawnPlayer)
+    {
+        for (int iii = 0; iii < cBoard.PieceCount(nPawnPlayer); ++iii)
+        {
+            const int knSquare = cBoard.PieceSquare(nPawnPlayer, iii);
+            const int knX = GameBoard::SquareX(knSquare);
+            const int knY = GameBoard::SquareY(knSquare);
+
+            if (cBoard.Token(knX, knY) != m_kcPawnToken)
+                continue;
+
+            int &nCount = aanCount[nPawnPlayer - 1][knX];
+            if ((nCount == 0) || (knY < aanLowest[nPawnPlayer - 1][knX]))
+                aanLowest[nPawnPlayer - 1][knX] = knY;
+            if ((nCount == 0) || (knY > aanHighest[nPawnPlayer - 1][knX]))
+                aanHighest[nPawnPlayer - 1][knX] = knY;
+            ++nCount;
+        }
+    }
 
-                    // If we did not find one to the west, find a friendly pawn to the east
-                    if ((bIsolated) && (cBoard.ValidLocation(xxx + 1, 0)))
-                    {
-                        nX = xxx + 1;
-                        nY = 0;
-                        if (FindPiece(nX, nY, nPlayer, m_kcPawnToken))
-                        {
-                            if (nX == xxx + 1)
-                            {
-                                bIsolated = false;
-                            }
-                        }
-                    }
+    const int knMe       = nPlayer - 1;
+    const int knOpponent = 2 - nPlayer;
 
-                    if (bIsolated)
-                    {
-                        ++nIsolated;
-                    }
+    //
+    // Count Doubled Pawns - every pawn beyond the first on a file
+    //
 
-                    //
-                    // Count Passed Pawns
-                    //
+    for (int xxx = 0; xxx < Rules::m_knX; ++xxx)
+    {
+        if (aanCount[knMe][xxx] > 1)
+            nDoubled += aanCount[knMe][xxx] - 1;
+    }
 
-                    bPassed = true;
+    for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
+    {
+        const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+        const int knX = GameBoard::SquareX(knSquare);
+        const int knY = GameBoard::SquareY(knSquare);
 
-                    // Find an unfriendly pawn to the west and ahead of this pawn
-                    if (cBoard.ValidLocation(xxx - 1, 0))
-                    {
-                        nX = xxx - 1;
-                        nY = 0;
-                        if (FindPiece(nX, nY, 3 - nPlayer, m_kcPawnToken))
-                        {
-                            if (nX == xxx - 1)
-                            {
-                                if (nPlayer == 1)
-                                {
-                                    if (nY > yyy)
-                                    {
-                                        bPassed = false;
-                                    }
-                                }
-                                else
-                                {
-                                    if (nY < yyy)
-                                    {
-                                        bPassed = false;
-                                    }
-                                }
-                            }
-                        }
-                    }
+        if (cBoard.Token(knX, knY) != m_kcPawnToken)
+            continue;
 
-                    // If we did not find one to the west, find a unfriendly pawn to the east
-                    if ((bPassed) && (cBoard.ValidLocation(xxx + 1, 0)))
-                    {
-                        nX = xxx + 1;
-                        nY = 0;
-                        if (FindPiece(nX, nY, nPlayer, m_kcPawnToken))
-                        {
-                            if (nX == xxx - 1)
-                            {
-                                if (nPlayer == 1)
-                                {
-                                    if (nY > yyy)
-                                    {
-                                        bPassed = false;
-                                    }
-                                }
-                                else
-                                {
-                                    if (nY < yyy)
-                                    {
-                                        bPassed = false;
-                                    }
-                                }
-                            }
-                        }
-                    }
+        //
+        // Count Isolated Pawns - no friendly pawn on either adjacent file
+        //
 
-                    if (bPassed)
-                    {
-                        ++nPassed;
-                    }
+        bool bIsolated = true;
+        if ((knX > 0) && (aanCount[knMe][knX - 1] > 0))
+            bIsolated = false;
+        if ((knX < Rules::m_knX - 1) && (aanCount[knMe][knX + 1] > 0))
+            bIsolated = false;
 
-                }
-            }
+        if (bIsolated)
+            ++nIsolated;
+
+        //
+        // Count Passed Pawns - no unfriendly pawn ahead on this or either adjacent file
+        //
+
+        bool bPassed = true;
+        for (int xxx = std::max(knX - 1, 0); xxx <= std::min(knX + 1, Rules::m_knX - 1); ++xxx)
+        {
+            if (aanCount[knOpponent][xxx] == 0)
+                continue;
+
+            if ((nPlayer == 1) && (aanHighest[knOpponent][xxx] > knY))
+                bPassed = false;
+            if ((nPlayer == 2) && (aanLowest[knOpponent][xxx] < knY))
+                bPassed = false;
         }
-    }
 
-    return;
+        if (bPassed)
+            ++nPassed;
+    }
 }
 
 /**
@@ -1565,24 +2011,19 @@ void ChessGame::CountPawns(int nPlayer, int &nDoubled, int &nIsolated, int &nPas
   * the player.
   */
 
-int ChessGame::MinorPiecesDevelopedEvaluation(int nPlayer) const
+template <class Rules>
+int ChessGame<Rules>::MinorPiecesDevelopedEvaluation(int nPlayer) const
 {
     int nEval {0};
 
-    for (int yyy = 0; yyy < m_knY; ++yyy)
+    for (int iii = 0; iii < cBoard.PieceCount(nPlayer); ++iii)
     {
-        for (int xxx = 0; xxx < m_knX; ++xxx)
+        const int knSquare = cBoard.PieceSquare(nPlayer, iii);
+        const GamePiece &cPiece = cBoard.Piece(GameBoard::SquareX(knSquare), GameBoard::SquareY(knSquare));
+
+        if ((cPiece.Value() == m_knMinorPieceValue) && cPiece.HasMoved())
         {
-            if (cBoard.PositionOccupiedByPlayer(xxx, yyy, nPlayer))
-            {
-                if (cBoard.PieceValue(xxx, yyy) == 3)
-                {
-                    if (cBoard.Piece(xxx, yyy).HasMoved())
-                    {
-                        ++nEval;
-                    }
-                }
-            }
+            ++nEval;
         }
     }
 
@@ -1597,22 +2038,21 @@ int ChessGame::MinorPiecesDevelopedEvaluation(int nPlayer) const
   * \return True if Rooks are connected, false otherwise.
   */
 
-bool ChessGame::RooksConnected(int nPlayer) const
+template <class Rules>
+bool ChessGame<Rules>::RooksConnected(int nPlayer) const
 {
     bool bRooksConnected {false};
     int nFirstX  {0};
     int nFirstY  {0};
-    int nSecondX {0};
-    int nSecondY {0};
 
     // Find first Rook
     if (FindPiece(nFirstX, nFirstY, nPlayer, m_kcRookToken))
     {
-        nSecondX = nFirstX;
-        nSecondY = nFirstY;
+        int nSecondX = nFirstX;
+        int nSecondY = nFirstY;
 
         // Update coordinates to find another Rook
-        if (nFirstX < m_knX - 1)
+        if (nFirstX < Rules::m_knX - 1)
         {
             ++nSecondX;
         }
@@ -1636,7 +2076,7 @@ bool ChessGame::RooksConnected(int nPlayer) const
             {
                 for (int yyy = nFirstY + 1; yyy != nSecondY; ++yyy)
                 {
-                    if (cBoard.PositionOccupied(yyy, nFirstX))
+                    if (cBoard.PositionOccupied(nFirstX, yyy))
                     {
                         bRooksConnected = false;
                         break;
@@ -1648,7 +2088,7 @@ bool ChessGame::RooksConnected(int nPlayer) const
             {
                 for (int xxx = nFirstX + 1; xxx != nSecondX; ++xxx)
                 {
-                    if (cBoard.PositionOccupied(nFirstY, xxx))
+                    if (cBoard.PositionOccupied(xxx, nFirstY))
                     {
                         bRooksConnected = false;
                         break;
@@ -1673,7 +2113,8 @@ bool ChessGame::RooksConnected(int nPlayer) const
   * \return String representing the Zobrist hash.
   */
 
-std::string ChessGame::GameScore() const
+template <class Rules>
+std::string ChessGame<Rules>::GameScore() const
 {
     std::string sMessage {};
 
@@ -1688,18 +2129,42 @@ std::string ChessGame::GameScore() const
 /**
   * Check to see if a player has won the game.
   *
-  * For this player, check various conditions of an ended game.
+  * Call GameEndedWithMoves() and discard the moves.
   *
   * \param nPlayer The player
   *
   * \return True, if any player has won the game.  False otherwise.
   */
 
-bool ChessGame::GameEnded(int nPlayer)
+template <class Rules>
+bool ChessGame<Rules>::GameEnded(int nPlayer)
 {
+    MoveList cMoveList;
+
+    return GameEndedWithMoves(nPlayer, cMoveList);
+}
+
+/**
+  * Check to see if a player has won the game, keeping the valid moves.
+  *
+  * For this player, check various conditions of an ended game.  Checkmate
+  * and stalemate are found by generating the player's moves, so the search
+  * may use them instead of generating them again.
+  *
+  * \param nPlayer   The player
+  * \param cMoveList The list to fill with valid moves
+  *
+  * \return True, if any player has won the game.  False otherwise.
+  */
+
+template <class Rules>
+bool ChessGame<Rules>::GameEndedWithMoves(int nPlayer, MoveList &cMoveList)
+{
+    cMoveList.Clear();
+
     // Clear win variables
     m_nWinner = 0;
-    m_sWinBy.assign("nothing");
+    SetOutcome(GameOutcome::OUTCOME_NOTHING);
 
     if (BoardGame::GameEnded(nPlayer))
         return true;
@@ -1709,26 +2174,26 @@ bool ChessGame::GameEnded(int nPlayer)
     //
 
     // If the last Zobrist hash has been seen three times, this is a threefold repetition of a move and therefore a draw
-    if (m_uomsZobrist.count(cBoard.ZKey()) >= m_knMaxRepetition)
+    if (Repetitions() >= m_knMaxRepetition)
     {
-        m_sWinBy.assign("drawn by threefold repetition");
+        SetOutcome(GameOutcome::OUTCOME_THREEFOLD_REPETITION);
         m_bGameOver = true;
         return true;
     }
 
     // Evaluate whether the player has any valid moves to make
-    std::vector<GameMove> vGameMoves = GenerateMoves(nPlayer);
-    if (vGameMoves.empty())
+    GenerateBoardMoves(nPlayer, cMoveList);
+    if (cMoveList.Empty())
     {
         // If King is in checkmate
         if (KingInCheck(nPlayer))
         {
             m_nWinner = 3 - nPlayer;
-            m_sWinBy.assign("checkmate");
+            SetOutcome(GameOutcome::OUTCOME_CHECKMATE);
         }
         else // If King is not in checkmate
         {
-            m_sWinBy.assign("stalemate");
+            SetOutcome(GameOutcome::OUTCOME_STALEMATE);
         }
 
         m_bGameOver = true;
@@ -1750,7 +2215,8 @@ bool ChessGame::GameEnded(int nPlayer)
   * \return The number of the player whose turn is next.
   */
 
-int ChessGame::ReadMovesFromFile(const std::string &sFileName)
+template <class Rules>
+int ChessGame<Rules>::ReadMovesFromFile(const std::string &sFileName)
 {
     std::fstream fsFile;
     int nPlayer;
@@ -1796,7 +2262,8 @@ int ChessGame::ReadMovesFromFile(const std::string &sFileName)
   * \return True if successful.  False otherwise.
   */
 
-bool ChessGame::WriteMovesToFile(const std::string &sFileName)
+template <class Rules>
+bool ChessGame<Rules>::WriteMovesToFile(const std::string &sFileName)
 {
     std::fstream fsFile;
 
@@ -1859,3 +2326,12 @@ bool ChessGame::WriteMovesToFile(const std::string &sFileName)
 
     return true;
 }
+
+// The rules of each variant.  A variant with a new combination of rules
+// needs its own line here.
+template class ChessGame<ChessRules<8, 8, true,  true,  true >>;    // Chess
+template class ChessGame<ChessRules<5, 5, true,  true,  true >>;    // Gardner, Baby, and Jacobs-Meirovitz
+template class ChessGame<ChessRules<5, 6, true,  true,  true >>;    // Chess Attack
+template class ChessGame<ChessRules<5, 6, true,  false, false>>;    // Speed
+template class ChessGame<ChessRules<5, 6, false, false, false>>;    // Elena, Petty, and Quick
+template class ChessGame<ChessRules<6, 6, false, false, false>>;    // Los Alamos
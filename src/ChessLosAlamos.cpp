@@ -72,7 +72,7 @@ void ChessLosAlamos::SetBoard()
     cBoard.SetPiece(4, 4, cPiece);
     cBoard.SetPiece(5, 4, cPiece);
 
-    cBoard.InitializeZobrist();
+    InitializePosition();
 
     return;
 }
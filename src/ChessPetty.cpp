@@ -65,7 +65,7 @@ void ChessPetty::SetBoard()
     cBoard.SetPiece(3, 4, cPiece);
     cBoard.SetPiece(4, 4, cPiece);
 
-    cBoard.InitializeZobrist();
+    InitializePosition();
 
     return;
 }
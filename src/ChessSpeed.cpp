@@ -31,7 +31,7 @@ void ChessSpeed::SetBoard()
 
     ChessGame::SetBoard();
 
-    cPiece.Set(m_kcRookToken, 1, m_knRookValue, m_knWhitePawnIndex);
+    cPiece.Set(m_kcRookToken, 1, m_knRookValue, m_knWhiteRookIndex);
     cBoard.SetPiece(0, 0, cPiece);
     cPiece.Set(m_kcKnightToken, 1, m_knKnightValue, m_knWhiteKnightIndex);
     cBoard.SetPiece(1, 0, cPiece);
@@ -65,7 +65,7 @@ void ChessSpeed::SetBoard()
     cBoard.SetPiece(3, 4, cPiece);
     cBoard.SetPiece(4, 4, cPiece);
 
-    cBoard.InitializeZobrist();
+    InitializePosition();
 
     return;
 }
@@ -19,77 +19,247 @@
 
 #include "ConnectFour.h"
 
+#include <cassert>
+
 /**
-  * Return a vector of valid game moves.
+  * Fill a list with the valid game moves.
   *
-  * Review and collect all valid moves for a player into a vector.  For
+  * Review and collect all valid moves for a player into a list.  For
   * Connect Four, the nPlayer is ignored because valid moves are the same
   * between both players.
   *
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return A vector of valid moves.
+  * \param nPlayer   The player whose turn it is.
+  * \param cMoveList The list to fill with valid moves
   */
 
-std::vector<GameMove> ConnectFour::GenerateMoves(int nPlayer)
+void ConnectFour::GenerateBoardMoves(int nPlayer, MoveList &cMoveList)
 {
     (void)nPlayer;
 
-    std::vector<GameMove> vGameMoves {};
+    cMoveList.Clear();
 
     for (int xxx = 0; xxx < m_knX; ++xxx)
     {
-        // Find the bottom of the Connect Four grid
-        if (FindBottom(xxx) >= 0)
+        // Find a slot with room for a token
+        if (m_cBitboard.CanPlay(xxx))
         {
             // Create a game move with an X-Coordinate only
-            vGameMoves.emplace_back(0, 0, xxx, 0, false, false);
+            cMoveList.Add(BoardMove(0, 0, xxx, 0, false, false));
         }
     }
-
-    return vGameMoves;
 }
 
 /**
   * Apply the move to the game.
   *
-  * Find the bottom of the grid for the selected move, update the GameMove
-  * object with that location, and pass it to LinearGame for application.
+  * Find the bottom of the grid for the selected move, update a copy of the
+  * BoardMove with that location, and pass it to LinearGame for application.
   *
-  * \param nPlayer The player whose turn it is.
-  * \param cGameMove The game move
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The game move
   *
   * \return True if the move is valid, false otherwise
   */
 
-bool ConnectFour::ApplyMove(int nPlayer, GameMove &cGameMove)
+bool ConnectFour::ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove)
 {
-    cGameMove.SetToY(FindBottom(cGameMove.ToX()));
+    if ((cBoardMove.ToX() < 0) || (cBoardMove.ToX() >= m_knX))
+        return false;
+
+    BoardMove cBottomMove = cBoardMove;
+    cBottomMove.SetToY(FindBottom(cBoardMove.ToX()));
 
-    return LinearGame::ApplyMove(nPlayer, cGameMove);
+    if (!LinearGame::ApplyBoardMove(nPlayer, cBottomMove))
+        return false;
+
+    m_cBitboard.Play(cBoardMove.ToX());
+
+    return true;
+}
+
+/**
+  * Apply a move generated by the game, without validating it.
+  *
+  * As ApplyBoardMove(), but the generated move is known to have room in its
+  * slot.
+  *
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The generated move
+  *
+  * \return True.
+  */
+
+bool ConnectFour::ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove)
+{
+    BoardMove cBottomMove = cBoardMove;
+    cBottomMove.SetToY(FindBottom(cBoardMove.ToX()));
+
+    LinearGame::ApplyTrustedBoardMove(nPlayer, cBottomMove);
+
+    m_cBitboard.Play(cBoardMove.ToX());
+
+    return true;
 }
 
 /**
   * Find the bottom of the Connect Four grid.
   *
-  * For the selected Connect Four vertical slot (X-coordinate), review all locations beginning
-  * from the bottom, and stopping when a location is clear (no piece exists in
-  * that location.)
+  * For the selected Connect Four vertical slot (X-coordinate), count the
+  * tokens in the slot to find the clear location above them.
   *
   * \param x The slot (X-coordinate) of the Conect Four grid.
   *
-  * \return The Y-coordinate of the clear location for the selected slot.
+  * \return The Y-coordinate of the clear location for the selected slot, or -1 if the slot is full.
   */
 
 int ConnectFour::FindBottom(int x) const
 {
-    for (int yyy = m_knY - 1; yyy >= 0; --yyy)
+    if (!m_cBitboard.CanPlay(x))
+        return -1;
+
+    return m_knY - 1 - m_cBitboard.Height(x);
+}
+
+/**
+  * Check to see if a player has won the game, keeping the valid moves.
+  *
+  * Only the player who made the last move can have completed a line of
+  * four, so look for one in that player's bitboard, horizontally,
+  * vertically, and then along each diagonal.  If the game has not ended,
+  * leave the player's moves in cMoveList.
+  *
+  * \param nPlayer   The player
+  * \param cMoveList The list to fill with valid moves
+  *
+  * \return True, if the game has ended.  False otherwise.
+  */
+
+bool ConnectFour::GameEndedWithMoves(int nPlayer, MoveList &cMoveList)
+{
+    cMoveList.Clear();
+
+    // Clear win variables
+    m_nWinner = 0;
+    SetOutcome(GameOutcome::OUTCOME_NOTHING);
+
+    if (BoardGame::GameEnded(nPlayer))
+        return true;
+
+    if (m_cBitboard.Moves() > 0)
+    {
+        const uint64_t kuiTokens = m_cBitboard.Opponent();
+
+        if (ConnectFourBitboard::HorizontalLine(kuiTokens))
+            SetOutcome(GameOutcome::OUTCOME_HORIZONTAL);
+        else if (ConnectFourBitboard::VerticalLine(kuiTokens))
+            SetOutcome(GameOutcome::OUTCOME_VERTICAL);
+        else if (ConnectFourBitboard::DiagonalULLRLine(kuiTokens))
+            SetOutcome(GameOutcome::OUTCOME_DIAGONAL_ULLR);
+        else if (ConnectFourBitboard::DiagonalURLLLine(kuiTokens))
+            SetOutcome(GameOutcome::OUTCOME_DIAGONAL_URLL);
+
+        if (m_ecOutcome != GameOutcome::OUTCOME_NOTHING)
+        {
+            GameMove cLastMove = LastMove();
+            m_nWinner = cBoard.PositionOccupiedByPlayer(cLastMove.ToX(), cLastMove.ToY(), m_knPlayer1) ? m_knPlayer1 : m_knPlayer2;
+            m_bGameOver = true;
+            return true;
+        }
+    }
+
+    // Evaluate whether the player has any valid moves to make
+    GenerateBoardMoves(nPlayer, cMoveList);
+    if (cMoveList.Empty())
     {
-        if (!cBoard.PositionOccupied(x, yyy))
-            return yyy;
+        m_bGameOver = true;
+        return true;
     }
 
-    return -1;
+    return false;
+}
+
+/**
+  * Generate a perfect move.
+  *
+  * Solve the game from the current position, making the solver when first
+  * needed.  The solver keeps what it learns from one move to the next.
+  *
+  * \param nPlayer The player whose turn it is.
+  *
+  * \return The best move for the player.
+  */
+
+GameMove ConnectFour::SolvedMove(int nPlayer)
+{
+    assert(((m_cBitboard.Moves() % 2 == 0) == (nPlayer == m_knPlayer1)) && "ConnectFour::SolvedMove() player is not the player to move");
+
+    if (m_pcSolver == nullptr)
+        m_pcSolver = std::make_shared<ConnectFourSolver>();
+
+    int nScore {0};
+    int nColumn = m_pcSolver->BestColumn(m_cBitboard, nScore);
+
+    // Log the solution
+    if (m_cLogger.Level() >= 2)
+    {
+        std::string sMessage = "SolvedMove Player=" + std::to_string(nPlayer) + " Column=" + std::to_string(nColumn) +
+                               " Score=" + std::to_string(nScore) + " Nodes=" + std::to_string(m_pcSolver->Nodes());
+        m_cLogger.LogInfo(sMessage, 2);
+    }
+
+    GameMove cGameMove = BoardMove(0, 0, nColumn, 0, false, false).ToGameMove();
+
+    return cGameMove;
+}
+
+/**
+  * Write an opening book.
+  *
+  * Solve every position up to a number of plies and write the scores to a
+  * book file, to be read with ReadOpeningBook().
+  *
+  * \param sFileName Name of the book file
+  * \param nPlies    The number of plies to cover
+  *
+  * \return True if successful, false otherwise.
+  */
+
+bool ConnectFour::WriteOpeningBook(const std::string &sFileName, int nPlies)
+{
+    if ((nPlies < 0) || (nPlies >= m_knX * m_knY))
+        return false;
+
+    std::shared_ptr<ConnectFourOpeningBook> pcOpeningBook = std::make_shared<ConnectFourOpeningBook>();
+    ConnectFourSolver cSolver;
+    cSolver.SetOpeningBook(pcOpeningBook);
+
+    pcOpeningBook->Generate(nPlies, cSolver, m_cLogger);
+
+    return pcOpeningBook->Write(sFileName);
+}
+
+/**
+  * Read an opening book.
+  *
+  * Open a book file written by WriteOpeningBook() for the solver to use.
+  *
+  * \param sFileName Name of the book file
+  *
+  * \return True if the book is opened.  False otherwise.
+  */
+
+bool ConnectFour::ReadOpeningBook(const std::string &sFileName)
+{
+    std::shared_ptr<ConnectFourOpeningBook> pcOpeningBook = std::make_shared<ConnectFourOpeningBook>();
+    if (!pcOpeningBook->Open(sFileName))
+        return false;
+
+    if (m_pcSolver == nullptr)
+        m_pcSolver = std::make_shared<ConnectFourSolver>();
+
+    m_pcSolver->SetOpeningBook(pcOpeningBook);
+
+    return true;
 }
 
 /**
@@ -0,0 +1,248 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ConnectFourOpeningBook.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ConnectFourSolver.h"
+
+const char ConnectFourOpeningBook::m_kacMagic[8] {'G', 'A', 'I', 'C', '4', 'B', 'K', '1'};
+
+/**
+  * Open a book file.
+  *
+  * Map the file into memory, or read it where mapping is not available,
+  * after checking its header.
+  *
+  * \param sFileName Name of the book file
+  *
+  * \return True if the book is opened.  False otherwise.
+  */
+
+bool ConnectFourOpeningBook::Open(const std::string &sFileName)
+{
+    Close();
+
+    Header stHeader;
+
+#if defined(_WIN32)
+    std::ifstream ifsFile(sFileName, std::ios::in | std::ios::binary);
+    if (!ifsFile.read(reinterpret_cast<char *>(&stHeader), sizeof(stHeader)))
+        return false;
+
+    if (std::memcmp(stHeader.acMagic, m_kacMagic, sizeof(m_kacMagic)) != 0)
+        return false;
+
+    m_vuiEntries.resize(stHeader.uiEntries);
+    if (!ifsFile.read(reinterpret_cast<char *>(m_vuiEntries.data()), m_vuiEntries.size() * sizeof(uint64_t)))
+    {
+        m_vuiEntries.clear();
+        return false;
+    }
+
+    m_puiEntries = m_vuiEntries.data();
+#else
+    int nFile = open(sFileName.c_str(), O_RDONLY);
+    if (nFile < 0)
+        return false;
+
+    struct stat stStat;
+    if ((fstat(nFile, &stStat) != 0) || (static_cast<size_t>(stStat.st_size) < sizeof(stHeader)))
+    {
+        close(nFile);
+        return false;
+    }
+
+    size_t nSize = stStat.st_size;
+    void *pvMapping = mmap(nullptr, nSize, PROT_READ, MAP_SHARED, nFile, 0);
+    close(nFile);
+
+    if (pvMapping == MAP_FAILED)
+        return false;
+
+    std::memcpy(&stHeader, pvMapping, sizeof(stHeader));
+    if ((std::memcmp(stHeader.acMagic, m_kacMagic, sizeof(m_kacMagic)) != 0) ||
+        (nSize != sizeof(stHeader) + stHeader.uiEntries * sizeof(uint64_t)))
+    {
+        munmap(pvMapping, nSize);
+        return false;
+    }
+
+    m_pvMapping    = pvMapping;
+    m_nMappingSize = nSize;
+    m_puiEntries   = reinterpret_cast<const uint64_t *>(static_cast<const char *>(pvMapping) + sizeof(stHeader));
+#endif
+
+    m_nEntries = stHeader.uiEntries;
+    m_nPlies   = stHeader.uiPlies;
+
+    return true;
+}
+
+/**
+  * Release the book.
+  */
+
+void ConnectFourOpeningBook::Close()
+{
+#if !defined(_WIN32)
+    if (m_pvMapping != nullptr)
+        munmap(m_pvMapping, m_nMappingSize);
+#endif
+
+    m_pvMapping    = nullptr;
+    m_nMappingSize = 0;
+    m_vuiEntries.clear();
+    m_puiEntries   = nullptr;
+    m_nEntries     = 0;
+    m_nPlies       = -1;
+}
+
+/**
+  * Generate the book.
+  *
+  * Collect every position up to nPlies, one for each position and its
+  * mirror image, leaving out positions already won.  Then solve the
+  * positions from the last ply to the first, adding each ply to the book
+  * once it is solved.  As the solver uses this book, every position but
+  * those of the last ply is solved by looking up the positions after it.
+  *
+  * \param nPlies  The number of plies to cover
+  * \param cSolver A solver using this book
+  * \param cLogger Logger for progress
+  */
+
+void ConnectFourOpeningBook::Generate(int nPlies, ConnectFourSolver &cSolver, const Logger &cLogger)
+{
+    Close();
+
+    m_nPlies = nPlies;
+
+    // Collect the positions at each ply
+    std::vector<std::vector<ConnectFourBitboard>> vvcPositions(nPlies + 1);
+    vvcPositions[0].emplace_back();
+
+    for (int nPly = 1; nPly <= nPlies; ++nPly)
+    {
+        std::unordered_set<uint64_t> setKeys;
+
+        for (const ConnectFourBitboard &cPosition : vvcPositions[nPly - 1])
+        {
+            for (int nColumn = 0; nColumn < ConnectFourBitboard::m_knWidth; ++nColumn)
+            {
+                if (!cPosition.CanPlay(nColumn) || cPosition.IsWinningMove(nColumn))
+                    continue;
+
+                ConnectFourBitboard cNextPosition(cPosition);
+                cNextPosition.Play(nColumn);
+
+                if (setKeys.insert(cNextPosition.CanonicalKey()).second)
+                    vvcPositions[nPly].push_back(cNextPosition);
+            }
+        }
+    }
+
+    // Solve the positions, last ply first
+    for (int nPly = nPlies; nPly >= 0; --nPly)
+    {
+        std::vector<uint64_t> vuiEntries;
+        vuiEntries.reserve(vvcPositions[nPly].size());
+
+        for (const ConnectFourBitboard &cPosition : vvcPositions[nPly])
+        {
+            int nScore = cSolver.Solve(cPosition);
+            vuiEntries.push_back((cPosition.CanonicalKey() << 8) | static_cast<uint8_t>(nScore));
+        }
+
+        m_vuiEntries.insert(m_vuiEntries.end(), vuiEntries.begin(), vuiEntries.end());
+        std::sort(m_vuiEntries.begin(), m_vuiEntries.end());
+        m_puiEntries = m_vuiEntries.data();
+        m_nEntries   = m_vuiEntries.size();
+
+        std::string sMessage = "Opening book ply " + std::to_string(nPly) + " positions " + std::to_string(vuiEntries.size()) +
+                               " solver nodes " + std::to_string(cSolver.Nodes());
+        cLogger.LogInfo(sMessage, 1);
+
+        vvcPositions[nPly].clear();
+        vvcPositions[nPly].shrink_to_fit();
+    }
+}
+
+/**
+  * Write the book to a file.
+  *
+  * \param sFileName Name of the book file
+  *
+  * \return True if successful, false otherwise.
+  */
+
+bool ConnectFourOpeningBook::Write(const std::string &sFileName) const
+{
+    std::ofstream ofsFile(sFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofsFile.is_open())
+        return false;
+
+    Header stHeader;
+    std::memcpy(stHeader.acMagic, m_kacMagic, sizeof(m_kacMagic));
+    stHeader.uiPlies    = m_nPlies;
+    stHeader.uiReserved = 0;
+    stHeader.uiEntries  = m_nEntries;
+
+    ofsFile.write(reinterpret_cast<const char *>(&stHeader), sizeof(stHeader));
+    ofsFile.write(reinterpret_cast<const char *>(m_puiEntries), m_nEntries * sizeof(uint64_t));
+
+    return ofsFile.good();
+}
+
+/**
+  * Look up the score of a position.
+  *
+  * \param cPosition The position
+  * \param nScore    The score of the position for the player to move, if found
+  *
+  * \return True if the position is in the book.  False otherwise.
+  */
+
+bool ConnectFourOpeningBook::Lookup(const ConnectFourBitboard &cPosition, int &nScore) const
+{
+    if (cPosition.Moves() > m_nPlies)
+        return false;
+
+    const uint64_t kuiKey = cPosition.CanonicalKey();
+    const uint64_t *puiEnd = m_puiEntries + m_nEntries;
+    const uint64_t *puiEntry = std::lower_bound(m_puiEntries, puiEnd, kuiKey << 8);
+
+    if ((puiEntry == puiEnd) || ((*puiEntry >> 8) != kuiKey))
+        return false;
+
+    nScore = static_cast<int8_t>(*puiEntry & 0xFF);
+
+    return true;
+}
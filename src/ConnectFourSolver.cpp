@@ -0,0 +1,257 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ConnectFourSolver.h"
+
+#include <algorithm>
+#include <climits>
+
+const int ConnectFourSolver::m_kanColumnOrder[ConnectFourBitboard::m_knWidth] {3, 2, 4, 1, 5, 0, 6};
+
+/**
+  * Solve a position.
+  *
+  * \param cPosition The position
+  *
+  * \return The score of the position for the player to move.
+  */
+
+int ConnectFourSolver::Solve(const ConnectFourBitboard &cPosition)
+{
+    return Solve(cPosition, INT_MIN, INT_MAX);
+}
+
+/**
+  * Solve a position within a range of scores.
+  *
+  * Find the score with a series of null-window searches, each of which
+  * tells whether the score is above or below a guess, halving the range of
+  * possible scores until one is left.  Guesses are drawn toward zero, as
+  * scores near a draw are the cheapest to test.
+  *
+  * \param cPosition The position
+  * \param nLowest   The lowest score of interest
+  * \param nHighest  The highest score of interest
+  *
+  * \return The score of the position for the player to move, or nLowest if
+  * the score is no higher, or nHighest if it is no lower.
+  */
+
+int ConnectFourSolver::Solve(const ConnectFourBitboard &cPosition, int nLowest, int nHighest)
+{
+    const int knSquares = ConnectFourBitboard::m_knWidth * ConnectFourBitboard::m_knHeight;
+
+    if (cPosition.CanWinNext())
+        return std::min((knSquares + 1 - cPosition.Moves()) / 2, nHighest);
+
+    int nScore {0};
+    if (BookScore(cPosition, nScore))
+        return std::max(std::min(nScore, nHighest), nLowest);
+
+    int nMin = std::max(-(knSquares - cPosition.Moves()) / 2, nLowest);
+    int nMax = std::min((knSquares + 1 - cPosition.Moves()) / 2, nHighest);
+
+    while (nMin < nMax)
+    {
+        int nMedian = nMin + (nMax - nMin) / 2;
+        if ((nMedian <= 0) && (nMin / 2 < nMedian))
+            nMedian = nMin / 2;
+        else if ((nMedian >= 0) && (nMax / 2 > nMedian))
+            nMedian = nMax / 2;
+
+        // Is the score above or below the median?
+        nScore = Negamax(cPosition, nMedian, nMedian + 1);
+        if (nScore <= nMedian)
+            nMax = nScore;
+        else
+            nMin = nScore;
+    }
+
+    return std::max(nMin, nLowest);
+}
+
+/**
+  * Find the best move in a position.
+  *
+  * Take a win at once, if there is one.  Otherwise solve the position after
+  * each move, centre first, and keep the first of the moves with the best
+  * score.  After the first move, a move is only solved as far as showing
+  * that it does no better than the best so far.
+  *
+  * \param cPosition The position, in which the player to move has a move
+  * \param nScore    The score of the best move, for the player to move
+  *
+  * \return The column of the best move.
+  */
+
+int ConnectFourSolver::BestColumn(const ConnectFourBitboard &cPosition, int &nScore)
+{
+    const int knSquares = ConnectFourBitboard::m_knWidth * ConnectFourBitboard::m_knHeight;
+
+    int nBestColumn = -1;
+    nScore = INT_MIN;
+
+    for (int nColumn : m_kanColumnOrder)
+    {
+        if (cPosition.CanPlay(nColumn) && cPosition.IsWinningMove(nColumn))
+        {
+            nScore = (knSquares + 1 - cPosition.Moves()) / 2;
+            return nColumn;
+        }
+    }
+
+    for (int nColumn : m_kanColumnOrder)
+    {
+        if (!cPosition.CanPlay(nColumn))
+            continue;
+
+        ConnectFourBitboard cNextPosition(cPosition);
+        cNextPosition.Play(nColumn);
+
+        // The opponent's score, if below the negative of the best score so far
+        int nOpponentScore = (nBestColumn < 0) ? Solve(cNextPosition) : Solve(cNextPosition, INT_MIN, -nScore);
+        if ((nBestColumn < 0) || (-nOpponentScore > nScore))
+        {
+            nScore = -nOpponentScore;
+            nBestColumn = nColumn;
+        }
+    }
+
+    return nBestColumn;
+}
+
+/**
+  * Search a position within a window of scores.
+  *
+  * The player to move cannot win at once.  Moves that hand the opponent a
+  * win are never tried, and the bounds on the score are narrowed by the
+  * number of tokens left, and by any bound stored for the position, before
+  * searching.  A score at or below nAlpha is an upper bound on the true
+  * score, and one at or above nBeta a lower bound; either is stored in the
+  * transposition table.
+  *
+  * \param cPosition The position
+  * \param nAlpha    The score the player to move is assured of
+  * \param nBeta     The score the opponent is assured of holding them to
+  *
+  * \return The score of the position, or a bound on it outside the window.
+  */
+
+int ConnectFourSolver::Negamax(const ConnectFourBitboard &cPosition, int nAlpha, int nBeta)
+{
+    const int knSquares = ConnectFourBitboard::m_knWidth * ConnectFourBitboard::m_knHeight;
+
+    ++m_uiNodes;
+
+    // Solved in the opening book
+    int nBookScore {0};
+    if (BookScore(cPosition, nBookScore))
+        return nBookScore;
+
+    // Every move loses at once
+    uint64_t uiNonLosing = cPosition.PossibleNonLosingMoves();
+    if (uiNonLosing == 0)
+        return -(knSquares - cPosition.Moves()) / 2;
+
+    // Too few squares are left for either player to win
+    if (cPosition.Moves() >= knSquares - 2)
+        return 0;
+
+    // The opponent cannot win on their next token
+    int nMin = -(knSquares - 2 - cPosition.Moves()) / 2;
+    if (nAlpha < nMin)
+    {
+        nAlpha = nMin;
+        if (nAlpha >= nBeta)
+            return nAlpha;
+    }
+
+    // The player to move cannot win on this token
+    int nMax = (knSquares - 1 - cPosition.Moves()) / 2;
+    if (nBeta > nMax)
+    {
+        nBeta = nMax;
+        if (nAlpha >= nBeta)
+            return nBeta;
+    }
+
+    // Bound stored from an earlier search
+    int nStored = Probe(cPosition.CanonicalKey());
+    if (nStored > m_knMaxScore - m_knMinScore + 1)
+    {
+        nMin = nStored + 2 * m_knMinScore - m_knMaxScore - 2;
+        if (nAlpha < nMin)
+        {
+            nAlpha = nMin;
+            if (nAlpha >= nBeta)
+                return nAlpha;
+        }
+    }
+    else if (nStored != 0)
+    {
+        nMax = nStored + m_knMinScore - 1;
+        if (nBeta > nMax)
+        {
+            nBeta = nMax;
+            if (nAlpha >= nBeta)
+                return nBeta;
+        }
+    }
+
+    // Order the moves by the number of lines they threaten, centre first among equals
+    uint64_t auiMoves[ConnectFourBitboard::m_knWidth];
+    int      anScores[ConnectFourBitboard::m_knWidth];
+    int      nMoves {0};
+
+    for (int nColumn : m_kanColumnOrder)
+    {
+        uint64_t uiMove = uiNonLosing & ConnectFourBitboard::ColumnMask(nColumn);
+        if (uiMove == 0)
+            continue;
+
+        int nScore = cPosition.MoveScore(uiMove);
+        int nIndex = nMoves++;
+        for (; (nIndex > 0) && (anScores[nIndex - 1] < nScore); --nIndex)
+        {
+            auiMoves[nIndex] = auiMoves[nIndex - 1];
+            anScores[nIndex] = anScores[nIndex - 1];
+        }
+        auiMoves[nIndex] = uiMove;
+        anScores[nIndex] = nScore;
+    }
+
+    for (int iii = 0; iii < nMoves; ++iii)
+    {
+        ConnectFourBitboard cNextPosition(cPosition);
+        cNextPosition.PlaySquare(auiMoves[iii]);
+
+        int nScore = -Negamax(cNextPosition, -nBeta, -nAlpha);
+        if (nScore >= nBeta)
+        {
+            Store(cPosition.CanonicalKey(), nScore + m_knMaxScore - 2 * m_knMinScore + 2);
+            return nScore;
+        }
+        if (nScore > nAlpha)
+            nAlpha = nScore;
+    }
+
+    Store(cPosition.CanonicalKey(), nAlpha - m_knMinScore + 1);
+
+    return nAlpha;
+}
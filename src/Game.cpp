@@ -21,6 +21,8 @@
 #include "ConnectFour.h"
 #include "TTT.h"
 #include "Reversi.h"
+#include "Gomoku.h"
+#include "Gomoku19.h"
 #include "ChessGardner.h"
 #include "ChessBaby.h"
 #include "ChessJacobsMeirovitz.h"
@@ -55,6 +57,10 @@ std::unique_ptr<Game> Game::Make(GameType ecGameType)
             return std::unique_ptr<Game>(new TTT(ecGameType));
         case GameType::TYPE_REVERSI:
             return std::unique_ptr<Game>(new Reversi(ecGameType));
+        case GameType::TYPE_GOMOKU:
+            return std::unique_ptr<Game>(new Gomoku(ecGameType));
+        case GameType::TYPE_GOMOKU_19:
+            return std::unique_ptr<Game>(new Gomoku19(ecGameType));
         case GameType::TYPE_CHESS_GARDNER:
             return std::unique_ptr<Game>(new ChessGardner(ecGameType));
         case GameType::TYPE_CHESS_BABY:
@@ -235,7 +241,7 @@ bool Game::WriteMoves(const std::string &sFileName, std::fstream &fsFile)
     std::string sMessage = "Writing moves to file " + sFileName;
     m_cLogger.LogInfo(sMessage,2);
 
-    for (GameMove cGameMove : m_vGameMoves)
+    for (GameMove cGameMove : m_cGameMoves)
     {
         fsFile << cGameMove.AnnounceFromMove() << cGameMove.AnnounceToMove() << std::endl;
     }
@@ -270,3 +276,48 @@ bool Game::WriteMovesToFile(const std::string &sFileName)
 
     return true;
 }
+
+/**
+  * Return how the game was won.
+  *
+  * Build the text from the outcome recorded by SetOutcome().  Games check
+  * for an outcome at every node of a search, so the text is only built
+  * here, when it is displayed.
+  *
+  * \return A string describing how the game was won.
+  */
+
+std::string Game::WinBy() const
+{
+    switch (m_ecOutcome)
+    {
+        case GameOutcome::OUTCOME_NOTHING:
+            return "nothing";
+        case GameOutcome::OUTCOME_RESIGNATION:
+            return "resignation";
+        case GameOutcome::OUTCOME_THREEFOLD_REPETITION:
+            return "drawn by threefold repetition";
+        case GameOutcome::OUTCOME_CHECKMATE:
+            return "checkmate";
+        case GameOutcome::OUTCOME_STALEMATE:
+            return "stalemate";
+        case GameOutcome::OUTCOME_HORIZONTAL:
+            return "Horizontal";
+        case GameOutcome::OUTCOME_VERTICAL:
+            return "Vertical";
+        case GameOutcome::OUTCOME_DIAGONAL_ULLR:
+            return "DiagonalULLR";
+        case GameOutcome::OUTCOME_DIAGONAL_URLL:
+            return "DiagonalURLL";
+        case GameOutcome::OUTCOME_DIFFERENCE:
+            return "a difference of " + std::to_string(m_nOutcomeDetail);
+        case GameOutcome::OUTCOME_ATTRITION:
+            return "attrition";
+        case GameOutcome::OUTCOME_BOOKS:
+            return "having " + std::to_string(m_nOutcomeDetail) + " books";
+        case GameOutcome::OUTCOME_POINTS:
+            return "having " + std::to_string(m_nOutcomeDetail) + " points.";
+    }
+
+    return "";
+}
@@ -19,40 +19,40 @@
 
 #include "GameBoard.h"
 
-void GameBoard::InitializeZobrist()
-{
-    //
-    // Initialize Zobrist hash table
-    //
+#include <type_traits>
 
-    // Random number generator
-#if defined(_WIN32)
-    static unsigned seed  = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    ++seed;
-    std::mt19937_64 RandomNumberGenerator{seed};
-#else
-    std::random_device RandomDevice{};
-    std::mt19937_64 RandomNumberGenerator{RandomDevice()};
-#endif // defined
+// A board is copied with every game clone, so keep it a single block of memory
+static_assert(std::is_trivially_copyable<GameBoard>::value, "GameBoard must be trivially copyable");
 
-    // Fill Zobrist hash table with random numbers
-    // one for every piece on every square
-    for (int iii = 0; iii < m_knNumberOfTypesOfPieces; ++iii)
-    {
-        for (int jjj = 0; jjj < m_knNumberOfSquares; ++jjj)
-        {
-            m_auiZobrist[iii][jjj] = RandomNumberGenerator();
-        }
-    }
+#if !defined(_WIN32)
+const char * const GameBoard::m_kszPlayer1TokenColor {"\033[1;37m"};
+const char * const GameBoard::m_kszPlayer2TokenColor {"\033[1;31m"};
+const char * const GameBoard::m_kszResetTokenColor   {"\033[0m"};
+#endif
+
+// Passed by reference to std::fill, so it needs a definition
+const int8_t GameBoard::m_knNotListed;
+
+/**
+  * Initialize the Zobrist hash key.
+  *
+  * Start the key afresh from the pieces on the board.  The keys for each
+  * piece on each square come from the process-wide Zobrist table.  The pawn
+  * key is reset, to be rebuilt by the game.
+  */
 
-    // Initialize the Zobrist key
+void GameBoard::InitializeZobrist()
+{
+    m_uiZobristKey     = 0;
+    m_uiPawnZobristKey = 0;
+
+    // Hash every piece on the board
     for (int yyy = 0; yyy < m_knY; ++yyy)
     {
         for (int xxx = 0; xxx < m_knX; ++xxx)
         {
             if (PositionOccupied(xxx, yyy))
             {
-                //m_uiZobristKey ^= m_auiZobrist[PieceNumber(xxx, yyy)][(xxx + (yyy * m_knMaxY))];
                 UpdateZobristKey(xxx, yyy, xxx, yyy);
             }
         }
@@ -62,7 +62,7 @@ void GameBoard::InitializeZobrist()
 /**
   * Update the Zobrist hash key.
   *
-  * Using the passed coordinates, find the random number for the piece
+  * Using the passed coordinates, find the Zobrist key for the piece
   * on the designated square and XOR it against the current key.
   *
   * \param nPX X-coordinate of the piece
@@ -74,7 +74,24 @@ void GameBoard::InitializeZobrist()
 
 void GameBoard::UpdateZobristKey(int nPX, int nPY, int nSX, int nSY)
 {
-    m_uiZobristKey ^= m_auiZobrist[PieceNumber(nPX, nPY)][nSX + (nSY * m_knMaxY)];
+    m_uiZobristKey ^= Zobrist::Piece(PieceNumber(nPX, nPY), Square(nSX, nSY));
+}
+
+/**
+  * Update the pawn Zobrist hash key.
+  *
+  * As UpdateZobristKey(), but against the key kept for pawns alone.  The
+  * caller decides which pieces are pawns.
+  *
+  * \param nPX X-coordinate of the piece
+  * \param nPY Y-coordinate of the piece
+  * \param nSX X-coordinate of the square
+  * \param nSY Y-coordinate of the square
+  */
+
+void GameBoard::UpdatePawnZobristKey(int nPX, int nPY, int nSX, int nSY)
+{
+    m_uiPawnZobristKey ^= Zobrist::Piece(PieceNumber(nPX, nPY), Square(nSX, nSY));
 }
 
 /**
@@ -85,15 +102,72 @@ void GameBoard::UpdateZobristKey(int nPX, int nPY, int nSX, int nSY)
 
 void GameBoard::Clear()
 {
-    for (int xxx = 0; xxx < m_knX; ++xxx)
-        for (int yyy = 0; yyy < m_knY; ++yyy)
-            m_vBoard[yyy][xxx].Clear();
+    for (GamePiece &cGamePiece : m_acBoard)
+        cGamePiece.Clear();
+
+    m_anPieceCount[0] = 0;
+    m_anPieceCount[1] = 0;
+    std::fill(std::begin(m_anPieceListIndex), std::end(m_anPieceListIndex), m_knNotListed);
+}
+
+/**
+  * Add a square to a piece list.
+  *
+  * Append the square to the list of the player whose piece occupies it.
+  * Squares without a player's piece are not listed.
+  *
+  * \param nX X-Coordinate
+  * \param nY Y-Coordinate
+  */
+
+void GameBoard::AddToPieceList(int nX, int nY)
+{
+    const int knPlayer = m_acBoard[Square(nX, nY)].Player();
+
+    if ((knPlayer != 1) && (knPlayer != 2))
+        return;
+
+    const int knSquare = Square(nX, nY);
+    int &nCount = m_anPieceCount[knPlayer - 1];
+
+    m_aanPieceList[knPlayer - 1][nCount] = knSquare;
+    m_anPieceListIndex[knSquare] = nCount;
+    ++nCount;
+}
+
+/**
+  * Remove a square from a piece list.
+  *
+  * Remove the square from the list of the player whose piece occupies it by
+  * moving the last square in that list into its place.  Must be called
+  * before the piece is cleared from the square.
+  *
+  * \param nX X-Coordinate
+  * \param nY Y-Coordinate
+  */
+
+void GameBoard::RemoveFromPieceList(int nX, int nY)
+{
+    const int knSquare = Square(nX, nY);
+    const int knIndex  = m_anPieceListIndex[knSquare];
+
+    if (knIndex == m_knNotListed)
+        return;
+
+    const int knPlayer = m_acBoard[Square(nX, nY)].Player();
+    const int knLast   = --m_anPieceCount[knPlayer - 1];
+    const int knLastSquare = m_aanPieceList[knPlayer - 1][knLast];
+
+    m_aanPieceList[knPlayer - 1][knIndex] = knLastSquare;
+    m_anPieceListIndex[knLastSquare] = knIndex;
+    m_anPieceListIndex[knSquare] = m_knNotListed;
 }
 
 /**
   * Set a piece on the board.
   *
-  * If a valid location, set the token and the player.
+  * If a valid location, set the token and the player, and keep the piece
+  * lists current.
   *
   * \param nX X-Coordinate
   * \param nY Y-Coordinate
@@ -107,7 +181,9 @@ bool GameBoard::SetPiece(int nX, int nY, const GamePiece &cGamePiece)
     if (!ValidLocation(nX, nY))
         return false;
 
-    m_vBoard[nY][nX].Set(cGamePiece.Token(), cGamePiece.Player(), cGamePiece.Value(), cGamePiece.Number());
+    RemoveFromPieceList(nX, nY);
+    m_acBoard[Square(nX, nY)].Assign(cGamePiece);
+    AddToPieceList(nX, nY);
 
     return true;
 }
@@ -117,19 +193,20 @@ bool GameBoard::SetPiece(int nX, int nY, const GamePiece &cGamePiece)
   *
   * Copy piece From location and paste it to the To location.
   *
-  * \param GameMove The game move
+  * \param BoardMove The game move
   *
   * \return True if valid move, false otherwise.
   */
 
-bool GameBoard::MovePiece(const GameMove &cGameMove)
+bool GameBoard::MovePiece(const BoardMove &cBoardMove)
 {
-    GamePiece cGamePiece = m_vBoard[cGameMove.FromY()][cGameMove.FromX()].Piece();
+    GamePiece cGamePiece = m_acBoard[Square(cBoardMove.FromX(), cBoardMove.FromY())].Piece();
 
-    if (SetPiece(cGameMove.ToX(), cGameMove.ToY(), cGamePiece))
+    if (SetPiece(cBoardMove.ToX(), cBoardMove.ToY(), cGamePiece))
     {
-        m_vBoard[cGameMove.ToY()][cGameMove.ToX()].SetMoved();
-        m_vBoard[cGameMove.FromY()][cGameMove.FromX()].Clear();
+        m_acBoard[Square(cBoardMove.ToX(), cBoardMove.ToY())].SetMoved();
+        RemoveFromPieceList(cBoardMove.FromX(), cBoardMove.FromY());
+        m_acBoard[Square(cBoardMove.FromX(), cBoardMove.FromY())].Clear();
         return true;
     }
     else
@@ -173,7 +250,7 @@ bool GameBoard::ValidLocation(int x, int y) const
 
 bool GameBoard::PositionOccupied(int nX, int nY) const
 {
-    if (m_vBoard[nY][nX].IsAGamePiece())
+    if (m_acBoard[Square(nX, nY)].IsAGamePiece())
         return true;
     else
         return false;
@@ -191,7 +268,7 @@ bool GameBoard::PositionOccupied(int nX, int nY) const
 
 int GameBoard::PositionOccupiedBy(int nX, int nY) const
 {
-    return m_vBoard[nY][nX].Player();
+    return m_acBoard[Square(nX, nY)].Player();
 }
 
 /**
@@ -208,7 +285,7 @@ int GameBoard::PositionOccupiedBy(int nX, int nY) const
 
 bool GameBoard::PositionOccupiedByPlayer(int nX, int nY, int nPlayer) const
 {
-    if (m_vBoard[nY][nX].Player() == nPlayer)
+    if (m_acBoard[Square(nX, nY)].Player() == nPlayer)
         return true;
     else
         return false;
@@ -272,22 +349,26 @@ void GameBoard::Display() const
                 std::cout << " | ";
             }
 
-            // Determine color of token
-            if (m_vBoard[nDisplayY][xxx].Player() == 1)
+            // Determine color of token, swapping the players' colors if reversed
+            int nColorPlayer = m_acBoard[Square(xxx, nDisplayY)].Player();
+            if (m_bReverseColors && ((nColorPlayer == 1) || (nColorPlayer == 2)))
+                nColorPlayer = 3 - nColorPlayer;
+
+            if (nColorPlayer == 1)
             {
 #if defined(_WIN32)
-                SetConsoleTextAttribute(hConsole, m_nPlayer1TokenColor);
+                SetConsoleTextAttribute(hConsole, m_knPlayer1TokenColor);
 #else
-                sColor = m_sPlayer1TokenColor;
+                sColor = m_kszPlayer1TokenColor;
 #endif // defined
 
             }
-            else if (m_vBoard[nDisplayY][xxx].Player() == 2)
+            else if (nColorPlayer == 2)
             {
 #if defined(_WIN32)
-                SetConsoleTextAttribute(hConsole, m_nPlayer2TokenColor);
+                SetConsoleTextAttribute(hConsole, m_knPlayer2TokenColor);
 #else
-                sColor = m_sPlayer2TokenColor;
+                sColor = m_kszPlayer2TokenColor;
 #endif // defined
             }
             else // Clear color
@@ -296,10 +377,10 @@ void GameBoard::Display() const
             }
 
 #if defined(_WIN32)
-            std::cout << m_vBoard[nDisplayY][xxx].Token();
+            std::cout << m_acBoard[Square(xxx, nDisplayY)].Token();
             SetConsoleTextAttribute(hConsole, m_knResetTokenColor);
 #else
-            std::cout << sColor << m_vBoard[nDisplayY][xxx].Token() << m_ksResetTokenColor;
+            std::cout << sColor << m_acBoard[Square(xxx, nDisplayY)].Token() << m_kszResetTokenColor;
 #endif // defined
 
             if (!m_kbDisplayGrid)
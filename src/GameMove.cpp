@@ -144,7 +144,7 @@ std::string GameMove::AnnounceFromMove() const
     if (m_bUseY)
     {
         sMove = m_cFromX;
-        sMove += m_cFromY;
+        sMove += AnnounceY(m_nFromY, m_cFromY);
     }
     else
     {
@@ -177,7 +177,13 @@ std::string GameMove::AnnounceToMove() const
     else if (m_bUseY)
     {
         sMove = m_cToX;
-        sMove += m_cToY;
+        sMove += AnnounceY(m_nToY, m_cToY);
+
+        if (m_cPromotion != '\0')
+        {
+            sMove += '=';
+            sMove += m_cPromotion;
+        }
     }
     else
     {
@@ -187,6 +193,26 @@ std::string GameMove::AnnounceToMove() const
     return sMove;
 }
 
+/**
+  * Announce a Y-coordinate.
+  *
+  * A Y-coordinate past the ninth row of a board is announced as its row
+  * number, of two digits, rather than as one character.
+  *
+  * \param nY The Y-coordinate
+  * \param cY The Y-coordinate as input
+  *
+  * \return A string containing the Y-coordinate.
+  */
+
+std::string GameMove::AnnounceY(int nY, char cY)
+{
+    if (nY >= 9)
+        return std::to_string(nY + 1);
+
+    return std::string(1, cY);
+}
+
 /**
   * Announce the card object.
   *
@@ -259,6 +285,8 @@ Json::Value GameMove::JsonSerialization() const
     jValue["cToX"]          = m_cToX;
     jValue["nToY"]          = m_nToY;
     jValue["cToY"]          = m_cToY;
+    jValue["nPromotion"]    = m_nPromotion;
+    jValue["cPromotion"]    = m_cPromotion;
 
     jValue["bUseY"]         = m_bUseY;
     jValue["bUseFrom"]      = m_bUseFrom;
@@ -311,6 +339,8 @@ bool GameMove::JsonDeserialization(const std::string &sJsonGameMove, std::string
         m_cToX          = jValue["cToX"].asInt();
         m_nToY          = jValue["nToY"].asInt();
         m_cToY          = jValue["cToY"].asInt();
+        m_nPromotion    = jValue["nPromotion"].asInt();
+        m_cPromotion    = jValue["cPromotion"].asInt();
 
         m_bUseY         = jValue["bUseY"].asBool();
         m_bUseFrom      = jValue["bUseFrom"].asBool();
@@ -0,0 +1,25 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GamePiece.h"
+
+// A piece is one byte, so that an 8x8 board fits in a cache line
+static_assert(sizeof(GamePiece) == 1, "GamePiece is not packed into one byte");
+
+constexpr GamePiece::PieceType GamePiece::m_kastTypes[GamePiece::m_knNumberOfTypes];
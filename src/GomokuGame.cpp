@@ -0,0 +1,113 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GomokuGame.h"
+
+#include <string>
+
+#include "GomokuThreatSearch.h"
+
+/**
+  * Fill a list with the valid game moves worth searching.
+  *
+  * On an empty board, the move is the centre.  Otherwise the moves are the
+  * empty squares next to a token, followed by those one square further
+  * out, so that the closest are searched first.  As with Tic-Tac-Toe, the
+  * moves are the same for both players.
+  *
+  * \param nPlayer   The player whose turn it is.
+  * \param cMoveList The list to fill with valid moves
+  */
+
+template <class Lines>
+void GomokuGame<Lines>::GenerateBoardMoves(int nPlayer, MoveList &cMoveList)
+{
+    (void)nPlayer;
+
+    static const StoneBoard::StoneBitboard kcBoard = StoneBoard::StoneBitboard::Board(Lines::m_knX, Lines::m_knY);
+
+    cMoveList.Clear();
+
+    const StoneBoard::StoneBitboard kcStones = this->cBoard.Stones(1) | this->cBoard.Stones(2);
+
+    if (kcStones.Empty())
+    {
+        cMoveList.Add(BoardMove(0, 0, Lines::m_knX / 2, Lines::m_knY / 2, true, false));
+        return;
+    }
+
+    const StoneBoard::StoneBitboard kcNext = kcStones.Neighbours(kcBoard);
+
+    AddMoves(kcNext.Without(kcStones), cMoveList);
+    AddMoves(kcNext.Neighbours(kcBoard).Without(kcNext), cMoveList);
+}
+
+/**
+  * Add a move for each square of a set.
+  *
+  * \param cSquares  The squares
+  * \param cMoveList The list to add the moves to
+  */
+
+template <class Lines>
+void GomokuGame<Lines>::AddMoves(StoneBoard::StoneBitboard cSquares, MoveList &cMoveList)
+{
+    for (int nSquare = cSquares.PopFirst(); nSquare >= 0; nSquare = cSquares.PopFirst())
+        cMoveList.Add(BoardMove(0, 0, StoneBoard::StoneBitboard::X(nSquare), StoneBoard::StoneBitboard::Y(nSquare), true, false));
+}
+
+/**
+  * Generate a move that wins by a sequence of fours.
+  *
+  * Search the fours the player can make, and those that follow each block,
+  * for a line of them that ends in a win.
+  *
+  * \param nPlayer   The player whose turn it is.
+  * \param cGameMove The first move of the win, if one is found
+  *
+  * \return True, if a win is found.  False otherwise.
+  */
+
+template <class Lines>
+bool GomokuGame<Lines>::ThreatMove(int nPlayer, GameMove &cGameMove)
+{
+    GomokuThreatSearch<Lines> cThreatSearch;
+    int nSquare {-1};
+
+    const bool kbWin = cThreatSearch.WinningMove(this->m_anSquarePlayers, nPlayer, nSquare);
+
+    // Log the search
+    if (this->m_cLogger.Level() >= 2)
+    {
+        std::string sMessage = "ThreatMove Player=" + std::to_string(nPlayer) + " Win=" + (kbWin ? "Yes" : "No") +
+                               " Nodes=" + std::to_string(cThreatSearch.Nodes());
+        this->m_cLogger.LogInfo(sMessage, 2);
+    }
+
+    if (!kbWin)
+        return false;
+
+    cGameMove = BoardMove(0, 0, nSquare % Lines::m_knX, nSquare / Lines::m_knX, true, false).ToGameMove();
+
+    return true;
+}
+
+// The board of each Gomoku game
+template class GomokuGame<LinearLines<15, 15, 5>>;    // Gomoku
+template class GomokuGame<LinearLines<19, 19, 5>>;    // Gomoku on a 19x19 board
@@ -19,6 +19,13 @@
 
 #include "LinearGame.h"
 
+#include <cassert>
+
+#include "StoneBoard.h"
+
+template <class Lines, class Board>
+constexpr int LinearGame<Lines, Board>::m_knTokensInARowWin;
+
 /**
   * Generate a GameMove from a string.
   *
@@ -29,9 +36,10 @@
   * \return A GameMove object.
   */
 
-GameMove LinearGame::GenerateMove(std::string sMove) const
+template <class Lines, class Board>
+GameMove LinearGame<Lines, Board>::GenerateMove(std::string sMove) const
 {
-    GameMove cGameMove = BoardGame::GenerateMove(sMove);
+    GameMove cGameMove = BoardGame<Board>::GenerateMove(sMove);
 
     if (cGameMove.Resignation())
         return cGameMove;
@@ -46,8 +54,14 @@ GameMove LinearGame::GenerateMove(std::string sMove) const
         // Remove the first character ...
         sMove.erase(0,1);
 
-        // ... and if more of the string exists, set the To Y coordinate
-        if (sMove.length() > 0)
+        // ... and if more of the string exists, set the To Y coordinate,
+        // read as a row number on a board of more than nine rows
+        if ((Lines::m_knY > 9) && (sMove.length() > 0) && (sMove.length() <= 2) &&
+            (sMove.find_first_not_of("0123456789") == std::string::npos))
+        {
+            cGameMove.SetToY(std::stoi(sMove) - 1);
+        }
+        else if (sMove.length() > 0)
         {
             try
             {
@@ -76,42 +90,58 @@ GameMove LinearGame::GenerateMove(std::string sMove) const
   *
   * After checking to for a move's validity, apply the move to the game.
   *
-  * \param nPlayer   The player whose turn it is.
-  * \param cGameMove The player's move
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The player's move
   *
   * \return True, if valid.  False otherwise.
   */
 
-bool LinearGame::ApplyMove(int nPlayer, GameMove &cGameMove)
+template <class Lines, class Board>
+bool LinearGame<Lines, Board>::ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove)
 {
-    // Check player number
-    if ((nPlayer != m_knPlayer1) && (nPlayer != m_knPlayer2))
-        return false;
-
-    // Check for resignation
-    if (cGameMove.Resignation())
-    {
-        // Capture move for later playback or analysis
-        m_vGameMoves.push_back(cGameMove);
-        return true;
-    }
-
-    if (!cBoard.ValidLocation(cGameMove.ToX(), cGameMove.ToY()))
+    if (!this->cBoard.ValidLocation(cBoardMove.ToX(), cBoardMove.ToY()))
         return false;
 
     // Check to see if a space is clear
-    if (cBoard.PositionOccupied(cGameMove.ToX(), cGameMove.ToY()))
+    if (this->cBoard.PositionOccupied(cBoardMove.ToX(), cBoardMove.ToY()))
         return false;
 
+    return LinearGame::ApplyTrustedBoardMove(nPlayer, cBoardMove);
+}
+
+/**
+  * Apply a move generated by the game, without validating it.
+  *
+  * Place the player's token on the move's location, and hash it.  A debug
+  * build asserts that the location is on the board and clear.
+  *
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The generated move
+  *
+  * \return True.
+  */
+
+template <class Lines, class Board>
+bool LinearGame<Lines, Board>::ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove)
+{
+    assert(this->cBoard.ValidLocation(cBoardMove.ToX(), cBoardMove.ToY()) && "LinearGame::ApplyTrustedBoardMove() location is off the board");
+    assert(!this->cBoard.PositionOccupied(cBoardMove.ToX(), cBoardMove.ToY()) && "LinearGame::ApplyTrustedBoardMove() location is occupied");
+
     // Apply move to the board
     GamePiece cGamePiece(m_acTokens[nPlayer], nPlayer);
-    cBoard.SetPiece(cGameMove.ToX(), cGameMove.ToY(), cGamePiece);
+    this->cBoard.SetPiece(cBoardMove.ToX(), cBoardMove.ToY(), cGamePiece);
+
+    m_cSymmetricZobrist.Toggle(nPlayer, cBoardMove.ToX(), cBoardMove.ToY());
+
+    // Games won by tokens in a row evaluate the lines of tokens
+    if (m_knTokensInARowWin > 0)
+        CountPlacedToken(nPlayer, cBoardMove.ToX(), cBoardMove.ToY());
 
     // Increment move counter
-    ++m_nNumberOfMoves;
+    ++this->m_nNumberOfMoves;
 
     // Capture move for later playback or analysis
-    m_vGameMoves.push_back(cGameMove);
+    this->m_cGameMoves.Push(cBoardMove.ToGameMove());
 
     return true;
 }
@@ -127,9 +157,10 @@ bool LinearGame::ApplyMove(int nPlayer, GameMove &cGameMove)
   * \return A string containing the move.
   */
 
-std::string LinearGame::AnnounceMove(int nPlayer, const GameMove &cGameMove) const
+template <class Lines, class Board>
+std::string LinearGame<Lines, Board>::AnnounceMove(int nPlayer, const GameMove &cGameMove) const
 {
-    std::string sMessage = "\rMove number: " + std::to_string(m_nNumberOfMoves + 1) + "  Player: " + std::to_string(nPlayer) + "  Moves To: " + cGameMove.AnnounceToMove();
+    std::string sMessage = "\rMove number: " + std::to_string(this->m_nNumberOfMoves + 1) + "  Player: " + std::to_string(nPlayer) + "  Moves To: " + cGameMove.AnnounceToMove();
 
     return sMessage;
 }
@@ -147,295 +178,167 @@ std::string LinearGame::AnnounceMove(int nPlayer, const GameMove &cGameMove) con
   * \return An integer representing game state for the player.
   */
 
-int LinearGame::EvaluateGameState(int nPlayer)
+template <class Lines, class Board>
+int LinearGame<Lines, Board>::EvaluateGameState(int nPlayer)
 {
     // If won, return largest positive integer
-    if (m_nWinner == nPlayer)
+    if (this->m_nWinner == nPlayer)
         return INT_MAX;
 
     // If lost, return largest negative integer
-    if (m_nWinner == (3 - nPlayer))
+    if (this->m_nWinner == (3 - nPlayer))
         return INT_MIN;
 
-    // Clear structs for game state; one for player and one for opponent
-    m_stMyCounts = {};
-    m_stOpponentCounts = {};
-
-    // Evaluate the entire board and count sequences of tokens in all directions
-    // (horizontal, vertical, and both diagonals for both players.
-    if (m_nWinner == 0)
+    // Sequences of tokens in all directions (horizontal, vertical, and both
+    // diagonals) for both players are counted as the tokens are placed
+    if (this->m_nWinner == 0)
     {
-        for (int yyy = 0; yyy < m_knY; ++yyy)
-        {
-            for (int xxx = 0; xxx < m_knX; ++xxx)
-            {
-                CountSequence(CheckHorizontal(nPlayer, yyy, xxx), m_stMyCounts);
-                CountSequence(CheckHorizontal(3 - nPlayer, yyy, xxx), m_stOpponentCounts);
-                CountSequence(CheckVertical(nPlayer, yyy, xxx), m_stMyCounts);
-                CountSequence(CheckVertical(3 - nPlayer, yyy, xxx), m_stOpponentCounts);
-                CountSequence(CheckDiagonalUpperLeftLowerRight(nPlayer, yyy, xxx), m_stMyCounts);
-                CountSequence(CheckDiagonalUpperLeftLowerRight(3 - nPlayer, yyy, xxx), m_stOpponentCounts);
-                CountSequence(CheckDiagonalUpperRightLowerLeft(nPlayer, yyy, xxx), m_stMyCounts);
-                CountSequence(CheckDiagonalUpperRightLowerLeft(3 - nPlayer, yyy, xxx), m_stOpponentCounts);
-            }
-        }
+        const SequenceCounts &stMyCounts = m_astSequenceCounts[nPlayer];
+        const SequenceCounts &stOpponentCounts = m_astSequenceCounts[3 - nPlayer];
 
         // Calculate a number based on the number of sequence counts for the player
         // less the number of sequence counts for the opponent, weighting the opponent's
         // sequence counts higher.
-        return ( (m_stMyCounts.nCount2 * 10) - (m_stOpponentCounts.nCount2 * 100) +
-                 (m_stMyCounts.nCount3 * 1000) - (m_stOpponentCounts.nCount3 * 10000) );
+        return ( (stMyCounts.nCount2 * 10) - (stOpponentCounts.nCount2 * 100) +
+                 (stMyCounts.nCount3 * 1000) - (stOpponentCounts.nCount3 * 10000) +
+                 (stMyCounts.nCount4 * 100000) - (stOpponentCounts.nCount4 * 1000000) );
     }
 
     return 0;
 }
 
 /**
-  * Count sequences of contiguous tokens.
+  * Update the sequence counts for a placed token.
   *
-  * Increment a sequence count.
+  * Along each direction, the token joins the lines of the player's tokens
+  * on either side of it into one line.  Remove the lines joined from the
+  * counts and add the line they make, and note the first direction in
+  * which that line is long enough to win.
   *
-  * \param nSequence        The length of a contiguous line of tokens to count
-  * \param stSequenceCounts The struct containing the sequence counts
+  * \param nPlayer The player who placed the token
+  * \param nX      The X-coordinate of the token
+  * \param nY      The Y-coordinate of the token
   */
 
-void LinearGame::CountSequence(int nSequence, SequenceCounts &stSequenceCounts)
+template <class Lines, class Board>
+void LinearGame<Lines, Board>::CountPlacedToken(int nPlayer, int nX, int nY)
 {
-    switch (nSequence)
-    {
-        case 0:
-            break;
-        case 1:
-            ++stSequenceCounts.nCount1;
-            break;
-        case 2:
-            ++stSequenceCounts.nCount2;
-            break;
-        case 3:
-            ++stSequenceCounts.nCount3;
-            break;
-        default:
-            break; // TODO - should not get here
-    }
-    return;
-}
+    const int knSquare = Lines::Square(nX, nY);
 
-/**
-  * Check for a number of contiguous tokens along orthogonal lines
-  *
-  * Evaluate the entire board horizontally and vertically for a number of
-  * contiguous tokens for a player.
-  *
-  * \param nPlayer  The player whose turn it is
-  * \param nConnect The number of contiguous (connected) tokens to evaluate for
-  *
-  * \return True, if the length of contiguous line of tokens matches the nConnect parameter.  False otherwise.
-  */
+    m_anSquarePlayers[knSquare] = nPlayer;
+    m_nWinningDirection = -1;
 
-bool LinearGame::CheckOrthogonal(int nPlayer, int nConnect)
-{
-    bool bWin = false;
+    SequenceCounts &stSequenceCounts = m_astSequenceCounts[nPlayer];
 
-    // Evaluate the entire board, checking horizontally for the player's tokens
-    for (int yyy = 0; yyy < m_knY; ++yyy)
+    for (int nDirection = 0; nDirection < Lines::m_knDirections; ++nDirection)
     {
-        for (int xxx = 0; xxx < m_knX; ++xxx)
-        {
-            // If a contiguous line is found that matches the desired length,
-            // set the bWin flag to true and assign a value to sWinBy.
-            if (CheckHorizontal(nPlayer, yyy, xxx) == nConnect)
-            {
-                bWin = true;
-                m_sWinBy.assign("Horizontal");
-                break;
-            }
-        }
-
-        // If game won, stop evaluating
-        if (bWin)
-            break;
-    }
+        const int knBefore = CountDirection(nPlayer, knSquare, -Lines::Step(nDirection), Lines::Reach(knSquare, nDirection, false));
+        const int knAfter  = CountDirection(nPlayer, knSquare, Lines::Step(nDirection), Lines::Reach(knSquare, nDirection, true));
 
-    // Evaluate the entire board, checking vertically for the player's tokens
-    if (!bWin)
-    {
-        for (int yyy = 0; yyy < m_knY; ++yyy)
-        {
-            for (int xxx = 0; xxx < m_knX; ++xxx)
-            {
-                // If a contiguous line is found that matches the desired length,
-                // set the bWin flag to true and assign a value to sWinBy.
-                if (CheckVertical(nPlayer, yyy, xxx) == nConnect)
-                {
-                    bWin = true;
-                    m_sWinBy.assign("Vertical");
-                    break;
-                }
-            }
+        CountSequence(knBefore, -1, stSequenceCounts);
+        CountSequence(knAfter, -1, stSequenceCounts);
+        CountSequence(knBefore + 1 + knAfter, 1, stSequenceCounts);
 
-            // If game won, stop evaluating
-            if (bWin)
-                break;
-        }
+        // The first line long enough to win is the one a search of the board
+        // would find
+        if ((m_nWinningDirection < 0) && (knBefore + 1 + knAfter >= m_knTokensInARowWin))
+            m_nWinningDirection = nDirection;
     }
-
-    return bWin;
 }
 
 /**
-  * Check for a number of contiguous tokens along horizontal lines
-  *
-  * A recursive function that is given a pair of X- and Y-coordinates and moves
-  * horizontally upwards, counting the number of contiguus tokens for a player.
+  * Count a line of contiguous tokens.
   *
-  * \param nPlayer  The player whose turn it is
-  * \param y        The Y-coordinate
-  * \param x        The X-coordinate
+  * Add a line to, or remove a line from, the counts of lines at least one,
+  * two, three, and four tokens long.
   *
-  * \return The number of contiguous tokens counted
+  * \param nSequence        The length of a contiguous line of tokens to count
+  * \param nSign            One to add the line, or minus one to remove it
+  * \param stSequenceCounts The struct containing the sequence counts
   */
 
-int LinearGame::CheckHorizontal(int nPlayer, int y, int x) const
+template <class Lines, class Board>
+void LinearGame<Lines, Board>::CountSequence(int nSequence, int nSign, SequenceCounts &stSequenceCounts)
 {
-    if (!cBoard.ValidLocation(x, y)) return 0;
-
-    if (cBoard.PositionOccupiedByPlayer(x, y, nPlayer))
-        return (1 + CheckHorizontal(nPlayer, y, x+1));
-    else
-        return 0;
+    if (nSequence >= 1)
+        stSequenceCounts.nCount1 += nSign;
+    if (nSequence >= 2)
+        stSequenceCounts.nCount2 += nSign;
+    if (nSequence >= 3)
+        stSequenceCounts.nCount3 += nSign;
+    if (nSequence >= 4)
+        stSequenceCounts.nCount4 += nSign;
 }
 
 /**
-  * Check for a number of contiguous tokens along vertical lines
+  * Return the outcome of a win by a line in a direction.
   *
-  * A recursive function that is given a pair of X- and Y-coordinates and moves
-  * vertically to the right, counting the number of contiguus tokens for a player.
+  * \param nDirection The direction of the line
   *
-  * \param nPlayer  The player whose turn it is
-  * \param y        The Y-coordinate
-  * \param x        The X-coordinate
-  *
-  * \return The number of contiguous tokens counted
+  * \return The GameOutcome.
   */
 
-int LinearGame::CheckVertical(int nPlayer, int y, int x) const
+template <class Lines, class Board>
+GameOutcome LinearGame<Lines, Board>::LineOutcome(int nDirection)
 {
-    if (!cBoard.ValidLocation(x, y)) return 0;
+    static const GameOutcome kaecOutcomes[Lines::m_knDirections] { GameOutcome::OUTCOME_HORIZONTAL, GameOutcome::OUTCOME_VERTICAL,
+                                                                   GameOutcome::OUTCOME_DIAGONAL_ULLR, GameOutcome::OUTCOME_DIAGONAL_URLL };
 
-    if (cBoard.PositionOccupiedByPlayer(x, y, nPlayer))
-        return (1 + CheckVertical(nPlayer, y+1, x));
-    else
-        return 0;
+    return kaecOutcomes[nDirection];
 }
 
 /**
-  * Check for a number of contiguous tokens along diagonal lines
+  * Check for a winning line of tokens in a direction
   *
-  * Evaluate the entire board diagnollay for a number of
-  * contiguous tokens for a player.
+  * Evaluate every winning line of the board in a direction for one filled
+  * with a player's tokens.
   *
-  * \param nPlayer  The player whose turn it is
-  * \param nConnect The number of contiguous (connected) tokens to evaluate for
+  * \param nPlayer    The player
+  * \param nDirection The direction of the lines
   *
-  * \return True, if the length of contiguous line of tokens matches the nConnect parameter.  False otherwise.
+  * \return True, if a winning line is filled with the player's tokens.  False otherwise.
   */
 
-bool LinearGame::CheckDiagonal(int nPlayer, int nConnect)
+template <class Lines, class Board>
+bool LinearGame<Lines, Board>::CheckLines(int nPlayer, int nDirection) const
 {
-    bool bWin = false;
+    const int knStep = Lines::Step(nDirection);
 
-    // Evaluate the entire board, checking diagonally for the player's tokens
-    for (int yyy = 0; yyy < m_knY; ++yyy)
+    for (int nLine = Lines::FirstLine(nDirection); nLine < Lines::FirstLine(nDirection) + Lines::Lines(nDirection); ++nLine)
     {
-        for (int xxx = 0; xxx < m_knX; ++xxx)
-        {
-            // If a contiguous line is found that matches the desired length,
-            // set the bWin flag to true and assign a value to sWinBy.
-            if (CheckDiagonalUpperLeftLowerRight(nPlayer, yyy, xxx) == nConnect)
-            {
-                bWin = true;
-                m_sWinBy.assign("DiagonalULLR");
-                break;
-            }
-        }
-        // If game won, stop evaluating
-        if (bWin)
-            break;
-    }
+        const int knStart = Lines::LineStart(nLine);
 
-    // Evaluate the entire board, checking diagonally for the player's tokens
-    if (!bWin)
-    {
-        for (int yyy = 0; yyy < m_knY; ++yyy)
-        {
-            for (int xxx = m_knX - 1; xxx >= 0; --xxx)
-            {
-                // If a contiguous line is found that matches the desired length,
-                // set the bWin flag to true and assign a value to sWinBy.
-                if (CheckDiagonalUpperRightLowerLeft(nPlayer, yyy, xxx) == nConnect)
-                {
-                    bWin = true;
-                    m_sWinBy.assign("DiagonalURLL");
-                    break;
-                }
-            }
-            // If game won, stop evaluating
-            if (bWin)
-                break;
-        }
+        int nCount = 0;
+        while ((nCount < m_knTokensInARowWin) && (m_anSquarePlayers[knStart + (nCount * knStep)] == nPlayer))
+            ++nCount;
+
+        if (nCount == m_knTokensInARowWin)
+            return true;
     }
 
-    return bWin;
+    return false;
 }
 
 /**
-  * Check for a number of contiguous tokens along upper-left to lower-right
-  * diagnoal lines
-  *
-  * A recursive function that is given a pair of X- and Y-coordinates and moves
-  * diagnollay to the lower-right, counting the number of contigous tokens for
-  * a player.
+  * Count contiguous tokens in one direction from a square
   *
-  * \param nPlayer  The player whose turn it is
-  * \param y        The Y-coordinate
-  * \param x        The X-coordinate
+  * \param nPlayer The player
+  * \param nSquare The square
+  * \param nStep   The step from one square to the next
+  * \param nReach  The number of squares from the square to the edge of the board
   *
-  * \return The number of contiguous tokens counted
+  * \return The number of contiguous tokens counted, not including the square
   */
 
-int LinearGame::CheckDiagonalUpperLeftLowerRight(int nPlayer, int y, int x) const
+template <class Lines, class Board>
+int LinearGame<Lines, Board>::CountDirection(int nPlayer, int nSquare, int nStep, int nReach) const
 {
-    if (!cBoard.ValidLocation(x, y)) return 0;
+    int nCount = 0;
 
-    if (cBoard.PositionOccupiedByPlayer(x, y, nPlayer))
-        return (1 + CheckDiagonalUpperLeftLowerRight(nPlayer, y+1, x+1));
-    else
-        return 0;
-}
+    for (nSquare += nStep; (nCount < nReach) && (m_anSquarePlayers[nSquare] == nPlayer); nSquare += nStep)
+        ++nCount;
 
-/**
-  * Check for a number of contiguous tokens along upper-right to lower-left
-  * diagnoal lines
-  *
-  * A recursive function that is given a pair of X- and Y-coordinates and moves
-  * diagnollay to the lower-left, counting the number of contigous tokens for
-  * a player.
-  *
-  * \param nPlayer  The player whose turn it is
-  * \param y        The Y-coordinate
-  * \param x        The X-coordinate
-  *
-  * \return The number of contiguous tokens counted
-  */
-
-int LinearGame::CheckDiagonalUpperRightLowerLeft(int nPlayer, int y, int x) const
-{
-    if (!cBoard.ValidLocation(x, y)) return 0;
-
-    if (cBoard.PositionOccupiedByPlayer(x, y, nPlayer))
-        return (1 + CheckDiagonalUpperRightLowerLeft(nPlayer, y+1, x-1));
-    else
-        return 0;
+    return nCount;
 }
 
 /**
@@ -449,7 +352,8 @@ int LinearGame::CheckDiagonalUpperRightLowerLeft(int nPlayer, int y, int x) cons
   * \return A random integer.
   */
 
-int LinearGame::PreferredMove(const GameMove &cGameMove) const
+template <class Lines, class Board>
+int LinearGame<Lines, Board>::PreferredMove(const GameMove &cGameMove) const
 {
     (void)cGameMove;
 
@@ -480,54 +384,107 @@ int LinearGame::PreferredMove(const GameMove &cGameMove) const
   * \return True, if any player has won the game.  False otherwise.
   */
 
-bool LinearGame::GameEnded(int nPlayer)
+template <class Lines, class Board>
+bool LinearGame<Lines, Board>::GameEnded(int nPlayer)
 {
+    MoveList cMoveList;
+
+    return GameEndedWithMoves(nPlayer, cMoveList);
+}
+
+/**
+  * Check to see if a player has won the game, keeping the valid moves.
+  *
+  * As GameEnded(), but the player's moves, generated to see whether the
+  * board is full, are left in cMoveList for the search to use.
+  *
+  * \param nPlayer   The player
+  * \param cMoveList The list to fill with valid moves
+  *
+  * \return True, if any player has won the game.  False otherwise.
+  */
+
+template <class Lines, class Board>
+bool LinearGame<Lines, Board>::GameEndedWithMoves(int nPlayer, MoveList &cMoveList)
+{
+    cMoveList.Clear();
+
     // Clear win variables
-    m_nWinner = 0;
-    m_sWinBy.assign("nothing");
+    this->m_nWinner = 0;
+    this->SetOutcome(GameOutcome::OUTCOME_NOTHING);
 
-    if (BoardGame::GameEnded(nPlayer))
+    if (BoardGame<Board>::GameEnded(nPlayer))
         return true;
 
-    // Evaluate orthognal lines for player 1
-    if (CheckOrthogonal(m_knPlayer1, m_knTokensInARowWin))
+    // If the board had no winning line before the last move, only a line
+    // through the last token placed can have been completed, as found when
+    // the token was counted
+    if (this->m_nNumberOfMoves == m_nNoWinnerAtMove + 1)
     {
-        m_nWinner = m_knPlayer1;
-        m_bGameOver = true;
-        return true;
-    }
+        if (m_nWinningDirection >= 0)
+        {
+            GameMove cLastMove = this->LastMove();
 
-    // Evaluate orthognal lines for player 2
-    if (CheckOrthogonal(m_knPlayer2, m_knTokensInARowWin))
-    {
-        m_nWinner = m_knPlayer2;
-        m_bGameOver = true;
-        return true;
+            this->SetOutcome(LineOutcome(m_nWinningDirection));
+            this->m_nWinner = m_anSquarePlayers[Lines::Square(cLastMove.ToX(), cLastMove.ToY())];
+            this->m_bGameOver = true;
+            return true;
+        }
     }
-
-    // Evaluate diagnoal lines for player 1
-    if (CheckDiagonal(m_knPlayer1, m_knTokensInARowWin))
+    // Otherwise, as for moves read from a file, evaluate the whole board
+    else if (this->m_nNumberOfMoves != m_nNoWinnerAtMove)
     {
-        m_nWinner = m_knPlayer1;
-        m_bGameOver = true;
-        return true;
+        if (FullScanEnded())
+            return true;
     }
 
-    // Evaluate diagnoal lines for player 2
-    if (CheckDiagonal(m_knPlayer2, m_knTokensInARowWin))
+    m_nNoWinnerAtMove = this->m_nNumberOfMoves;
+
+    // Evaluate whether the player has any valid moves to make
+    this->GenerateBoardMoves(nPlayer, cMoveList);
+    if (cMoveList.Empty())
     {
-        m_nWinner = m_knPlayer2;
-        m_bGameOver = true;
+        this->m_bGameOver = true;
         return true;
     }
 
-    // Evaluate whether the player has any valid moves to make
-    std::vector<GameMove> vGameMoves = GenerateMoves(nPlayer);
-    if (vGameMoves.empty())
+    return false;
+}
+
+/**
+  * Check the whole board to see if a player has won the game.
+  *
+  * \return True, if any player has won the game.  False otherwise.
+  */
+
+template <class Lines, class Board>
+bool LinearGame<Lines, Board>::FullScanEnded()
+{
+    // Evaluate orthogonal lines for both players, then diagonal lines
+    for (int nFirstDirection = 0; nFirstDirection < Lines::m_knDirections; nFirstDirection += 2)
     {
-        m_bGameOver = true;
-        return true;
+        for (int nPlayer = this->m_knPlayer1; nPlayer <= this->m_knPlayer2; ++nPlayer)
+        {
+            for (int nDirection = nFirstDirection; nDirection < nFirstDirection + 2; ++nDirection)
+            {
+                if (CheckLines(nPlayer, nDirection))
+                {
+                    this->SetOutcome(LineOutcome(nDirection));
+                    this->m_nWinner = nPlayer;
+                    this->m_bGameOver = true;
+                    return true;
+                }
+            }
+        }
     }
 
     return false;
 }
+
+// The board size and tokens in a row of each game.  A game with a new
+// combination needs its own line here.
+template class LinearGame<LinearLines<3, 3, 3>>;    // Tic-Tac-Toe
+template class LinearGame<LinearLines<7, 6, 4>>;    // Connect Four
+template class LinearGame<LinearLines<8, 8, 0>>;    // Reversi
+template class LinearGame<LinearLines<15, 15, 5>, StoneBoard>;  // Gomoku
+template class LinearGame<LinearLines<19, 19, 5>, StoneBoard>;  // Gomoku on a 19x19 board
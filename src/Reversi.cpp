@@ -19,6 +19,9 @@
 
 #include "Reversi.h"
 
+#include <cassert>
+#include <random>
+
 /**
   * Initilize the board for Reversi play.
   *
@@ -31,6 +34,7 @@ void Reversi::SetBoard()
 
     cBoard.Clear();
     cBoard.ReverseColors();
+    m_cBitboard.Clear();
 
     cGamePiece.Set(m_acTokens[2], 2);
     cBoard.SetPiece((m_knX /2) - 1, (m_knY / 2) - 1, cGamePiece);
@@ -43,751 +47,374 @@ void Reversi::SetBoard()
 
     cGamePiece.Set(m_acTokens[2], 2);
     cBoard.SetPiece((m_knX /2), (m_knY / 2), cGamePiece);
-}
-
-/**
-  * Return a vector of valid game moves.
-  *
-  * Review and collect all valid moves for a player into a vector.
-  *
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return A vector of valid moves.
-  */
 
-std::vector<GameMove> Reversi::GenerateMoves(int nPlayer)
-{
-    std::vector<GameMove> vGameMoves {};
+    m_cBitboard.Place(2, (m_knX /2) - 1, (m_knY / 2) - 1);
+    m_cBitboard.Place(1, (m_knX /2), (m_knY / 2) - 1);
+    m_cBitboard.Place(1, (m_knX /2) - 1, (m_knY / 2));
+    m_cBitboard.Place(2, (m_knX /2), (m_knY / 2));
 
-    for (int xxx = 0; xxx < m_knX; ++xxx)
-    {
-        for (int yyy = 0; yyy < m_knY; ++yyy)
-        {
-            if (!cBoard.PositionOccupied(xxx, yyy))
-            {
-                if (Contiguous(xxx, yyy, nPlayer)) // Check valid move
-                {
-                    vGameMoves.emplace_back(0, 0, xxx, yyy, true, false);
-                }
-            }
-        }
-    }
-
-    return vGameMoves;
+    SetPatternIndices();
 }
 
 /**
-  * Apply the move to the game.
+  * Fill a list with the valid game moves.
   *
-  * Find the bottom of the grid for the selected move, update the GameMove
-  * object with that location, and pass it to LinearGame for application.
+  * Review and collect all valid moves for a player into a list.
   *
-  * \param nPlayer The player whose turn it is.
-  * \param cGameMove The game move
-  *
-  * \return True if the move is valid, false otherwise
+  * \param nPlayer   The player whose turn it is.
+  * \param cMoveList The list to fill with valid moves
   */
 
-bool Reversi::ApplyMove(int nPlayer, GameMove &cGameMove)
+void Reversi::GenerateBoardMoves(int nPlayer, MoveList &cMoveList)
 {
-    bool bValidMove = false;
-
-    // Generate a vector of all possible valid moves for this player
-    std::vector<GameMove> vGameMoves = GenerateMoves(nPlayer);
-
-    // If the GameMove (passed to this method) is not valid for a LinearGame
-    // return false
-    if (!LinearGame::ApplyMove(nPlayer, cGameMove))
-        return false;
-
-    // Evaluate whether the game ended with the LinearGame::ApplyMove
-    if (GameEnded(3 - nPlayer))
-        return true;
-
-    // Compare passed GameMove to generated game moves.  If one is found to be
-    // the same, flip tokens accordingly.
-    for (GameMove &cValidGameMove : vGameMoves)
-    {
-        if (cValidGameMove.SameTo(cGameMove))
-        {
-            Flip(nPlayer, cGameMove);
-            bValidMove = true;
-            break;
-        }
-    }
-
-    // TODO: If move was not valid, remove it from m_vGameMoves
+    cMoveList.Clear();
 
-    return bValidMove;
+    AddBoardMoves(m_cBitboard.Moves(nPlayer), cMoveList);
 }
 
 /**
-  * Flip (change) tokens.
-  *
-  * Examine all directions from the GameMove location, and flip tokens
-  * accordingly.
-  *
-  * \param nPlayer The player whose turn it is.
-  * \param cGameMove The game move
-  */
-
-void Reversi::Flip(int nPlayer, const GameMove &cGameMove)
-{
-    FlipUp(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-    FlipUpRight(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-    FlipRight(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-    FlipDownRight(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-    FlipDown(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-    FlipDownLeft(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-    FlipLeft(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-    FlipUpLeft(cGameMove.ToX(), cGameMove.ToY(), nPlayer);
-
-    return;
-}
-
-/**
-  * Change token.
-  *
-  * If location's token belongs to the other player, "flip it"
-  * to this player.
+  * Fill a list with a move to each square of a mask.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
+  * The squares are taken in ascending order, column by column from the
+  * left, and down each column.
   *
-  * \return True if flip occured, false otherwise.
+  * \param uiMoves   The squares to move to
+  * \param cMoveList The list to add the moves to
   */
 
-bool Reversi::FlipToken(int nX, int nY, int nPlayer)
+void Reversi::AddBoardMoves(uint64_t uiMoves, MoveList &cMoveList)
 {
-    GamePiece cGamePiece;
-
-    if (!cBoard.PositionOccupiedByPlayer(nX, nY, nPlayer))
-    {
-        cGamePiece.Set(m_acTokens[nPlayer], nPlayer);
-        cBoard.SetPiece(nX, nY, cGamePiece);
-        return true;
-    }
-    else
+    for (; uiMoves != 0; uiMoves &= uiMoves - 1)
     {
-        return false;
+        cMoveList.Add(BoardMove(0, 0, ReversiBitboard::X(uiMoves), ReversiBitboard::Y(uiMoves), true, false));
     }
 }
 
 /**
-  * Flip (change) tokens along a vertical-up line.
-  *
-  * Examine a line "up" from token location and flip all contiguous tokens
-  * accordingly.
+  * Apply the move to the game.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  */
-
-void Reversi::FlipUp(int nX, int nY, int nPlayer)
-{
-    GamePiece cGamePiece;
-
-    if (ContiguousUp(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            --nY;
-
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
-}
-
-/**
-  * Flip (change) tokens along a diagonal-up-and-right line.
+  * Pass the move to LinearGame for application, then flip the tokens it
+  * captures.
   *
-  * Examine a line "up and to the right" from token location and flip all
-  * contiguous tokens accordingly.
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The game move
   *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
+  * \return True if the move is valid, false otherwise
   */
 
-void Reversi::FlipUpRight(int nX, int nY, int nPlayer)
+bool Reversi::ApplyBoardMove(int nPlayer, const BoardMove &cBoardMove)
 {
-    if (ContiguousUpRight(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            ++nX;
-            --nY;
+    // Check that the move is one of the valid moves for this player
+    bool bValidMove = cBoard.ValidLocation(cBoardMove.ToX(), cBoardMove.ToY()) &&
+                      ((m_cBitboard.Moves(nPlayer) & ReversiBitboard::Square(cBoardMove.ToX(), cBoardMove.ToY())) != 0);
 
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
-}
+    // If the BoardMove (passed to this method) is not valid for a LinearGame
+    // return false
+    if (!LinearGame::ApplyBoardMove(nPlayer, cBoardMove))
+        return false;
 
-/**
-  * Flip (change) tokens along a horizontal-right line.
-  *
-  * Examine a line "to the right" from token location and flip all
-  * contiguous tokens accordingly.
-  *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  */
+    Place(nPlayer, cBoardMove);
 
-void Reversi::FlipRight(int nX, int nY, int nPlayer)
-{
-    if (ContiguousRight(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            ++nX;
+    // If the move is valid, flip tokens accordingly.
+    if (bValidMove)
+        Flip(nPlayer, cBoardMove);
 
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
-}
-
-/**
-  * Flip (change) tokens along a diagonal-down-and-right line.
-  *
-  * Examine a line "down and to the right" from token location and flip all
-  * contiguous tokens accordingly.
-  *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  */
+    // Evaluate whether the game ended with the move
+    if (GameEnded(3 - nPlayer))
+        return true;
 
-void Reversi::FlipDownRight(int nX, int nY, int nPlayer)
-{
-    if (ContiguousDownRight(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            ++nX;
-            ++nY;
+    // TODO: If move was not valid, remove it from m_cGameMoves
 
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
+    return bValidMove;
 }
 
 /**
-  * Flip (change) tokens along a dvertical-down line.
-  *
-  * Examine a line "down" from token location and flip all
-  * contiguous tokens accordingly.
+  * Apply a move generated by the game, without validating it.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  */
-
-void Reversi::FlipDown(int nX, int nY, int nPlayer)
-{
-    if (ContiguousDown(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            ++nY;
-
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
-}
-
-/**
-  * Flip (change) tokens along a diagonal-down-and-left line.
+  * As ApplyBoardMove(), but without checking the move against the valid
+  * moves.  A debug build still does, and asserts that it is there.
   *
-  * Examine a line "down and to the left" from token location and flip all
-  * contiguous tokens accordingly.
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The generated move
   *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
+  * \return True.
   */
 
-void Reversi::FlipDownLeft(int nX, int nY, int nPlayer)
+bool Reversi::ApplyTrustedBoardMove(int nPlayer, const BoardMove &cBoardMove)
 {
-    if (ContiguousDownLeft(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            --nX;
-            ++nY;
+    assert(((m_cBitboard.Moves(nPlayer) & ReversiBitboard::Square(cBoardMove.ToX(), cBoardMove.ToY())) != 0) &&
+           "Reversi::ApplyTrustedBoardMove() move was not generated");
 
+    LinearGame::ApplyTrustedBoardMove(nPlayer, cBoardMove);
 
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
-}
+    Place(nPlayer, cBoardMove);
 
-/**
-  * Flip (change) tokens along a horizontal-left line.
-  *
-  * Examine a line "to the left" from token location and flip all
-  * contiguous tokens accordingly.
-  *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  */
-
-void Reversi::FlipLeft(int nX, int nY, int nPlayer)
-{
-    if (ContiguousLeft(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            --nX;
+    Flip(nPlayer, cBoardMove);
 
+    // Evaluate whether the game ended with the move
+    GameEnded(3 - nPlayer);
 
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
+    return true;
 }
 
 /**
-  * Flip (change) tokens along a diagonal-up-and-left line.
+  * Place a token.
   *
-  * Examine a line "up and to the left" from token location and flip all
-  * contiguous tokens accordingly.
+  * Place the token on the bitboard and, if there are pattern weights, in the
+  * pattern indices.  The GameBoard is set by LinearGame.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The tokens's Y-coordinate
-  * \param nPlayer The player whose turn it is.
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The game move
   */
 
-void Reversi::FlipUpLeft(int nX, int nY, int nPlayer)
+void Reversi::Place(int nPlayer, const BoardMove &cBoardMove)
 {
-    if (ContiguousUpLeft(nX, nY, nPlayer))
-    {
-        while (true)
-        {
-            --nX;
-            --nY;
+    m_cBitboard.Place(nPlayer, cBoardMove.ToX(), cBoardMove.ToY());
 
-            if (FlipToken(nX, nY, nPlayer))
-                continue;
-            else
-                break;
-        }
-    }
+    if (m_pcPatterns != nullptr)
+        ReversiPatterns::Place(m_stPatternIndices, nPlayer, cBoardMove.ToX() * m_kiDimension + cBoardMove.ToY());
 }
 
 /**
-  * Evaluate the contiguousness of a player's tokens from a location
-  * on the board.  To make a valid move in Reversi, the location must have
-  * at least one straight (horizontal, vertical, or diagonal) occupied line
-  * between the player's new token and another token, with one or more contiguous
-  * opponent's tokens between them.
+  * Flip (change) tokens.
   *
-  * Examine all directions from a given location, returning true if any
-  * direction has contiguous tokens.
+  * Find every token captured along all directions from the BoardMove
+  * location as one mask, and flip them on the bitboard, the board, and, if
+  * there are pattern weights, in the pattern indices.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
-  * \param nPlayer The player whose turn it is.
+  * \param nPlayer    The player whose turn it is.
+  * \param cBoardMove The game move
   */
 
-bool Reversi::Contiguous(int nX, int nY, int nPlayer) const
+void Reversi::Flip(int nPlayer, const BoardMove &cBoardMove)
 {
-    if (ContiguousUp(nX, nY, nPlayer))
-        return true;
+    uint64_t uiFlips = m_cBitboard.Flips(nPlayer, cBoardMove.ToX(), cBoardMove.ToY());
 
-    if (ContiguousUpRight(nX, nY, nPlayer))
-        return true;
-
-    if (ContiguousRight(nX, nY, nPlayer))
-        return true;
-
-    if (ContiguousDownRight(nX, nY, nPlayer))
-        return true;
-
-    if (ContiguousDown(nX, nY, nPlayer))
-        return true;
-
-    if (ContiguousDownLeft(nX, nY, nPlayer))
-        return true;
-
-    if (ContiguousLeft(nX, nY, nPlayer))
-        return true;
+    m_cBitboard.Flip(nPlayer, uiFlips);
 
-    if (ContiguousUpLeft(nX, nY, nPlayer))
-        return true;
-
-    return false;
-}
-
-/**
-  * Examine tokens along a vertical-up line.
-  *
-  * Examine a line "up" from token location for contiguousness.
-  *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return True if a contiguous line exists.  False otherwise.
-  */
-
-bool Reversi::ContiguousUp(int nX, int nY, int nPlayer) const
-{
-    bool bOpponentPieceAdjacent = false;
-
-    while (true)
+    GamePiece cGamePiece(m_acTokens[nPlayer], nPlayer);
+    for (; uiFlips != 0; uiFlips &= uiFlips - 1)
     {
-        --nY;
+        cBoard.SetPiece(ReversiBitboard::X(uiFlips), ReversiBitboard::Y(uiFlips), cGamePiece);
 
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-            return true;
-        else
-        {
-            if (!bOpponentPieceAdjacent)
-                return false;
-        }
+        if (m_pcPatterns != nullptr)
+            ReversiPatterns::Flip(m_stPatternIndices, nPlayer, __builtin_ctzll(uiFlips));
     }
-
-    return false;
 }
 
 /**
-  * Examine tokens along a diagonal-up-and-right line.
-  *
-  * Examine a line "up and to the right" from token location for contiguousness.
+  * Set the pattern indices from the bitboard.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return True if a contiguous line exists.  False otherwise.
+  * Clear the indices and place every token on the board in them, if there
+  * are pattern weights.
   */
 
-bool Reversi::ContiguousUpRight(int nX, int nY, int nPlayer) const
+void Reversi::SetPatternIndices()
 {
-    bool bOpponentPieceAdjacent = false;
+    m_stPatternIndices = ReversiPatterns::Indices();
 
-    while (true)
-    {
-        ++nX;
-        --nY;
+    if (m_pcPatterns == nullptr)
+        return;
 
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-            return true;
-        else
-        {
-            if (!bOpponentPieceAdjacent)
-                return false;
-        }
+    for (int nPlayer = m_knPlayer1; nPlayer <= m_knPlayer2; ++nPlayer)
+    {
+        for (uint64_t uiDiscs = m_cBitboard.Discs(nPlayer); uiDiscs != 0; uiDiscs &= uiDiscs - 1)
+            ReversiPatterns::Place(m_stPatternIndices, nPlayer, __builtin_ctzll(uiDiscs));
     }
-
-    return false;
 }
 
 /**
-  * Examine tokens along a horizontal-right line.
+  * Generate a perfect move.
   *
-  * Examine a line "to the right" from token location for contiguousness.
+  * Solve the endgame from the current position, making the solver when
+  * first needed.  The solver keeps what it learns from one move to the next.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
   * \param nPlayer The player whose turn it is.
   *
-  * \return True if a contiguous line exists.  False otherwise.
+  * \return The move with the best final score for the player, or a "no
+  * move" if the player cannot move.
   */
 
-bool Reversi::ContiguousRight(int nX, int nY, int nPlayer) const
+GameMove Reversi::SolvedMove(int nPlayer)
 {
-    bool bOpponentPieceAdjacent = false;
+    if (m_pcEndgameSolver == nullptr)
+        m_pcEndgameSolver = std::make_shared<ReversiEndgameSolver>();
 
-    while (true)
-    {
-        ++nX;
+    int nScore {0};
+    int nSquare = m_pcEndgameSolver->BestMove(m_cBitboard.Discs(nPlayer), m_cBitboard.Discs(3 - nPlayer), nScore);
 
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-            return true;
-        else
-        {
-            if (!bOpponentPieceAdjacent)
-                return false;
-        }
+    // Log the solution
+    if (m_cLogger.Level() >= 2)
+    {
+        std::string sMessage = "SolvedMove Player=" + std::to_string(nPlayer) + " Square=" + std::to_string(nSquare) +
+                               " Score=" + std::to_string(nScore) + " Nodes=" + std::to_string(m_pcEndgameSolver->Nodes());
+        m_cLogger.LogInfo(sMessage, 2);
     }
 
-    return false;
-}
-
-/**
-  * Examine tokens along a diagonal-down-and-right line.
-  *
-  * Examine a line "down and to the right" from token location for contiguousness.
-  *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return True if a contiguous line exists.  False otherwise.
-  */
-
-bool Reversi::ContiguousDownRight(int nX, int nY, int nPlayer) const
-{
-    bool bOpponentPieceAdjacent = false;
-
-    while (true)
+    if (nSquare < 0)
     {
-        ++nX;
-        ++nY;
-
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-            return true;
-        else
-        {
-            if (!bOpponentPieceAdjacent)
-                return false;
-        }
+        GameMove cNoMove;
+        cNoMove.SetNoMove(true);
+        return cNoMove;
     }
 
-    return false;
+    uint64_t uiMove = UINT64_C(1) << nSquare;
+
+    return BoardMove(0, 0, ReversiBitboard::X(uiMove), ReversiBitboard::Y(uiMove), true, false).ToGameMove();
 }
 
 /**
-  * Examine tokens along a vertical-down line.
+  * Evaluate the game state.
+  *
+  * From a player's perspective, return a value cooresponding to the player's
+  * standing in the game.  If the player has won the game, return a large,
+  * positive integer.  If winning, a smaller, positive integer. If lost or
+  * losing, a negative integer.
   *
-  * Examine a line "down" from token location for contiguousness.
+  * With pattern weights, the value is the sum of the weights of the
+  * patterns on the board.  Without, it is a blend of the number of tokens,
+  * the squares they hold, and the number of moves.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
   * \param nPlayer The player whose turn it is.
   *
-  * \return True if a contiguous line exists.  False otherwise.
+  * \return An integer representing game state for the player.
   */
 
-bool Reversi::ContiguousDown(int nX, int nY, int nPlayer) const
+int Reversi::EvaluateGameState(int nPlayer)
 {
-    bool bOpponentPieceAdjacent = false;
+    // If won, return largest positive integer
+    if (m_nWinner == nPlayer)
+        return INT_MAX;
 
-    while (true)
-    {
-        ++nY;
+    // If lost, return largest negative integer
+    if (m_nWinner == (3 - nPlayer))
+        return INT_MIN;
 
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-            return true;
-        else
-        {
-            if (!bOpponentPieceAdjacent)
-                return false;
-        }
+    // Evaluate the patterns on the board, if there are weights for them
+    if (m_pcPatterns != nullptr)
+    {
+        int nPatternEval = m_pcPatterns->Evaluate(m_stPatternIndices, __builtin_popcountll(m_cBitboard.Occupied()));
+        return nPlayer == m_knPlayer1 ? nPatternEval : -nPatternEval;
     }
 
-    return false;
-}
-
-/**
-  * Examine tokens along a diagonal-down-and-left line.
-  *
-  * Examine a line "down and to the left" from token location for contiguousness.
-  *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return True if a contiguous line exists.  False otherwise.
-  */
-
-bool Reversi::ContiguousDownLeft(int nX, int nY, int nPlayer) const
-{
-    bool bOpponentPieceAdjacent = false;
-
-    while (true)
-    {
-        --nX;
-        ++nY;
+    // Evaluate the number of tokens for each player. "Greedy evaluation."
+    int nCountEval  = CountEvaluation(nPlayer)  - CountEvaluation(3 - nPlayer);
+    // Evaluate the value of the occupied positions.
+    int nSquareEval = SquareEvaluation(nPlayer) - SquareEvaluation(3 - nPlayer);
+    // Evaluate the number of moves available.
+    int nMobilityEval = MobilityEvaluation(nPlayer) - MobilityEvaluation(3 - nPlayer);
 
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-            return true;
-        else
-        {
-            if (!bOpponentPieceAdjacent)
-                return false;
-        }
-    }
+    return (nCountEval * 10) + (nSquareEval * 15) + (nMobilityEval * 5);
 
-    return false;
 }
 
 /**
-  * Examine tokens along a horizontal-left line.
+  * Read pattern weights for evaluating the game state.
   *
-  * Examine a line "left" from token location for contiguousness.
+  * The weights are shared with clones of the game.  If they cannot be read,
+  * the game keeps the evaluation it had.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
-  * \param nPlayer The player whose turn it is.
+  * \param sFileName Name of the weight file
   *
-  * \return True if a contiguous line exists.  False otherwise.
+  * \return True if the weights are read.  False otherwise.
   */
 
-bool Reversi::ContiguousLeft(int nX, int nY, int nPlayer) const
+bool Reversi::ReadEvaluationWeights(const std::string &sFileName)
 {
-    bool bOpponentPieceAdjacent = false;
-
-    while (true)
-    {
-        --nX;
+    std::shared_ptr<ReversiPatterns> pcPatterns = std::make_shared<ReversiPatterns>();
+    if (!pcPatterns->Read(sFileName))
+        return false;
 
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-            return true;
-        else
-        {
-            if (!bOpponentPieceAdjacent)
-                return false;
-        }
-    }
+    m_pcPatterns = pcPatterns;
+    SetPatternIndices();
 
-    return false;
+    return true;
 }
 
 /**
-  * Examine tokens along a diagonal-up-and-left line.
+  * Tune pattern weights and write them to a file.
   *
-  * Examine a line "up and to the left" from token location for contiguousness.
+  * Play a number of games from the start, each move chosen at random, and
+  * keep every position with the disc difference its game ended with.  Tune
+  * weights for six phases of the game to the positions kept, three times
+  * over.  The random moves are seeded with the number of games, so that
+  * the same number of games tunes the same weights.
   *
-  * \param nX The token's X-coordinate
-  * \param nY The token's Y-coordinate
-  * \param nPlayer The player whose turn it is.
+  * \param sFileName Name of the weight file
+  * \param nGames    The number of games to play
   *
-  * \return True if a contiguous line exists.  False otherwise.
+  * \return True if the weights are written.  False otherwise.
   */
 
-bool Reversi::ContiguousUpLeft(int nX, int nY, int nPlayer) const
+bool Reversi::WriteEvaluationWeights(const std::string &sFileName, int nGames)
 {
-    bool bOpponentPieceAdjacent = false;
+    if (nGames < 1)
+        return false;
 
-    while (true)
-    {
-        --nX;
-        --nY;
+    std::mt19937 cGenerator(nGames);
+    std::vector<ReversiPatterns::Sample> vstSamples;
 
-        if (CheckContiguous(nX, nY, nPlayer, bOpponentPieceAdjacent))
-        {
-            return true;
-        }
-        else
+    for (int nGame = 0; nGame < nGames; ++nGame)
+    {
+        ReversiBitboard cBitboard;
+        cBitboard.Place(2, (m_knX /2) - 1, (m_knY / 2) - 1);
+        cBitboard.Place(1, (m_knX /2), (m_knY / 2) - 1);
+        cBitboard.Place(1, (m_knX /2) - 1, (m_knY / 2));
+        cBitboard.Place(2, (m_knX /2), (m_knY / 2));
+
+        ReversiPatterns::Sample stSample;
+        for (int nPlayer = m_knPlayer1; nPlayer <= m_knPlayer2; ++nPlayer)
         {
-            if (!bOpponentPieceAdjacent)
-                return false;
+            for (uint64_t uiDiscs = cBitboard.Discs(nPlayer); uiDiscs != 0; uiDiscs &= uiDiscs - 1)
+                ReversiPatterns::Place(stSample.stIndices, nPlayer, __builtin_ctzll(uiDiscs));
         }
-    }
-
-    return false;
-}
 
-/**
-  * Examine the space on the board for contiguousness.
-  *
-  * Examine
-  *
-  * \param nX The X-coordinate of the game location under evaluation.
-  * \param nY The Y-coordinate of the game location under evaluation.
-  * \param nPlayer The player whose turn it is.
-  * \param bOpponentPieceAdjacent A boolean flag indicating whether
-  *        the opponent player has a token adjacent to this space.
-  *
-  * \return True if a contiguous line identified.  False otherwise.
-  */
+        const size_t knFirstSample = vstSamples.size();
+        int nPlayer = m_knPlayer1;
 
-bool Reversi::CheckContiguous(int nX, int nY, int nPlayer, bool &bOpponentPieceAdjacent) const
-{
-    // If location is not valid, set opponent piece adjacent to false and return false
-    if (!cBoard.ValidLocation(nX, nY))
-    {
-        bOpponentPieceAdjacent = false;
-        return false;
-    }
+        for (;;)
+        {
+            uint64_t uiMoves = cBitboard.Moves(nPlayer);
 
-    // If location is clear, set opponent piece adjacent to false and return false
-    if (!cBoard.PositionOccupied(nX, nY))
-    {
-        bOpponentPieceAdjacent = false;
-        return false;
-    }
+            // A player who cannot move passes, and the game ends when neither can
+            if (uiMoves == 0)
+            {
+                if (cBitboard.Moves(3 - nPlayer) == 0)
+                    break;
 
-    // If location contains an opponent's token, set opponent piece adjacent to true and return false
-    if (cBoard.PositionOccupiedByPlayer(nX, nY, 2 - nPlayer + 1))
-    {
-        bOpponentPieceAdjacent = true;
-        return false;
-    }
+                nPlayer = 3 - nPlayer;
+                continue;
+            }
 
-    // If location contains a player's token, and we have already identified an opponent's token as adjacent,
-    // then return true.  Otherwise false.
-    if (cBoard.PositionOccupiedByPlayer(nX, nY, nPlayer))
-    {
-        if (bOpponentPieceAdjacent)
-            return true;
-        else
-            return false;
-    }
+            stSample.nDiscs = __builtin_popcountll(cBitboard.Occupied());
+            vstSamples.push_back(stSample);
 
-    // If no antecedants triggered, set opponent piece adjacent to false and return false
-    bOpponentPieceAdjacent = false;
-    return false;
-}
+            // Pick one of the moves at random
+            std::uniform_int_distribution<int> cDistribution(0, __builtin_popcountll(uiMoves) - 1);
+            for (int nSkip = cDistribution(cGenerator); nSkip > 0; --nSkip)
+                uiMoves &= uiMoves - 1;
+            uint64_t uiMove  = uiMoves & (~uiMoves + 1);
+            uint64_t uiFlips = ReversiBitboard::Flips(uiMove, cBitboard.Discs(nPlayer), cBitboard.Discs(3 - nPlayer));
 
-/**
-  * Evaluate the game state.
-  *
-  * From a player's perspective, return a value cooresponding to the player's
-  * standing in the game.  If the player has won the game, return a large,
-  * positive integer.  If winning, a smaller, positive integer. If lost or
-  * losing, a negative integer.
-  *
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return An integer representing game state for the player.
-  */
+            cBitboard.Place(nPlayer, ReversiBitboard::X(uiMove), ReversiBitboard::Y(uiMove));
+            ReversiPatterns::Place(stSample.stIndices, nPlayer, __builtin_ctzll(uiMove));
 
-int Reversi::EvaluateGameState(int nPlayer)
-{
-    // If won, return largest positive integer
-    if (m_nWinner == nPlayer)
-        return INT_MAX;
+            cBitboard.Flip(nPlayer, uiFlips);
+            for (; uiFlips != 0; uiFlips &= uiFlips - 1)
+                ReversiPatterns::Flip(stSample.stIndices, nPlayer, __builtin_ctzll(uiFlips));
 
-    // If lost, return largest negative integer
-    if (m_nWinner == (3 - nPlayer))
-        return INT_MIN;
+            nPlayer = 3 - nPlayer;
+        }
 
-    // Evaluate the number of tokens for each player. "Greedy evaluation."
-    int nCountEval  = CountEvaluation(nPlayer)  - CountEvaluation(3 - nPlayer);
-    // Evaluate the value of the occupied positions.
-    int nSquareEval = SquareEvaluation(nPlayer) - SquareEvaluation(3 - nPlayer);
-    // Evaluate the number of moves available.
-    int nMobilityEval = MobilityEvaluation(nPlayer) - MobilityEvaluation(3 - nPlayer);
+        const int knResult = cBitboard.Count(m_knPlayer1) - cBitboard.Count(m_knPlayer2);
+        for (size_t iii = knFirstSample; iii < vstSamples.size(); ++iii)
+            vstSamples[iii].nResult = knResult;
+    }
 
-    return (nCountEval * 10) + (nSquareEval * 15) + (nMobilityEval * 5);
+    ReversiPatterns cPatterns;
+    cPatterns.Tune(vstSamples, 6, 3, m_cLogger);
 
+    return cPatterns.Write(sFileName);
 }
 
 /**
@@ -800,18 +427,7 @@ int Reversi::EvaluateGameState(int nPlayer)
 
 int Reversi::CountEvaluation(int nPlayer) const
 {
-    int nEval = 0;
-
-    for (int xxx = 0; xxx < m_knX; ++xxx)
-    {
-        for (int yyy = 0; yyy < m_knY; ++yyy)
-        {
-            if (cBoard.PositionOccupiedByPlayer(xxx, yyy, nPlayer))
-                ++nEval;
-        }
-    }
-
-    return nEval;
+    return m_cBitboard.Count(nPlayer);
 }
 
 /**
@@ -827,13 +443,9 @@ int Reversi::SquareEvaluation(int nPlayer) const
 {
     int nEval = 0;
 
-    for (int xxx = 0; xxx < m_knX; ++xxx)
+    for (uint64_t uiDiscs = m_cBitboard.Discs(nPlayer); uiDiscs != 0; uiDiscs &= uiDiscs - 1)
     {
-        for (int yyy = 0; yyy < m_knY; ++yyy)
-        {
-            if (cBoard.PositionOccupiedByPlayer(xxx, yyy, nPlayer))
-                nEval += m_kaiEvalTable[yyy][xxx];
-        }
+        nEval += m_kaiEvalTable[ReversiBitboard::Y(uiDiscs)][ReversiBitboard::X(uiDiscs)];
     }
 
     return nEval;
@@ -847,13 +459,9 @@ int Reversi::SquareEvaluation(int nPlayer) const
   * \return An integer representing the number of valid moves for the player.
   */
 
-int Reversi::MobilityEvaluation(int nPlayer)
+int Reversi::MobilityEvaluation(int nPlayer) const
 {
-
-    // Generate all possible valid moves for this player
-    std::vector<GameMove> vGameMoves = GenerateMoves(nPlayer);
-
-    return vGameMoves.size();
+    return __builtin_popcountll(m_cBitboard.Moves(nPlayer));
 }
 
 /**
@@ -872,7 +480,7 @@ std::string Reversi::GameScore() const
 /**
   * Check to see if a player has won the game.
   *
-  * For a each player, count the number of tokens.
+  * Call GameEndedWithMoveSquares() and discard the moves.
   *
   * \param nPlayer The player
   *
@@ -881,6 +489,53 @@ std::string Reversi::GameScore() const
 
 bool Reversi::GameEnded(int nPlayer)
 {
+    uint64_t uiMoves;
+
+    return GameEndedWithMoveSquares(nPlayer, uiMoves);
+}
+
+/**
+  * Check to see if a player has won the game, keeping the valid moves.
+  *
+  * Call GameEndedWithMoveSquares() and add a move to each of the squares
+  * nPlayer can move to.
+  *
+  * \param nPlayer   The player
+  * \param cMoveList The list to fill with valid moves
+  *
+  * \return True, if any player has won the game.  False otherwise.
+  */
+
+bool Reversi::GameEndedWithMoves(int nPlayer, MoveList &cMoveList)
+{
+    cMoveList.Clear();
+
+    uint64_t uiMoves;
+    if (GameEndedWithMoveSquares(nPlayer, uiMoves))
+        return true;
+
+    AddBoardMoves(uiMoves, cMoveList);
+
+    return false;
+}
+
+/**
+  * Check to see if a player has won the game, keeping the squares moved to.
+  *
+  * For a each player, count the number of tokens.  The game has ended when
+  * neither player can move.  The moves of nPlayer are found first and left
+  * in uiMoves; the opponent's are only found if nPlayer has none.
+  *
+  * \param nPlayer The player
+  * \param uiMoves The squares nPlayer can move to
+  *
+  * \return True, if any player has won the game.  False otherwise.
+  */
+
+bool Reversi::GameEndedWithMoveSquares(int nPlayer, uint64_t &uiMoves)
+{
+    uiMoves = 0;
+
     if (BoardGame::GameEnded(nPlayer))
         return true;
 
@@ -888,8 +543,8 @@ bool Reversi::GameEnded(int nPlayer)
     int nCountPlayer1 = CountEvaluation(m_knPlayer1);
     int nCountPlayer2 = CountEvaluation(m_knPlayer2);
 
-    // Create a string for the winning player
-    m_sWinBy = "a difference of " + std::to_string(abs(nCountPlayer1 - nCountPlayer2));
+    // Record the difference for the winning player
+    SetOutcome(GameOutcome::OUTCOME_DIFFERENCE, abs(nCountPlayer1 - nCountPlayer2));
 
     if (nCountPlayer1 > nCountPlayer2)
     {
@@ -905,15 +560,11 @@ bool Reversi::GameEnded(int nPlayer)
     }
 
     // If nor more moves are available for either player, the game is over; return true
-    std::vector<GameMove> vGameMovesPlayer1 = GenerateMoves(m_knPlayer1);
-    if (vGameMovesPlayer1.empty())
+    uiMoves = m_cBitboard.Moves(nPlayer);
+    if ((uiMoves == 0) && (m_cBitboard.Moves(3 - nPlayer) == 0))
     {
-        std::vector<GameMove> vGameMovesPlayer2 = GenerateMoves(m_knPlayer2);
-        if (vGameMovesPlayer2.empty())
-        {
-            m_bGameOver = true;
-            return true;
-        }
+        m_bGameOver = true;
+        return true;
     }
 
     // Return false - the game has not ended
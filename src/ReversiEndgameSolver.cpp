@@ -0,0 +1,455 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ReversiEndgameSolver.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+const uint64_t ReversiEndgameSolver::m_kauiQuadrants[4]
+{
+    UINT64_C(0x000000000F0F0F0F), UINT64_C(0x00000000F0F0F0F0),
+    UINT64_C(0x0F0F0F0F00000000), UINT64_C(0xF0F0F0F000000000)
+};
+
+/**
+  * Construct a solver.
+  *
+  * Make a worker, with its own transposition table, for each thread.
+  *
+  * \param nThreads The number of threads to search with, or zero for one
+  *                 per processor
+  */
+
+ReversiEndgameSolver::ReversiEndgameSolver(int nThreads)
+{
+    if (nThreads <= 0)
+        nThreads = std::thread::hardware_concurrency();
+    if (nThreads <= 0)
+        nThreads = 1;
+
+    m_vstWorkers.resize(nThreads);
+    for (Worker &stWorker : m_vstWorkers)
+        stWorker.vstTable.resize(m_knTableEntries);
+}
+
+/**
+  * Return the number of positions searched by every thread.
+  *
+  * \return The number of positions searched.
+  */
+
+uint64_t ReversiEndgameSolver::Nodes() const
+{
+    uint64_t uiNodes {0};
+
+    for (const Worker &stWorker : m_vstWorkers)
+        uiNodes += stWorker.uiNodes;
+
+    return uiNodes;
+}
+
+/**
+  * Solve a position.
+  *
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  *
+  * \return The score of the position for the player to move.
+  */
+
+int ReversiEndgameSolver::Solve(uint64_t uiOwn, uint64_t uiOpponent)
+{
+    return Negamax(m_vstWorkers[0], uiOwn, uiOpponent, m_knMinScore, m_knMaxScore);
+}
+
+/**
+  * Find the best move in a position.
+  *
+  * Solve the first move in order, then split the other moves among the
+  * threads.  A move is only solved once shown to do better than the best
+  * so far, so of moves with the same score, the first solved is kept.
+  *
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param nScore     The score of the best move, for the player to move
+  *
+  * \return The square of the best move, or -1 if the player has no move.
+  */
+
+int ReversiEndgameSolver::BestMove(uint64_t uiOwn, uint64_t uiOpponent, int &nScore)
+{
+    uint64_t uiMoves = ReversiBitboard::Moves(uiOwn, uiOpponent);
+    if (uiMoves == 0)
+    {
+        nScore = Solve(uiOwn, uiOpponent);
+        return -1;
+    }
+
+    Worker &stWorker = m_vstWorkers[0];
+
+    int anMoves[ReversiBitboard::m_knDimension * ReversiBitboard::m_knDimension];
+    const Entry &stEntry = Slot(stWorker, uiOwn, uiOpponent);
+    int nFirstMove = ((stEntry.uiOwn == uiOwn) && (stEntry.uiOpponent == uiOpponent)) ? stEntry.nMove : -1;
+    int nMoves = OrderMoves(uiOwn, uiOpponent, uiMoves, nFirstMove, anMoves);
+
+    // Solve the first move
+    uint64_t uiMove  = UINT64_C(1) << anMoves[0];
+    uint64_t uiFlips = ReversiBitboard::Flips(uiMove, uiOwn, uiOpponent);
+
+    Root stRoot;
+    stRoot.nBestScore = -Negamax(stWorker, uiOpponent ^ uiFlips, uiOwn ^ uiFlips ^ uiMove, m_knMinScore, m_knMaxScore);
+    stRoot.nBestMove  = anMoves[0];
+    stRoot.vnMoves.assign(anMoves + 1, anMoves + nMoves);
+
+    // Split the rest among the threads, this one included
+    size_t nThreads = std::min(m_vstWorkers.size(), stRoot.vnMoves.size());
+    std::vector<std::thread> vThreads;
+    for (size_t iii = 1; iii < nThreads; ++iii)
+        vThreads.emplace_back(SearchRootMoves, std::ref(m_vstWorkers[iii]), uiOwn, uiOpponent, std::ref(stRoot));
+
+    SearchRootMoves(stWorker, uiOwn, uiOpponent, stRoot);
+
+    for (std::thread &cThread : vThreads)
+        cThread.join();
+
+    nScore = stRoot.nBestScore;
+    return stRoot.nBestMove;
+}
+
+/**
+  * Search the moves at the top of the tree.
+  *
+  * Take the next move left until none are, and solve it if a null-window
+  * search shows it beats the best move so far.
+  *
+  * \param stWorker   The worker of this thread
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param stRoot     The moves, and the best so far, shared by the threads
+  */
+
+void ReversiEndgameSolver::SearchRootMoves(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent, Root &stRoot)
+{
+    for (size_t nNext = stRoot.nNext++; nNext < stRoot.vnMoves.size(); nNext = stRoot.nNext++)
+    {
+        uint64_t uiMove  = UINT64_C(1) << stRoot.vnMoves[nNext];
+        uint64_t uiFlips = ReversiBitboard::Flips(uiMove, uiOwn, uiOpponent);
+        uint64_t uiNextOwn      = uiOpponent ^ uiFlips;
+        uint64_t uiNextOpponent = uiOwn ^ uiFlips ^ uiMove;
+
+        int nBestScore;
+        {
+            std::lock_guard<std::mutex> cLock(stRoot.mtxBest);
+            nBestScore = stRoot.nBestScore;
+        }
+
+        // Does the move beat the best so far?
+        int nScore = -Negamax(stWorker, uiNextOwn, uiNextOpponent, -nBestScore - 1, -nBestScore);
+        if (nScore <= nBestScore)
+            continue;
+
+        nScore = -Negamax(stWorker, uiNextOwn, uiNextOpponent, m_knMinScore, -nBestScore);
+
+        std::lock_guard<std::mutex> cLock(stRoot.mtxBest);
+        if (nScore > stRoot.nBestScore)
+        {
+            stRoot.nBestScore = nScore;
+            stRoot.nBestMove  = stRoot.vnMoves[nNext];
+        }
+    }
+}
+
+/**
+  * Search a position within a window of scores.
+  *
+  * Positions with few empty squares are left to NegamaxShallow().  Bounds
+  * stored for the position narrow the window before searching, and the
+  * move found best is tried first.  A score at or below nAlpha is an upper
+  * bound on the true score, and one at or above nBeta a lower bound.
+  *
+  * \param stWorker   The worker of this thread
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param nAlpha     The score the player to move is assured of
+  * \param nBeta      The score the opponent is assured of holding them to
+  *
+  * \return The score of the position, or a bound on it outside the window.
+  */
+
+int ReversiEndgameSolver::Negamax(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent, int nAlpha, int nBeta)
+{
+    uint64_t uiEmpty = ~(uiOwn | uiOpponent);
+    if (__builtin_popcountll(uiEmpty) <= m_knShallowEmpties)
+        return NegamaxShallow(stWorker, uiOwn, uiOpponent, nAlpha, nBeta);
+
+    ++stWorker.uiNodes;
+
+    uint64_t uiMoves = ReversiBitboard::Moves(uiOwn, uiOpponent);
+    if (uiMoves == 0)
+    {
+        // The game is over, or the player passes
+        if (ReversiBitboard::Moves(uiOpponent, uiOwn) == 0)
+            return FinalScore(uiOwn, uiOpponent);
+
+        return -Negamax(stWorker, uiOpponent, uiOwn, -nBeta, -nAlpha);
+    }
+
+    // Bounds stored from an earlier search
+    int nFirstMove {-1};
+    Entry &stEntry = Slot(stWorker, uiOwn, uiOpponent);
+    if ((stEntry.uiOwn == uiOwn) && (stEntry.uiOpponent == uiOpponent))
+    {
+        if (stEntry.nLower >= nBeta)
+            return stEntry.nLower;
+        if (stEntry.nUpper <= nAlpha)
+            return stEntry.nUpper;
+        if (stEntry.nLower > nAlpha)
+            nAlpha = stEntry.nLower;
+        if (stEntry.nUpper < nBeta)
+            nBeta = stEntry.nUpper;
+        nFirstMove = stEntry.nMove;
+    }
+
+    int anMoves[ReversiBitboard::m_knDimension * ReversiBitboard::m_knDimension];
+    int nMoves = OrderMoves(uiOwn, uiOpponent, uiMoves, nFirstMove, anMoves);
+
+    int nBestScore = m_knMinScore - 1;
+    int nBestMove  = -1;
+    int nScore;
+
+    for (int iii = 0; iii < nMoves; ++iii)
+    {
+        uint64_t uiMove  = UINT64_C(1) << anMoves[iii];
+        uint64_t uiFlips = ReversiBitboard::Flips(uiMove, uiOwn, uiOpponent);
+
+        // Search the first move with the full window, and the rest with a
+        // null window first
+        if (iii == 0)
+        {
+            nScore = -Negamax(stWorker, uiOpponent ^ uiFlips, uiOwn ^ uiFlips ^ uiMove, -nBeta, -std::max(nAlpha, nBestScore));
+        }
+        else
+        {
+            int nBound = std::max(nAlpha, nBestScore);
+            nScore = -Negamax(stWorker, uiOpponent ^ uiFlips, uiOwn ^ uiFlips ^ uiMove, -nBound - 1, -nBound);
+            if ((nScore > nBound) && (nScore < nBeta))
+                nScore = -Negamax(stWorker, uiOpponent ^ uiFlips, uiOwn ^ uiFlips ^ uiMove, -nBeta, -nBound);
+        }
+
+        if (nScore > nBestScore)
+        {
+            nBestScore = nScore;
+            nBestMove  = anMoves[iii];
+            if (nBestScore >= nBeta)
+                break;
+        }
+    }
+
+    // The slot may have been taken by a position searched since
+    Entry &stStore = Slot(stWorker, uiOwn, uiOpponent);
+    if ((stStore.uiOwn != uiOwn) || (stStore.uiOpponent != uiOpponent))
+    {
+        stStore = Entry();
+        stStore.uiOwn      = uiOwn;
+        stStore.uiOpponent = uiOpponent;
+    }
+
+    if (nBestScore > nAlpha)
+        stStore.nLower = nBestScore;
+    if (nBestScore < nBeta)
+        stStore.nUpper = nBestScore;
+    stStore.nMove = nBestMove;
+
+    return nBestScore;
+}
+
+/**
+  * Search a position with few empty squares.
+  *
+  * Moves into quadrants with an odd number of empty squares are tried
+  * first, then the rest, without ordering by replies or storing bounds.
+  *
+  * \param stWorker   The worker of this thread
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param nAlpha     The score the player to move is assured of
+  * \param nBeta      The score the opponent is assured of holding them to
+  *
+  * \return The score of the position, or a bound on it outside the window.
+  */
+
+int ReversiEndgameSolver::NegamaxShallow(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent, int nAlpha, int nBeta)
+{
+    ++stWorker.uiNodes;
+
+    uint64_t uiEmpty = ~(uiOwn | uiOpponent);
+    if ((uiEmpty & (uiEmpty - 1)) == 0)
+        return (uiEmpty == 0) ? FinalScore(uiOwn, uiOpponent) : LastMove(uiOwn, uiOpponent, uiEmpty);
+
+    uint64_t uiMoves = ReversiBitboard::Moves(uiOwn, uiOpponent);
+    if (uiMoves == 0)
+    {
+        // The game is over, or the player passes
+        if (ReversiBitboard::Moves(uiOpponent, uiOwn) == 0)
+            return FinalScore(uiOwn, uiOpponent);
+
+        return -NegamaxShallow(stWorker, uiOpponent, uiOwn, -nBeta, -nAlpha);
+    }
+
+    uint64_t uiOdd = OddQuadrants(uiEmpty);
+    int nBestScore = m_knMinScore - 1;
+
+    for (uint64_t uiPass : {uiMoves & uiOdd, uiMoves & ~uiOdd})
+    {
+        for (; uiPass != 0; uiPass &= uiPass - 1)
+        {
+            uint64_t uiMove  = uiPass & (UINT64_C(0) - uiPass);
+            uint64_t uiFlips = ReversiBitboard::Flips(uiMove, uiOwn, uiOpponent);
+
+            int nScore = -NegamaxShallow(stWorker, uiOpponent ^ uiFlips, uiOwn ^ uiFlips ^ uiMove, -nBeta, -std::max(nAlpha, nBestScore));
+            if (nScore > nBestScore)
+            {
+                nBestScore = nScore;
+                if (nBestScore >= nBeta)
+                    return nBestScore;
+            }
+        }
+    }
+
+    return nBestScore;
+}
+
+/**
+  * Score a position with one empty square.
+  *
+  * The player to move takes the square if they can, otherwise their
+  * opponent does if they can.
+  *
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param uiEmpty    The empty square
+  *
+  * \return The score of the position for the player to move.
+  */
+
+int ReversiEndgameSolver::LastMove(uint64_t uiOwn, uint64_t uiOpponent, uint64_t uiEmpty)
+{
+    uint64_t uiFlips = ReversiBitboard::Flips(uiEmpty, uiOwn, uiOpponent);
+    if (uiFlips != 0)
+        return FinalScore(uiOwn ^ uiFlips ^ uiEmpty, uiOpponent ^ uiFlips);
+
+    uiFlips = ReversiBitboard::Flips(uiEmpty, uiOpponent, uiOwn);
+    if (uiFlips != 0)
+        return FinalScore(uiOwn ^ uiFlips, uiOpponent ^ uiFlips ^ uiEmpty);
+
+    return FinalScore(uiOwn, uiOpponent);
+}
+
+/**
+  * Order the moves of a position.
+  *
+  * Put a given move first, if it is one of the moves, then the rest by the
+  * number of replies they leave the opponent, fewest first, and among
+  * equals, moves into quadrants with an odd number of empty squares first.
+  *
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  * \param uiMoves    The moves of the player to move
+  * \param nFirstMove The square of the move to try first, or -1
+  * \param anMoves    The squares of the moves, in order
+  *
+  * \return The number of moves.
+  */
+
+int ReversiEndgameSolver::OrderMoves(uint64_t uiOwn, uint64_t uiOpponent, uint64_t uiMoves, int nFirstMove, int anMoves[])
+{
+    int anScores[ReversiBitboard::m_knDimension * ReversiBitboard::m_knDimension];
+    int nMoves {0};
+    int nFirst {0};
+
+    if ((nFirstMove >= 0) && (uiMoves & (UINT64_C(1) << nFirstMove)))
+    {
+        anMoves[nMoves++] = nFirstMove;
+        uiMoves ^= UINT64_C(1) << nFirstMove;
+        nFirst = 1;
+    }
+
+    uint64_t uiOdd = OddQuadrants(~(uiOwn | uiOpponent));
+
+    for (; uiMoves != 0; uiMoves &= uiMoves - 1)
+    {
+        uint64_t uiMove  = uiMoves & (UINT64_C(0) - uiMoves);
+        uint64_t uiFlips = ReversiBitboard::Flips(uiMove, uiOwn, uiOpponent);
+
+        int nScore = 2 * __builtin_popcountll(ReversiBitboard::Moves(uiOpponent ^ uiFlips, uiOwn ^ uiFlips ^ uiMove)) +
+                     ((uiMove & uiOdd) ? 0 : 1);
+
+        int nIndex = nMoves++;
+        for (; (nIndex > nFirst) && (anScores[nIndex - 1] > nScore); --nIndex)
+        {
+            anMoves[nIndex]  = anMoves[nIndex - 1];
+            anScores[nIndex] = anScores[nIndex - 1];
+        }
+        anMoves[nIndex]  = __builtin_ctzll(uiMove);
+        anScores[nIndex] = nScore;
+    }
+
+    return nMoves;
+}
+
+/**
+  * Return the quadrants holding an odd number of empty squares.
+  *
+  * \param uiEmpty The empty squares
+  *
+  * \return The squares of those quadrants.
+  */
+
+uint64_t ReversiEndgameSolver::OddQuadrants(uint64_t uiEmpty)
+{
+    uint64_t uiOdd {0};
+
+    for (uint64_t uiQuadrant : m_kauiQuadrants)
+    {
+        if (__builtin_popcountll(uiEmpty & uiQuadrant) & 1)
+            uiOdd |= uiQuadrant;
+    }
+
+    return uiOdd;
+}
+
+/**
+  * Return the slot of a position in a transposition table.
+  *
+  * \param stWorker   The worker whose table to use
+  * \param uiOwn      The discs of the player to move
+  * \param uiOpponent The discs of the opponent
+  *
+  * \return The slot, which may hold another position.
+  */
+
+ReversiEndgameSolver::Entry & ReversiEndgameSolver::Slot(Worker &stWorker, uint64_t uiOwn, uint64_t uiOpponent)
+{
+    uint64_t uiHash = (uiOwn * UINT64_C(0x9E3779B97F4A7C15)) ^ (uiOpponent * UINT64_C(0xC2B2AE3D27D4EB4F));
+    uiHash ^= uiHash >> 32;
+
+    return stWorker.vstTable[uiHash & (m_knTableEntries - 1)];
+}
@@ -0,0 +1,299 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ReversiPatterns.h"
+
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+const int ReversiPatterns::m_kanPatternSquares[m_knPatterns] {10, 9, 10, 8, 7, 6, 5, 4};
+
+const int ReversiPatterns::m_kanTableOffsets[m_knPatterns + 1] {0, 59049, 78732, 137781, 144342, 146529, 147258, 147501, 147582};
+
+const char ReversiPatterns::m_kacMagic[8] {'G', 'A', 'I', 'R', 'V', 'P', 'W', '1'};
+
+const ReversiPatterns::Layout ReversiPatterns::m_kstLayout;
+
+/**
+  * Lay the patterns on the board.
+  *
+  * Each pattern is given by its squares in one corner of the board, and is
+  * turned a quarter at a time, and for the 2x5 corner also reflected, to
+  * find its other positions.  The squares of a position keep the order of
+  * the pattern's, so that every position reads the same table.
+  */
+
+ReversiPatterns::Layout::Layout()
+{
+    typedef std::vector<std::pair<int, int>> Squares;
+
+    // The squares of each pattern, and the number of its positions
+    Squares avSquares[m_knPatterns];
+    int     anPositions[m_knPatterns] {4, 4, 8, 2, 4, 4, 4, 4};
+
+    // An edge and its X squares
+    for (int xxx = 0; xxx < 8; ++xxx)
+        avSquares[0].emplace_back(xxx, 0);
+    avSquares[0].emplace_back(1, 1);
+    avSquares[0].emplace_back(6, 1);
+
+    // A 3x3 corner, and a 2x5 corner
+    for (int yyy = 0; yyy < 3; ++yyy)
+        for (int xxx = 0; xxx < 3; ++xxx)
+            avSquares[1].emplace_back(xxx, yyy);
+
+    for (int yyy = 0; yyy < 2; ++yyy)
+        for (int xxx = 0; xxx < 5; ++xxx)
+            avSquares[2].emplace_back(xxx, yyy);
+
+    // Diagonals of eight down to four squares
+    for (int nPattern = 3; nPattern < m_knPatterns; ++nPattern)
+        for (int iii = 0; iii < m_kanPatternSquares[nPattern]; ++iii)
+            avSquares[nPattern].emplace_back(iii, iii + nPattern - 3);
+
+    int nPosition {0};
+
+    for (int nPattern = 0; nPattern < m_knPatterns; ++nPattern)
+    {
+        assert(static_cast<int>(avSquares[nPattern].size()) == m_kanPatternSquares[nPattern]);
+
+        for (int nSymmetry = 0; nSymmetry < anPositions[nPattern]; ++nSymmetry)
+        {
+            anPattern[nPosition] = nPattern;
+
+            int nPower {1};
+            for (std::pair<int, int> prSquare : avSquares[nPattern])
+            {
+                int nX = prSquare.first;
+                int nY = prSquare.second;
+
+                // Reflect, for the second four positions of the 2x5 corner
+                if (nSymmetry >= 4)
+                    std::swap(nX, nY);
+
+                // Turn a quarter, as many times as the position calls for
+                for (int nTurn = 0; nTurn < nSymmetry % 4; ++nTurn)
+                {
+                    int nTurnedX = 7 - nY;
+                    nY = nX;
+                    nX = nTurnedX;
+                }
+
+                SquarePositions &stSquare = astSquares[nX * 8 + nY];
+                assert(stSquare.nCount < 8);
+                stSquare.anPosition[stSquare.nCount] = nPosition;
+                stSquare.anPower[stSquare.nCount]    = nPower;
+                ++stSquare.nCount;
+
+                nPower *= 3;
+            }
+
+            ++nPosition;
+        }
+    }
+
+    assert(nPosition == m_knPositions);
+}
+
+/**
+  * Read the weights from a file.
+  *
+  * \param sFileName Name of the weight file
+  *
+  * \return True if the weights are read.  False otherwise.
+  */
+
+bool ReversiPatterns::Read(const std::string &sFileName)
+{
+    std::ifstream ifsFile(sFileName, std::ios::in | std::ios::binary);
+    if (!ifsFile.is_open())
+        return false;
+
+    char     acMagic[8];
+    uint32_t uiPhases;
+    uint32_t uiPatterns;
+
+    if (!ifsFile.read(acMagic, sizeof(acMagic)) ||
+        !ifsFile.read(reinterpret_cast<char *>(&uiPhases), sizeof(uiPhases)) ||
+        !ifsFile.read(reinterpret_cast<char *>(&uiPatterns), sizeof(uiPatterns)))
+        return false;
+
+    if ((std::memcmp(acMagic, m_kacMagic, sizeof(m_kacMagic)) != 0) || (uiPatterns != m_knPatterns) ||
+        (uiPhases < 1) || (uiPhases > 64))
+        return false;
+
+    std::vector<std::vector<int16_t>> vvnWeights(uiPhases, std::vector<int16_t>(m_kanTableOffsets[m_knPatterns]));
+    for (std::vector<int16_t> &vnWeights : vvnWeights)
+    {
+        if (!ifsFile.read(reinterpret_cast<char *>(vnWeights.data()), vnWeights.size() * sizeof(int16_t)))
+            return false;
+    }
+
+    // Nothing should follow the weights
+    if (ifsFile.peek() != std::ifstream::traits_type::eof())
+        return false;
+
+    m_vvnWeights.swap(vvnWeights);
+
+    return true;
+}
+
+/**
+  * Write the weights to a file.
+  *
+  * \param sFileName Name of the weight file
+  *
+  * \return True if the weights are written.  False otherwise.
+  */
+
+bool ReversiPatterns::Write(const std::string &sFileName) const
+{
+    std::ofstream ofsFile(sFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofsFile.is_open())
+        return false;
+
+    uint32_t uiPhases   = m_vvnWeights.size();
+    uint32_t uiPatterns = m_knPatterns;
+
+    ofsFile.write(m_kacMagic, sizeof(m_kacMagic));
+    ofsFile.write(reinterpret_cast<const char *>(&uiPhases), sizeof(uiPhases));
+    ofsFile.write(reinterpret_cast<const char *>(&uiPatterns), sizeof(uiPatterns));
+
+    for (const std::vector<int16_t> &vnWeights : m_vvnWeights)
+        ofsFile.write(reinterpret_cast<const char *>(vnWeights.data()), vnWeights.size() * sizeof(int16_t));
+
+    return ofsFile.good();
+}
+
+/**
+  * Tune the weights.
+  *
+  * Starting from weights of zero, for each sample, move the weights of its
+  * positions toward the disc difference its game ended with, in step with
+  * the error of their evaluation.  Go through the samples a number of
+  * times, then round the weights into those used to evaluate.
+  *
+  * \param vstSamples The positions and results of games
+  * \param nPhases    The number of phases to tune weights for
+  * \param nEpochs    The number of times to go through the samples
+  * \param cLogger    Logger for progress
+  */
+
+void ReversiPatterns::Tune(const std::vector<Sample> &vstSamples, int nPhases, int nEpochs, const Logger &cLogger)
+{
+    assert((nPhases >= 1) && (nPhases <= 64) && "ReversiPatterns::Tune() number of phases out of range");
+
+    std::vector<std::vector<double>> vvdWeights(nPhases, std::vector<double>(m_kanTableOffsets[m_knPatterns]));
+
+    for (int nEpoch = 1; nEpoch <= nEpochs; ++nEpoch)
+    {
+        double dSquaredError {0.0};
+
+        for (const Sample &stSample : vstSamples)
+        {
+            std::vector<double> &vdWeights = vvdWeights[Phase(stSample.nDiscs, nPhases)];
+
+            // The weight of every position of the sample
+            int    anWeight[m_knPositions];
+            double dEval {0.0};
+            for (int nPosition = 0; nPosition < m_knPositions; ++nPosition)
+            {
+                anWeight[nPosition] = m_kanTableOffsets[m_kstLayout.anPattern[nPosition]] + stSample.stIndices.auiIndex[nPosition];
+                dEval += vdWeights[anWeight[nPosition]];
+            }
+
+            double dError = (stSample.nResult * m_knDiscWeight) - dEval;
+            dSquaredError += dError * dError;
+
+            for (int nPosition = 0; nPosition < m_knPositions; ++nPosition)
+                vdWeights[anWeight[nPosition]] += m_kdLearningRate * dError;
+        }
+
+        double dDiscError = vstSamples.empty() ? 0.0 : std::sqrt(dSquaredError / vstSamples.size()) / m_knDiscWeight;
+        std::string sMessage = "Tuning epoch " + std::to_string(nEpoch) + " samples " + std::to_string(vstSamples.size()) +
+                               " root mean squared error " + std::to_string(dDiscError) + " discs";
+        cLogger.LogInfo(sMessage, 1);
+    }
+
+    std::vector<std::vector<int16_t>> vvnWeights(nPhases, std::vector<int16_t>(m_kanTableOffsets[m_knPatterns]));
+    for (int nPhase = 0; nPhase < nPhases; ++nPhase)
+    {
+        for (size_t iii = 0; iii < vvdWeights[nPhase].size(); ++iii)
+        {
+            double dWeight = std::round(vvdWeights[nPhase][iii]);
+            if (dWeight > SHRT_MAX)
+                dWeight = SHRT_MAX;
+            else if (dWeight < SHRT_MIN)
+                dWeight = SHRT_MIN;
+
+            vvnWeights[nPhase][iii] = static_cast<int16_t>(dWeight);
+        }
+    }
+
+    m_vvnWeights.swap(vvnWeights);
+}
+
+/**
+  * Evaluate the positions of the patterns.
+  *
+  * \param stIndices The index of every position
+  * \param nDiscs    The number of discs on the board, which sets the phase
+  *
+  * \return The sum of the weights of the positions, for player 1.
+  */
+
+int ReversiPatterns::Evaluate(const Indices &stIndices, int nDiscs) const
+{
+    assert(!m_vvnWeights.empty() && "ReversiPatterns::Evaluate() no weights read");
+
+    const int16_t *kpnWeights = m_vvnWeights[Phase(nDiscs, m_vvnWeights.size())].data();
+
+    int nEval {0};
+    for (int nPosition = 0; nPosition < m_knPositions; ++nPosition)
+        nEval += kpnWeights[m_kanTableOffsets[m_kstLayout.anPattern[nPosition]] + stIndices.auiIndex[nPosition]];
+
+    return nEval;
+}
+
+/**
+  * Return the phase of the game.
+  *
+  * The phases divide the moves of a game, from four discs on the board to
+  * sixty-four, evenly.
+  *
+  * \param nDiscs  The number of discs on the board
+  * \param nPhases The number of phases
+  *
+  * \return The phase, from zero to one less than the number of phases.
+  */
+
+int ReversiPatterns::Phase(int nDiscs, int nPhases)
+{
+    int nPhase = (nDiscs - 4) * nPhases / 61;
+    if (nPhase < 0)
+        nPhase = 0;
+    else if (nPhase >= nPhases)
+        nPhase = nPhases - 1;
+
+    return nPhase;
+}
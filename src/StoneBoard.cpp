@@ -0,0 +1,192 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "StoneBoard.h"
+
+#include <iomanip>
+#include <iostream>
+#include <type_traits>
+
+// A board is copied with every game clone, so keep it a single block of memory
+static_assert(std::is_trivially_copyable<StoneBoard>::value, "StoneBoard must be trivially copyable");
+
+#if !defined(_WIN32)
+const char * const StoneBoard::m_kszPlayer1TokenColor {"\033[1;37m"};
+const char * const StoneBoard::m_kszPlayer2TokenColor {"\033[1;31m"};
+const char * const StoneBoard::m_kszResetTokenColor   {"\033[0m"};
+#endif
+
+/**
+  * Set a stone on the board.
+  *
+  * If a valid location, place the stone of the piece's player, or remove
+  * the stone on the location for a piece of no player.
+  *
+  * \param nX X-Coordinate
+  * \param nY Y-Coordinate
+  * \param cGamePiece The game piece
+  *
+  * \return True if the location is valid, false otherwise.
+  */
+
+bool StoneBoard::SetPiece(int nX, int nY, const GamePiece &cGamePiece)
+{
+    if (!ValidLocation(nX, nY))
+        return false;
+
+    const int knSquare = StoneBitboard::Square(nX, nY);
+    const int knPlayer = cGamePiece.Player();
+
+    m_acStones[0].Reset(knSquare);
+    m_acStones[1].Reset(knSquare);
+
+    if ((knPlayer == 1) || (knPlayer == 2))
+    {
+        m_acStones[knPlayer - 1].Set(knSquare);
+        m_acStoneTokens[knPlayer - 1] = cGamePiece.Token();
+    }
+
+    return true;
+}
+
+/**
+  * Return the player number of the stone located on the board at the
+  * coordinates.
+  *
+  * \param nX X-Coordinate
+  * \param nY Y-Coordinate
+  *
+  * \return The player number of the stone, or 0 if there is none.
+  */
+
+int StoneBoard::PositionOccupiedBy(int nX, int nY) const
+{
+    const int knSquare = StoneBitboard::Square(nX, nY);
+
+    if (m_acStones[0].Test(knSquare))
+        return 1;
+    if (m_acStones[1].Test(knSquare))
+        return 2;
+    return 0;
+}
+
+/**
+  * Display the game board.
+  *
+  * Run through every space on the board and display it's stone.  Also
+  * display coordinates and grid lines, depending on settings.  Rows past
+  * the ninth are labelled with two digits.
+  */
+
+void StoneBoard::Display() const
+{
+    std::string sColor;
+
+#if defined(_WIN32)
+    HANDLE hConsole;
+    hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+#endif
+
+    // Width of the Y-coordinates, two digits for a board of more than nine rows
+    const int knYWidth = (m_knY > 9) ? 2 : 1;
+
+    // Display X-coordinatres
+    if (m_kbDisplayXCoordinates)
+    {
+        char c = m_kcXCoordinate;
+
+        std::cout << std::string(knYWidth + 2, ' ');
+        for (int xxx = 0; xxx < m_knX; ++xxx)
+        {
+
+            std::cout << c << "   ";
+            ++c;
+        }
+        std::cout << std::endl << std::endl;
+    }
+
+    for (int yyy = 0; yyy < m_knY; ++yyy)
+    {
+        // Display Y-coordinates
+        if (m_kbDisplayYCoordinates)
+        {
+            std::cout << std::setw(knYWidth) << yyy + 1 << "  ";
+        }
+        else
+        {
+            std::cout << std::string(knYWidth + 2, ' ');
+        }
+
+        for (int xxx = 0; xxx < m_knX; ++xxx)
+        {
+            // Display grid lines
+            if (m_kbDisplayGrid && xxx > 0)
+            {
+                std::cout << " | ";
+            }
+
+            // Determine the color and token of the stone
+            const int knPlayer = PositionOccupiedBy(xxx, yyy);
+            const char kcToken = (knPlayer == 0) ? GamePiece().Token() : m_acStoneTokens[knPlayer - 1];
+
+            if (knPlayer == 1)
+            {
+#if defined(_WIN32)
+                SetConsoleTextAttribute(hConsole, m_knPlayer1TokenColor);
+#else
+                sColor = m_kszPlayer1TokenColor;
+#endif // defined
+
+            }
+            else if (knPlayer == 2)
+            {
+#if defined(_WIN32)
+                SetConsoleTextAttribute(hConsole, m_knPlayer2TokenColor);
+#else
+                sColor = m_kszPlayer2TokenColor;
+#endif // defined
+            }
+            else // Clear color
+            {
+                sColor = "";
+            }
+
+#if defined(_WIN32)
+            std::cout << kcToken;
+            SetConsoleTextAttribute(hConsole, m_knResetTokenColor);
+#else
+            std::cout << sColor << kcToken << m_kszResetTokenColor;
+#endif // defined
+
+            if (!m_kbDisplayGrid)
+            {
+                std::cout << "   ";
+            }
+        }
+
+        if (m_kbDisplayGrid && yyy < m_knY - 1)
+        {
+            std::string sHyphen(knYWidth + 1, ' ');
+            sHyphen.insert(sHyphen.length() - 1, 4 * m_knX, '-');
+            std::cout << std::endl << sHyphen << std::endl;
+        }
+        else
+            std::cout << std::endl << std::endl;
+    }
+}
@@ -20,31 +20,28 @@
 #include "TTT.h"
 
 /**
-  * Return a vector of valid game moves.
+  * Fill a list with the valid game moves.
   *
-  * Review and collect all valid moves for a player into a vector.  For
+  * Review and collect all valid moves for a player into a list.  For
   * Tic-Tac-Toe, the nPlayer is ignored because valid moves are the same
   * between both players.
   *
-  * \param nPlayer The player whose turn it is.
-  *
-  * \return A vector of valid moves.
+  * \param nPlayer   The player whose turn it is.
+  * \param cMoveList The list to fill with valid moves
   */
 
-std::vector<GameMove> TTT::GenerateMoves(int nPlayer)
+void TTT::GenerateBoardMoves(int nPlayer, MoveList &cMoveList)
 {
     (void)nPlayer;
 
-    std::vector<GameMove> vGameMoves {};
+    cMoveList.Clear();
 
     for (int xxx = 0; xxx < m_knX; ++xxx)
     {
         for (int yyy = 0; yyy < m_knY; ++yyy)
         {
-            if (!cBoard.PositionOccupied(xxx, yyy))
-                vGameMoves.emplace_back(0, 0, xxx, yyy, true, false);
+            if (m_anSquarePlayers[LinearLines<3, 3, 3>::Square(xxx, yyy)] == 0)
+                cMoveList.Add(BoardMove(0, 0, xxx, yyy, true, false));
         }
     }
-
-    return vGameMoves;
 }
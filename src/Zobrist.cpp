@@ -0,0 +1,26 @@
+/*
+    Copyright 2015 Dom Maddalone
+
+    This file is part of GameAI.
+
+    GameAI is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GameAI is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GameAI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Zobrist.h"
+
+// The generator must match the reference SplitMix64, whose first output from seed 0 is known
+static_assert(Zobrist::SplitMix64(0, 0) == 0xE220A8397B1DCDAFULL, "SplitMix64 does not match the reference generator");
+
+// The table is a constant expression, so it is built by the compiler rather than at start up
+const std::array<uint64_t, Zobrist::m_knNumberOfKeys> Zobrist::m_kauiKeys = Zobrist::MakeKeys(MakeIndexList<Zobrist::m_knNumberOfKeys>::Type());